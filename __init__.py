@@ -31,14 +31,7 @@ def get_all_sensor_classes() -> list[type[Sensor]]:
     Returns:
         List of Sensor subclass types (not instances)
     """
-    from .sensors import Sensor
-    import inspect
-    from . import sensors as sensors_module
+    from .sensors import SENSOR_DRIVERS, load_sensor_class
 
-    sensor_classes = []
-    for name, obj in inspect.getmembers(sensors_module, inspect.isclass):
-        # Include classes that inherit from Sensor but aren't Sensor itself
-        if issubclass(obj, Sensor) and obj is not Sensor:
-            sensor_classes.append(obj)
-
-    return sensor_classes
+    # Drivers are lazily imported, so load each registered one
+    return [load_sensor_class(name) for name in SENSOR_DRIVERS]
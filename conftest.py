@@ -2,6 +2,8 @@ import sys
 from pathlib import Path
 from unittest.mock import MagicMock
 
+import pytest
+
 # Add project root to Python path for imports
 sys.path.insert(0, str(Path(__file__).parent))
 
@@ -14,3 +16,25 @@ sys.modules["luma.core.interface.serial"] = MagicMock()
 sys.modules["luma.core.render"] = MagicMock()
 sys.modules["luma.oled"] = MagicMock()
 sys.modules["luma.oled.device"] = MagicMock()
+
+
+@pytest.fixture(autouse=True)
+def _fresh_i2c_buses(monkeypatch):
+    """Each test gets an empty shared I2C bus registry (and its own fake SMBus)."""
+    monkeypatch.setattr("utils.i2c_bus._buses", {})
+
+
+class FakeClock:
+    """Time source for clock= parameters; tests move it by setting t."""
+
+    def __init__(self, t: float = 0.0):
+        self.t = t
+
+    def __call__(self) -> float:
+        return self.t
+
+
+@pytest.fixture
+def clock():
+    """A FakeClock starting at t=0."""
+    return FakeClock()
@@ -10,8 +10,17 @@ from .base import Display
 class SSD1306Display(Display):
     """SSD1306 OLED display implementation using luma.oled."""
 
-    def __init__(self, i2c_port: int = 1, i2c_address: int = 0x3C):
-        serial = i2c(port=i2c_port, address=i2c_address)
+    def __init__(self, i2c_port: int = 1, i2c_address: int = 0x3C, bus=None):
+        """
+        Args:
+            i2c_port: I2C bus number (when luma opens its own handle)
+            i2c_address: Display address
+            bus: Shared bus (utils.i2c_bus) to draw through instead
+        """
+        if bus is not None:
+            serial = i2c(bus=bus, address=i2c_address)
+        else:
+            serial = i2c(port=i2c_port, address=i2c_address)
         self._device = ssd1306(serial)
 
     @property
@@ -2,15 +2,23 @@
 Gateway package - indoor gateway that collects sensor data via LoRa.
 
 This package contains:
+- alerts: Streaming threshold/rate/staleness alert rules and notification
 - command_queue: Command queue with ACK-based reliability
+- log_transfers: Reassembly and selective resend of fetchlog transfers
 - sensor_collection: Sensor data collection and dashboard posting
+- rollups: Windowed per-series aggregation before posting
+- series_registry: Interned per-series metadata
+- series_store: Memory-mapped ring store of recent readings
 - transceiver: LoRa transceiver thread
+- uplink_acks: Batched sensor ACKs and dedup for confirmed uplinks
 - http_handler: HTTP server for command endpoints and gateway params
 - server: Main gateway orchestration and entry point
 """
 
+from gateway.alerts import AlertManager
 from gateway.command_queue import CommandQueue, DiscoveryRequest, PendingCommand
 from gateway.http_handler import CommandServer
+from gateway.log_transfers import LogTransferManager
 from gateway.params import GatewayParamRegistry
 from gateway.sensor_collection import (
     DashboardClient,
@@ -20,20 +28,28 @@ from gateway.sensor_collection import (
     get_sensor_class,
     instantiate_sensors,
 )
+from gateway.series_registry import SeriesRegistry
+from gateway.series_store import SeriesStore
 from gateway.server import load_config, main, run_gateway
 from gateway.transceiver import LoRaTransceiver
+from gateway.uplink_acks import UplinkAckTracker
 
 __all__ = [
+    "AlertManager",
     "CommandQueue",
     "CommandServer",
     "DashboardClient",
     "DiscoveryRequest",
     "GatewayParamRegistry",
     "LocalSensorReader",
+    "LogTransferManager",
     "LoRaTransceiver",
     "PendingCommand",
     "PendingPost",
     "SensorDataCollector",
+    "SeriesRegistry",
+    "SeriesStore",
+    "UplinkAckTracker",
     "get_sensor_class",
     "instantiate_sensors",
     "load_config",
@@ -0,0 +1,507 @@
+"""
+Streaming alert rules on the gateway ingest path.
+
+Rules are compiled once at startup into small state machines and indexed by
+sensor ID (make_sensor_id() format). Checking a reading is a single dict
+lookup plus a few comparisons per rule on that series, so hundreds of rules
+add negligible latency to SensorDataCollector.add_readings().
+
+Transitions are handed to a dispatcher thread, which applies the per-series
+cooldown and calls the notifiers (log, email). Ingest never waits on SMTP.
+The dispatcher also sweeps staleness rules, since "no data" can't be
+detected from the ingest path.
+
+Rule types:
+    threshold: low/high limits with hysteresis (sensors.thresholds)
+    rate:      |dv/dt| above max_per_sec, with hysteresis on recovery
+    stale:     no reading for max_age_sec (or 1.5 heartbeats for deadband series)
+
+Classes:
+    ThresholdRule, RateRule, StaleRule: Compiled per-series rules
+    RuleEngine: Index of compiled rules by sensor ID
+    AlertDispatcher: Background notification thread with cooldown
+    AlertManager: Engine + dispatcher, the collector's entry point
+
+Functions:
+    build_alert_manager: Build everything from the gateway "alerts" config
+"""
+
+from __future__ import annotations
+
+import logging
+import queue
+import threading
+import time
+from datetime import datetime
+
+from gateway.series_registry import HEARTBEAT_GRACE
+from sensors.thresholds import (
+    AlertState,
+    ThresholdAlert,
+    ThresholdConfig,
+    crossed_limit,
+    next_state,
+)
+from utils.notifications import LogNotifier, Notifier, build_email_notifier
+
+logger = logging.getLogger(__name__)
+
+
+# =============================================================================
+# Compiled Rules
+# =============================================================================
+
+
+class ThresholdRule:
+    """Low/high threshold with hysteresis for one series."""
+
+    __slots__ = ("sensor_id", "config", "state", "name")
+
+    def __init__(self, sensor_id: str, config: ThresholdConfig):
+        self.sensor_id = sensor_id
+        self.config = config
+        self.state = AlertState.NORMAL
+        self.name = f"threshold low={config.low} high={config.high}"
+
+    def check(self, value: float, units: str, timestamp: float) -> ThresholdAlert | None:
+        old = self.state
+        new = next_state(old, value, self.config)
+        if new is old:
+            return None
+        self.state = new
+        return ThresholdAlert(
+            sensor_id=self.sensor_id,
+            new_state=new,
+            old_state=old,
+            value=value,
+            threshold_value=crossed_limit(new, old, self.config),
+            units=units,
+            timestamp=timestamp,
+            rule=self.name,
+        )
+
+
+class RateRule:
+    """Rate-of-change limit (units per second) between consecutive readings."""
+
+    __slots__ = (
+        "sensor_id", "max_per_sec", "hysteresis", "state", "name", "_last_ts", "_last_value",
+    )
+
+    def __init__(self, sensor_id: str, max_per_sec: float, hysteresis: float = 0.0):
+        if max_per_sec <= 0:
+            raise ValueError(f"{sensor_id}: rate max_per_sec must be positive")
+        self.sensor_id = sensor_id
+        self.max_per_sec = max_per_sec
+        self.hysteresis = hysteresis
+        self.state = AlertState.NORMAL
+        self.name = f"rate max={max_per_sec}"
+        self._last_ts: float | None = None
+        self._last_value = 0.0
+
+    def check(self, value: float, units: str, timestamp: float) -> ThresholdAlert | None:
+        last_ts = self._last_ts
+        dt = timestamp - last_ts if last_ts is not None else 0.0
+        rate = abs(value - self._last_value) / dt if dt > 0 else None
+        if last_ts is None or timestamp > last_ts:
+            self._last_ts = timestamp
+            self._last_value = value
+        if rate is None:
+            return None
+
+        old = self.state
+        if rate >= self.max_per_sec:
+            new = AlertState.RATE_HIGH
+        elif old is AlertState.RATE_HIGH and rate > self.max_per_sec - self.hysteresis:
+            new = old
+        else:
+            new = AlertState.NORMAL
+        if new is old:
+            return None
+
+        self.state = new
+        return ThresholdAlert(
+            sensor_id=self.sensor_id,
+            new_state=new,
+            old_state=old,
+            value=rate,
+            threshold_value=self.max_per_sec,
+            units=f"{units}/s",
+            timestamp=timestamp,
+            rule=self.name,
+        )
+
+
+class StaleRule:
+    """
+    Fires when a series has not reported for max_age_sec.
+
+    Checked on ingest and swept by the dispatcher; RuleEngine serializes both.
+    """
+
+    __slots__ = (
+        "sensor_id", "max_age_sec", "heartbeat_sec", "state", "name", "last_seen", "units",
+    )
+
+    def __init__(self, sensor_id: str, max_age_sec: float, now: float | None = None):
+        if max_age_sec <= 0:
+            raise ValueError(f"{sensor_id}: stale max_age_sec must be positive")
+        self.sensor_id = sensor_id
+        self.max_age_sec = max_age_sec
+        # Deadband series are quiet until their heartbeat, so allow for it
+        self.heartbeat_sec: float | None = None
+        self.state = AlertState.NORMAL
+        self.name = f"stale max_age={max_age_sec}"
+        # Series that never report at all go stale max_age_sec after startup
+        self.last_seen = time.time() if now is None else now
+        self.units = ""
+
+    def check(self, value: float, units: str, timestamp: float) -> ThresholdAlert | None:
+        # Use arrival time so node clock skew can't mask or fake staleness
+        self.last_seen = time.time()
+        self.units = units
+        if self.state is AlertState.STALE:
+            self.state = AlertState.NORMAL
+            return self._alert(AlertState.NORMAL, AlertState.STALE, value, timestamp)
+        return None
+
+    def sweep(self, now: float) -> ThresholdAlert | None:
+        """Called periodically by the dispatcher."""
+        max_age = self.max_age_sec
+        if self.heartbeat_sec is not None:
+            max_age = max(max_age, self.heartbeat_sec * HEARTBEAT_GRACE)
+        if self.state is AlertState.NORMAL and now - self.last_seen >= max_age:
+            self.state = AlertState.STALE
+            return self._alert(AlertState.STALE, AlertState.NORMAL, None, now)
+        return None
+
+    def _alert(self, new, old, value, timestamp) -> ThresholdAlert:
+        return ThresholdAlert(
+            sensor_id=self.sensor_id,
+            new_state=new,
+            old_state=old,
+            value=value,
+            threshold_value=self.max_age_sec,
+            units=self.units,
+            timestamp=timestamp,
+            rule=self.name,
+        )
+
+
+def compile_rule(sensor_id: str, spec: dict):
+    """Compile one rule spec dict into a rule object."""
+    kind = spec.get("type", "threshold")
+    if kind == "threshold":
+        return ThresholdRule(
+            sensor_id,
+            ThresholdConfig(
+                low=spec.get("low"),
+                high=spec.get("high"),
+                hysteresis=spec.get("hysteresis", 0.0),
+            ),
+        )
+    if kind == "rate":
+        return RateRule(sensor_id, spec["max_per_sec"], spec.get("hysteresis", 0.0))
+    if kind == "stale":
+        return StaleRule(sensor_id, spec["max_age_sec"])
+    raise ValueError(f"{sensor_id}: unknown rule type '{kind}'")
+
+
+# =============================================================================
+# Rule Engine
+# =============================================================================
+
+
+class RuleEngine:
+    """
+    Compiled rules indexed by sensor ID.
+
+    check() runs on the ingest threads. Each series' threshold and rate
+    rules are only touched by the thread that ingests that series (LoRa vs
+    local readings never share a node ID), so they take no lock. Staleness
+    rules are also swept by the dispatcher thread; they are kept apart and
+    guarded by the engine's stale lock.
+    """
+
+    def __init__(self, rules: dict[str, list] | None = None):
+        # Threshold and rate rules; staleness rules are in _stale_by_id
+        self._index: dict[str, tuple] = {}
+        self._stale: list[StaleRule] = []
+        self._stale_by_id: dict[str, list[StaleRule]] = {}
+        self._stale_lock = threading.Lock()
+        for sensor_id, compiled in (rules or {}).items():
+            self.add_rules(sensor_id, compiled)
+
+    def add_rules(self, sensor_id: str, compiled: list) -> None:
+        """Register compiled rules for a series (setup time only)."""
+        stale = [r for r in compiled if isinstance(r, StaleRule)]
+        others = tuple(r for r in compiled if not isinstance(r, StaleRule))
+        self._index[sensor_id] = self._index.get(sensor_id, ()) + others
+        if stale:
+            self._stale.extend(stale)
+            self._stale_by_id.setdefault(sensor_id, []).extend(stale)
+
+    @property
+    def rule_count(self) -> int:
+        return sum(len(r) for r in self._index.values()) + len(self._stale)
+
+    def check(
+        self,
+        sensor_id: str,
+        value: float | None,
+        units: str,
+        timestamp: float,
+        heartbeat_sec: float | None = None,
+    ) -> list[ThresholdAlert] | None:
+        """
+        Check one reading. Returns alerts, or None if nothing fired.
+
+        heartbeat_sec (deadband series) stretches staleness rules to the
+        series' heartbeat, since silence there means "unchanged".
+        """
+        rules = self._index.get(sensor_id)
+        if rules is None or value is None:
+            return None
+        alerts = None
+        for rule in rules:
+            alert = rule.check(value, units, timestamp)
+            if alert is not None:
+                if alerts is None:
+                    alerts = []
+                alerts.append(alert)
+
+        stale = self._stale_by_id.get(sensor_id)
+        if stale is not None:
+            with self._stale_lock:
+                for rule in stale:
+                    rule.heartbeat_sec = heartbeat_sec
+                    alert = rule.check(value, units, timestamp)
+                    if alert is not None:
+                        if alerts is None:
+                            alerts = []
+                        alerts.append(alert)
+        return alerts
+
+    def sweep_stale(self, now: float | None = None) -> list[ThresholdAlert]:
+        """Check staleness rules against the wall clock."""
+        now = time.time() if now is None else now
+        alerts = []
+        with self._stale_lock:
+            for rule in self._stale:
+                alert = rule.sweep(now)
+                if alert is not None:
+                    alerts.append(alert)
+        return alerts
+
+
+# =============================================================================
+# Dispatcher
+# =============================================================================
+
+
+def format_alert(alert: ThresholdAlert) -> tuple[str, str]:
+    """Build a human-readable (subject, body) for an alert."""
+    when = datetime.fromtimestamp(alert.timestamp).strftime("%Y-%m-%d %H:%M:%S")
+    state = alert.new_state
+    if state is AlertState.NORMAL:
+        headline = f"RECOVERED ({alert.old_state.value})"
+    elif state is AlertState.ALERT_LOW:
+        headline = "LOW ALERT"
+    elif state is AlertState.ALERT_HIGH:
+        headline = "HIGH ALERT"
+    elif state is AlertState.RATE_HIGH:
+        headline = "RATE ALERT"
+    else:
+        headline = "STALE"
+
+    subject = f"[data_log] {headline}: {alert.sensor_id}"
+    lines = [f"Sensor: {alert.sensor_id}", f"Time: {when}"]
+    if alert.value is not None:
+        lines.append(f"Value: {alert.value:.3f} {alert.units}".rstrip())
+    if alert.threshold_value is not None:
+        label = "Max age (s)" if AlertState.STALE in (state, alert.old_state) else "Limit"
+        lines.append(f"{label}: {alert.threshold_value}")
+    return subject, "\n".join(lines)
+
+
+class AlertDispatcher(threading.Thread):
+    """
+    Delivers alerts to notifiers off the ingest path.
+
+    Alerts from the same rule and state within cooldown_sec are suppressed.
+    A notifier failure never affects other notifiers or ingest.
+    """
+
+    def __init__(
+        self,
+        notifiers: list[Notifier],
+        engine: RuleEngine | None = None,
+        cooldown_sec: float = 300.0,
+        stale_check_interval_sec: float = 5.0,
+        max_queue_size: int = 256,
+    ):
+        super().__init__(daemon=True, name="AlertDispatcher")
+        self._notifiers = notifiers
+        self._engine = engine
+        self._cooldown_sec = cooldown_sec
+        self._stale_interval = stale_check_interval_sec
+        self._queue: queue.Queue[ThresholdAlert | None] = queue.Queue(maxsize=max_queue_size)
+        self._last_sent: dict[tuple[str, str, AlertState], float] = {}
+        self._running = False
+        self.dropped = 0
+
+    def submit(self, alert: ThresholdAlert) -> None:
+        """Queue an alert (non-blocking; drops if the queue is full)."""
+        try:
+            self._queue.put_nowait(alert)
+        except queue.Full:
+            self.dropped += 1
+            logger.error(f"Alert queue full, dropped alert for '{alert.sensor_id}'")
+
+    def run(self) -> None:
+        self._running = True
+        next_sweep = time.monotonic() + self._stale_interval
+        while self._running:
+            timeout = max(0.0, next_sweep - time.monotonic())
+            try:
+                alert = self._queue.get(timeout=timeout)
+                if alert is None:
+                    break
+                self.deliver(alert)
+            except queue.Empty:
+                pass
+            except Exception as e:
+                logger.error(f"Alert dispatcher error: {e}")
+
+            if self._engine is not None and time.monotonic() >= next_sweep:
+                next_sweep = time.monotonic() + self._stale_interval
+                for alert in self._engine.sweep_stale():
+                    self.deliver(alert)
+
+    def stop(self) -> None:
+        self._running = False
+        try:
+            self._queue.put_nowait(None)
+        except queue.Full:
+            pass
+
+    def deliver(self, alert: ThresholdAlert, now: float | None = None) -> bool:
+        """Send one alert to all notifiers unless in cooldown. Returns True if sent."""
+        now = time.monotonic() if now is None else now
+        key = (alert.sensor_id, alert.rule, alert.new_state)
+        last = self._last_sent.get(key)
+        if last is not None and now - last < self._cooldown_sec:
+            logger.debug(f"Alert for '{alert.sensor_id}' suppressed (cooldown)")
+            return False
+        self._last_sent[key] = now
+
+        subject, body = format_alert(alert)
+        logger.info(f"Dispatching alert: {subject}")
+        for notifier in self._notifiers:
+            try:
+                notifier.send(subject, body)
+            except Exception as e:
+                logger.error(f"Notifier '{notifier.name}' failed: {e}")
+        return True
+
+
+# =============================================================================
+# Alert Manager
+# =============================================================================
+
+
+class AlertManager:
+    """Owns the rule engine and dispatcher; called from add_readings()."""
+
+    def __init__(self, engine: RuleEngine, dispatcher: AlertDispatcher):
+        self._engine = engine
+        self._dispatcher = dispatcher
+
+    @property
+    def engine(self) -> RuleEngine:
+        return self._engine
+
+    def start(self) -> None:
+        self._dispatcher.start()
+        logger.info(f"Alert manager started ({self._engine.rule_count} rules)")
+
+    def stop(self) -> None:
+        self._dispatcher.stop()
+
+    def check(
+        self,
+        sensor_id: str,
+        value: float | None,
+        units: str,
+        timestamp: float,
+        heartbeat_sec: float | None = None,
+    ) -> None:
+        """Check one reading and queue any resulting alerts (non-blocking)."""
+        alerts = self._engine.check(sensor_id, value, units, timestamp, heartbeat_sec)
+        if alerts:
+            for alert in alerts:
+                self._dispatcher.submit(alert)
+
+
+def build_alert_manager(config: dict) -> AlertManager | None:
+    """
+    Build an AlertManager from the gateway "alerts" config section.
+
+    Example:
+        "alerts": {
+            "enabled": true,
+            "cooldown_sec": 300,
+            "rules": {
+                "patio_ads1115adc_a0": [
+                    {"type": "threshold", "low": 1.5, "hysteresis": 0.3},
+                    {"type": "stale", "max_age_sec": 900}
+                ]
+            },
+            "email": {"enabled": true, "username": "...", "app_password": "...",
+                      "recipients": ["alerts@example.com"]}
+        }
+
+    "thresholds": {sensor_id: {"low": ..., "high": ..., "hysteresis": ...}} is
+    also accepted as shorthand for threshold rules.
+
+    Returns:
+        AlertManager (not started), or None if alerts are disabled/unconfigured
+    """
+    if not config.get("enabled", False):
+        return None
+
+    engine = RuleEngine()
+    specs: dict[str, list[dict]] = {}
+    for sensor_id, spec in config.get("thresholds", {}).items():
+        specs.setdefault(sensor_id, []).append(dict(spec, type="threshold"))
+    for sensor_id, rule_specs in config.get("rules", {}).items():
+        if isinstance(rule_specs, dict):
+            rule_specs = [rule_specs]
+        specs.setdefault(sensor_id, []).extend(rule_specs)
+
+    for sensor_id, rule_specs in specs.items():
+        compiled = []
+        for spec in rule_specs:
+            try:
+                compiled.append(compile_rule(sensor_id, spec))
+            except (KeyError, ValueError) as e:
+                logger.error(f"Invalid alert rule for '{sensor_id}': {e}")
+        if compiled:
+            engine.add_rules(sensor_id, compiled)
+
+    if engine.rule_count == 0:
+        logger.warning("Alerts enabled but no valid rules configured")
+        return None
+
+    notifiers: list[Notifier] = [LogNotifier()]
+    email = build_email_notifier(config.get("email", {}))
+    if email is not None:
+        notifiers.append(email)
+
+    dispatcher = AlertDispatcher(
+        notifiers,
+        engine=engine,
+        cooldown_sec=config.get("cooldown_sec", 300.0),
+        stale_check_interval_sec=config.get("stale_check_interval_sec", 5.0),
+    )
+    return AlertManager(engine, dispatcher)
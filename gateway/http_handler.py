@@ -8,6 +8,10 @@ Also provides gateway parameter endpoints:
   GET /gateway/params           - Get all gateway radio parameters
   GET /gateway/param/{name}     - Get single parameter value
   PUT /gateway/param/{name}?value=X - Set parameter and persist
+
+And on-gateway history queries (when the series store is enabled):
+  GET /series                   - List stored series (with reporting status)
+  GET /series/{id}?from=&to=&step= - Range query, optionally downsampled
 """
 
 from __future__ import annotations
@@ -143,8 +147,13 @@ class CommandHandler(BaseHTTPRequestHandler):
 
         Patterns:
           GET /discover[?retries=N]       - Discover all reachable nodes
+          GET /gateway/boots              - Latest boot timing report per node
           GET /gateway/params             - Get all gateway parameters
           GET /gateway/param/{name}       - Get single gateway parameter
+          GET /series                     - List stored series
+          GET /series/{id}?from=&to=&step= - Query stored history
+          GET /logs                       - List sample log transfers (fetchlog)
+          GET /logs/{node_id}/{id}        - Records of a completed transfer
           GET /{cmd}?expected_acks=N&a=X  - Broadcast command, wait for N ACKs
           GET /{cmd}/{node_id}?a=arg1     - Send command to node, wait for response
         """
@@ -161,6 +170,11 @@ class CommandHandler(BaseHTTPRequestHandler):
             self._handle_uptime()
             return
 
+        # Handle /gateway/boots - latest boot timing per node
+        if path == "gateway/boots":
+            self._handle_boots()
+            return
+
         # Handle /gateway/params - get all gateway parameters
         if path == "gateway/params":
             self._handle_gateway_params_get_all()
@@ -172,6 +186,24 @@ class CommandHandler(BaseHTTPRequestHandler):
             self._handle_gateway_param_get(param_name)
             return
 
+        # Handle /series and /series/{id} - on-gateway history
+        if path == "series":
+            self._handle_series_list()
+            return
+
+        if path.startswith("series/"):
+            self._handle_series_query(path[len("series/"):], parsed)
+            return
+
+        # Handle /logs and /logs/{node_id}/{transfer_id} - fetchlog results
+        if path == "logs":
+            self._handle_logs_list()
+            return
+
+        if path.startswith("logs/"):
+            self._handle_log_get(path[len("logs/"):])
+            return
+
         parts = path.split("/")
 
         # Handle broadcast wait: GET /{cmd}?expected_acks=N (single path segment)
@@ -447,6 +479,145 @@ class CommandHandler(BaseHTTPRequestHandler):
             "uptime_seconds": uptime_seconds,
         }).encode("utf-8"))
 
+    def _handle_boots(self) -> None:
+        """Handle GET /gateway/boots - latest boot-to-first-packet report per node."""
+        gateway_state = getattr(self.server, "gateway_state", None)
+        if gateway_state is None:
+            self.send_response(503)
+            self.send_header("Content-Type", "application/json")
+            self.end_headers()
+            self.wfile.write(json.dumps({
+                "error": "unavailable",
+                "message": "Gateway state not initialized",
+            }).encode("utf-8"))
+            return
+
+        boots = {
+            node_id: {"timestamp": info.timestamp, "timings": info.timings}
+            for node_id, info in gateway_state.get_node_boots().items()
+        }
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({"nodes": boots}).encode("utf-8"))
+
+    def _handle_series_list(self) -> None:
+        """Handle GET /series - list series held in the on-gateway store."""
+        store = getattr(self.server, "series_store", None)
+        if store is None:
+            self._send_series_unavailable()
+            return
+
+        series = store.list_series()
+        # "reporting" / "unchanged" (deadband, within heartbeat) / "missing"
+        registry = getattr(self.server, "series_registry", None)
+        if registry is not None:
+            statuses = registry.statuses()
+            for entry in series:
+                status = statuses.get(entry["id"])
+                if status is not None:
+                    entry["status"] = status
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({"series": series}).encode("utf-8"))
+
+    def _handle_series_query(self, sensor_id: str, parsed) -> None:
+        """Handle GET /series/{id}?from=&to=&step= - range/downsampled query."""
+        store = getattr(self.server, "series_store", None)
+        if store is None:
+            self._send_series_unavailable()
+            return
+
+        query = parse_qs(parsed.query)
+        try:
+            t_from = float(query["from"][0]) if "from" in query else None
+            t_to = float(query["to"][0]) if "to" in query else None
+            step = float(query["step"][0]) if "step" in query else None
+            result = store.query(sensor_id, t_from=t_from, t_to=t_to, step=step)
+        except ValueError as e:
+            self.send_error(400, f"Invalid query: {e}")
+            return
+
+        if result is None:
+            self.send_response(404)
+            self.send_header("Content-Type", "application/json")
+            self.end_headers()
+            self.wfile.write(json.dumps({
+                "error": "not_found",
+                "message": f"No stored series '{sensor_id}'",
+            }).encode("utf-8"))
+            return
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps(result).encode("utf-8"))
+
+    def _handle_logs_list(self) -> None:
+        """Handle GET /logs - list fetchlog transfers held by the gateway."""
+        manager = getattr(self.server, "log_transfers", None)
+        if manager is None:
+            self._send_logs_unavailable()
+            return
+
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({"transfers": manager.list_transfers()}).encode("utf-8"))
+
+    def _handle_log_get(self, rest: str) -> None:
+        """Handle GET /logs/{node_id}/{transfer_id} - one transfer with its records."""
+        manager = getattr(self.server, "log_transfers", None)
+        if manager is None:
+            self._send_logs_unavailable()
+            return
+
+        node_id, _, transfer_id = rest.partition("/")
+        try:
+            transfer = manager.get(node_id, int(transfer_id))
+        except ValueError:
+            self.send_error(400, "Expected: /logs/{node_id}/{transfer_id}")
+            return
+        if transfer is None:
+            self.send_response(404)
+            self.send_header("Content-Type", "application/json")
+            self.end_headers()
+            self.wfile.write(json.dumps({
+                "error": "not_found",
+                "message": f"No log transfer {transfer_id} from '{node_id}'",
+            }).encode("utf-8"))
+            return
+
+        result = transfer.summary()
+        if transfer.readings is not None:
+            result["readings"] = [r.to_dict() for r in transfer.readings]
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps(result).encode("utf-8"))
+
+    def _send_logs_unavailable(self) -> None:
+        """Send 503 when log transfers are not enabled."""
+        self.send_response(503)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({
+            "error": "unavailable",
+            "message": "Log transfers not enabled",
+        }).encode("utf-8"))
+
+    def _send_series_unavailable(self) -> None:
+        """Send 503 when the series store is not enabled."""
+        self.send_response(503)
+        self.send_header("Content-Type", "application/json")
+        self.end_headers()
+        self.wfile.write(json.dumps({
+            "error": "unavailable",
+            "message": "Series store not enabled",
+        }).encode("utf-8"))
+
     def _handle_gateway_params_get_all(self) -> None:
         """Handle GET /gateway/params - get all gateway parameters."""
         registry = getattr(self.server, "gateway_params", None)
@@ -683,6 +854,9 @@ class CommandServer(threading.Thread):
         self.command_queue = command_queue
         self.discovery_config = discovery_config or {}
         self.transceiver = None  # Set later via set_transceiver()
+        self.series_store = None  # Set later via set_series_store()
+        self.series_registry = None  # Set later via set_series_store()
+        self.log_transfers = None  # Set later via set_log_transfers()
         self._server: HTTPServer | None = None
 
         # Set later via set_gateway_state()
@@ -695,6 +869,20 @@ class CommandServer(threading.Thread):
         if self._server:
             self._server.transceiver = transceiver  # type: ignore
 
+    def set_series_store(self, series_store, series_registry=None) -> None:
+        """Set the series store (and registry, for series status) for history queries."""
+        self.series_store = series_store
+        self.series_registry = series_registry
+        if self._server:
+            self._server.series_store = series_store  # type: ignore
+            self._server.series_registry = series_registry  # type: ignore
+
+    def set_log_transfers(self, log_transfers) -> None:
+        """Set the log transfer manager for fetchlog results."""
+        self.log_transfers = log_transfers
+        if self._server:
+            self._server.log_transfers = log_transfers  # type: ignore
+
     def set_gateway_state(self, gateway_state) -> None:
         """
         Set up gateway state and parameter registry.
@@ -718,6 +906,9 @@ class CommandServer(threading.Thread):
         self._server.command_queue = self.command_queue  # type: ignore
         self._server.discovery_config = self.discovery_config  # type: ignore
         self._server.transceiver = self.transceiver  # type: ignore
+        self._server.series_store = self.series_store  # type: ignore
+        self._server.series_registry = self.series_registry  # type: ignore
+        self._server.log_transfers = self.log_transfers  # type: ignore
         self._server.gateway_state = getattr(self, "gateway_state", None)  # type: ignore
         self._server.gateway_params = self.gateway_params  # type: ignore
         self._server.config_path = getattr(self.gateway_state, "config_path", "") if self.gateway_state else ""  # type: ignore
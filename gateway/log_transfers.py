@@ -0,0 +1,230 @@
+"""
+Reassembly of bulk sample-log transfers from nodes.
+
+A fetchlog command makes the node stream part of its full-resolution sample
+log as numbered "log" chunks (see node.log_transfer). The manager collects
+chunks per (node, transfer ID); once a transfer has gone quiet for
+resend_after_sec with chunks missing, due_resends() yields a logresend
+command naming just the missing ranges. Completed transfers are decoded to
+readings, kept in memory for GET /logs and optionally written to
+output_dir as JSON.
+
+The fetchlog ACK carries the chunk count, so the transceiver registers the
+transfer with expect() and even a transfer whose every chunk was lost gets
+resend requests.
+
+Classes:
+    LogTransfer: State of one transfer
+    LogTransferManager: Collects chunks and schedules selective resends
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+import threading
+import time
+from collections import OrderedDict
+from dataclasses import dataclass, field
+from pathlib import Path
+
+from utils.protocol import (
+    LogChunk,
+    SensorReading,
+    decode_log_records,
+    format_ranges,
+    seqs_to_ranges,
+)
+
+logger = logging.getLogger(__name__)
+
+STATUS_RECEIVING = "receiving"
+STATUS_COMPLETE = "complete"
+STATUS_FAILED = "failed"
+
+# Ranges per logresend, keeps the command packet inside the LoRa payload limit
+MAX_RESEND_RANGES = 12
+
+# A finished transfer ID seen again after this long is a new transfer (IDs wrap at 256)
+REUSE_AFTER_SEC = 60.0
+
+
+@dataclass
+class LogTransfer:
+    """Chunks and outcome of one node's log transfer."""
+
+    node_id: str
+    transfer_id: int
+    total: int
+    started: float = field(default_factory=time.time)
+    last_activity: float = 0.0  # Monotonic time of the last chunk or resend request
+    chunks: dict[int, bytes] = field(default_factory=dict, repr=False)
+    resends: int = 0
+    status: str = STATUS_RECEIVING
+    error: str | None = None
+    readings: list[SensorReading] | None = field(default=None, repr=False)
+
+    def missing(self) -> list[list[int]]:
+        return seqs_to_ranges(i for i in range(self.total) if i not in self.chunks)
+
+    def summary(self) -> dict:
+        return {
+            "node_id": self.node_id,
+            "transfer_id": self.transfer_id,
+            "status": self.status,
+            "chunks": len(self.chunks),
+            "total": self.total,
+            "resends": self.resends,
+            "records": len(self.readings) if self.readings is not None else None,
+            "started": self.started,
+            "error": self.error,
+        }
+
+
+class LogTransferManager:
+    """
+    Collects log chunks and schedules selective retransmits.
+
+    add_chunk()/expect()/due_resends() run on the transceiver thread;
+    list_transfers()/get() are called by HTTP handlers.
+    """
+
+    def __init__(
+        self,
+        output_dir: str | Path | None = None,
+        resend_after_sec: float = 5.0,
+        max_resends: int = 5,
+        keep_transfers: int = 16,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            output_dir: Write completed transfers here as JSON (None = memory only)
+            resend_after_sec: Quiet time before missing chunks are requested
+            max_resends: Resend requests before a transfer is marked failed
+            keep_transfers: Transfers kept in memory (oldest dropped first)
+            clock: Monotonic time source (injectable for tests)
+        """
+        self._output_dir = Path(output_dir) if output_dir else None
+        self._resend_after = resend_after_sec
+        self._max_resends = max_resends
+        self._keep = keep_transfers
+        self._clock = clock
+        self._lock = threading.Lock()
+        self._transfers: OrderedDict[tuple[str, int], LogTransfer] = OrderedDict()
+
+    def _transfer(self, node_id: str, transfer_id: int, total: int) -> LogTransfer:
+        # Caller holds self._lock
+        key = (node_id, transfer_id)
+        now = self._clock()
+        transfer = self._transfers.get(key)
+        if transfer is not None and (
+            transfer.total != total
+            or (transfer.status != STATUS_RECEIVING
+                and now - transfer.last_activity > REUSE_AFTER_SEC)
+        ):
+            transfer = None  # Transfer ID reused by a new transfer
+        if transfer is None:
+            transfer = LogTransfer(node_id, transfer_id, total, last_activity=now)
+            self._transfers[key] = transfer
+            self._transfers.move_to_end(key)
+            while len(self._transfers) > self._keep:
+                self._transfers.popitem(last=False)
+        return transfer
+
+    def expect(self, node_id: str, transfer_id: int, total: int) -> None:
+        """Register a transfer announced by a fetchlog ACK."""
+        with self._lock:
+            self._transfer(node_id, transfer_id, total)
+        logger.info(f"Expecting log transfer {transfer_id} from '{node_id}': {total} chunks")
+
+    def add_chunk(self, chunk: LogChunk) -> LogTransfer | None:
+        """
+        Store a received chunk.
+
+        Returns:
+            The transfer if this chunk completed it, else None
+        """
+        with self._lock:
+            transfer = self._transfer(chunk.node_id, chunk.transfer_id, chunk.total)
+            if transfer.status != STATUS_RECEIVING:
+                return None  # Late duplicate of a finished transfer
+            transfer.last_activity = self._clock()
+            transfer.chunks[chunk.index] = chunk.data
+            if len(transfer.chunks) < transfer.total:
+                return None
+            self._complete(transfer)
+        if transfer.status == STATUS_COMPLETE:
+            self._save(transfer)
+        return transfer
+
+    def _complete(self, transfer: LogTransfer) -> None:
+        # Caller holds self._lock
+        blob = b"".join(transfer.chunks[i] for i in range(transfer.total))
+        try:
+            transfer.readings = decode_log_records(blob)
+            transfer.status = STATUS_COMPLETE
+            logger.info(
+                f"Log transfer {transfer.transfer_id} from '{transfer.node_id}' complete: "
+                f"{len(transfer.readings)} records, {len(blob)} bytes, "
+                f"{transfer.resends} resend request(s)"
+            )
+        except ValueError as e:
+            transfer.status = STATUS_FAILED
+            transfer.error = str(e)
+            logger.warning(f"Log transfer {transfer.transfer_id} undecodable: {e}")
+        transfer.chunks = {}
+
+    def _save(self, transfer: LogTransfer) -> None:
+        if self._output_dir is None:
+            return
+        path = self._output_dir / (
+            f"{transfer.node_id}_{int(transfer.started)}_{transfer.transfer_id}.json"
+        )
+        try:
+            self._output_dir.mkdir(parents=True, exist_ok=True)
+            with open(path, "w") as f:
+                json.dump(
+                    {**transfer.summary(), "readings": [r.to_dict() for r in transfer.readings]},
+                    f,
+                )
+            logger.info(f"Saved log transfer to {path}")
+        except OSError as e:
+            logger.error(f"Failed to save log transfer {path}: {e}")
+
+    def due_resends(self) -> list[tuple[str, int, str]]:
+        """
+        Resend requests for stalled transfers, as (node_id, transfer_id, ranges arg).
+
+        Each transfer is asked again at most every resend_after_sec, up to
+        max_resends times, then marked failed.
+        """
+        now = self._clock()
+        result = []
+        with self._lock:
+            for transfer in self._transfers.values():
+                if transfer.status != STATUS_RECEIVING:
+                    continue
+                if now - transfer.last_activity < self._resend_after:
+                    continue
+                if transfer.resends >= self._max_resends:
+                    transfer.status = STATUS_FAILED
+                    transfer.error = f"{len(transfer.missing())} range(s) still missing"
+                    transfer.chunks = {}
+                    logger.warning(
+                        f"Log transfer {transfer.transfer_id} from '{transfer.node_id}' failed"
+                    )
+                    continue
+                transfer.resends += 1
+                transfer.last_activity = now
+                ranges = transfer.missing()[:MAX_RESEND_RANGES]
+                result.append((transfer.node_id, transfer.transfer_id, format_ranges(ranges)))
+        return result
+
+    def list_transfers(self) -> list[dict]:
+        with self._lock:
+            return [t.summary() for t in self._transfers.values()]
+
+    def get(self, node_id: str, transfer_id: int) -> LogTransfer | None:
+        with self._lock:
+            return self._transfers.get((node_id, transfer_id))
@@ -0,0 +1,314 @@
+"""
+Streaming per-series rollups for the gateway collector.
+
+Computes tumbling-window aggregates (count, min, max, mean, last and
+optionally RMS) per series so the dashboard can be fed per-minute values
+instead of every raw reading. Each series is matched against configured
+rules by exact sensor ID or glob pattern (make_sensor_id() format).
+
+Aggregation is incremental: each reading updates one running accumulator
+in O(1). Windows stay open for `allowed_lateness_sec` past their end so
+late or out-of-order readings still land in the right window; anything
+arriving after its window has been emitted is counted and dropped.
+
+Classes:
+    RollupRule: Window/mode configuration for a set of series
+    WindowAggregate: Running accumulator for one window
+    ClosedWindow: A finished window ready to be posted
+    RollupEngine: Routes readings to per-series windows and emits results
+
+Functions:
+    build_rollup_engine: Build an engine from the gateway "rollups" config
+"""
+
+from __future__ import annotations
+
+import fnmatch
+import logging
+import math
+import threading
+import time
+from dataclasses import dataclass, field
+
+logger = logging.getLogger(__name__)
+
+# Post modes
+MODE_RAW = "raw"  # Post raw readings only (rollup disabled for this series)
+MODE_AGGREGATE = "aggregate"  # Post window aggregates only
+MODE_BOTH = "both"  # Post raw readings and aggregates
+VALID_MODES = (MODE_RAW, MODE_AGGREGATE, MODE_BOTH)
+
+
+@dataclass
+class RollupRule:
+    """Rollup configuration for series matching `match` (exact ID or glob)."""
+
+    match: str
+    window_sec: float
+    mode: str = MODE_AGGREGATE
+    rms: bool = False
+
+    def __post_init__(self):
+        if self.window_sec <= 0:
+            raise ValueError(f"Rollup '{self.match}': window_sec must be positive")
+        if self.mode not in VALID_MODES:
+            raise ValueError(
+                f"Rollup '{self.match}': mode must be one of {VALID_MODES}"
+            )
+
+    @property
+    def is_pattern(self) -> bool:
+        return any(c in self.match for c in "*?[")
+
+    @property
+    def posts_raw(self) -> bool:
+        return self.mode != MODE_AGGREGATE
+
+
+class WindowAggregate:
+    """Running accumulator for one tumbling window (O(1) per sample)."""
+
+    __slots__ = ("count", "min", "max", "sum", "sumsq", "last_ts", "last")
+
+    def __init__(self):
+        self.count = 0
+        self.min = math.inf
+        self.max = -math.inf
+        self.sum = 0.0
+        self.sumsq = 0.0
+        self.last_ts = -math.inf
+        self.last = 0.0
+
+    def add(self, timestamp: float, value: float) -> None:
+        self.count += 1
+        if value < self.min:
+            self.min = value
+        if value > self.max:
+            self.max = value
+        self.sum += value
+        self.sumsq += value * value
+        # "last" is by timestamp, not arrival order
+        if timestamp >= self.last_ts:
+            self.last_ts = timestamp
+            self.last = value
+
+
+@dataclass
+class ClosedWindow:
+    """A finished window for one series."""
+
+    sensor_id: str
+    window_start: float
+    window_sec: float
+    aggregate: WindowAggregate
+    rms: bool
+    base: dict  # Datapoint template fields (name, units, category, tags)
+
+    def values(self) -> dict[str, float]:
+        """Aggregate values keyed by stat name."""
+        agg = self.aggregate
+        result = {
+            "count": agg.count,
+            "min": agg.min,
+            "max": agg.max,
+            "mean": agg.sum / agg.count,
+            "last": agg.last,
+        }
+        if self.rms:
+            result["rms"] = math.sqrt(agg.sumsq / agg.count)
+        return result
+
+    def to_datapoints(self) -> list[dict]:
+        """Build dashboard datapoints, one per stat (e.g. "..._temperature_max")."""
+        name = self.base.get("name", self.sensor_id)
+        datapoints = []
+        for stat, value in self.values().items():
+            dp = dict(self.base)
+            dp["id"] = f"{self.sensor_id}_{stat}"
+            dp["name"] = f"{name} {stat}"
+            dp["value"] = value
+            dp["timestamp"] = self.window_start
+            if stat == "count":
+                dp["units"] = ""
+            dp["tags"] = list(self.base.get("tags", [])) + ["rollup"]
+            datapoints.append(dp)
+        return datapoints
+
+
+@dataclass
+class _SeriesRollup:
+    """Per-series window state."""
+
+    rule: RollupRule
+    base: dict
+    windows: dict[int, WindowAggregate] = field(default_factory=dict)
+    watermark: float = -math.inf  # Highest timestamp seen
+    closed_before: int = -(2**62)  # Window indexes below this are emitted
+    next_close_at: float = math.inf  # Watermark at which the oldest window closes
+
+
+class RollupEngine:
+    """
+    Routes readings to per-series tumbling windows.
+
+    Thread-safe: add() is called from the LoRa and local sensor threads,
+    flush() from the dashboard poster thread.
+    """
+
+    def __init__(self, rules: list[RollupRule], allowed_lateness_sec: float = 10.0):
+        """
+        Args:
+            rules: Rollup rules; exact IDs take priority, then patterns in order
+            allowed_lateness_sec: How long a window stays open past its end
+        """
+        self._exact = {r.match: r for r in rules if not r.is_pattern}
+        self._patterns = [r for r in rules if r.is_pattern]
+        self._lateness = allowed_lateness_sec
+        self._resolved: dict[str, RollupRule | None] = {}
+        self._series: dict[str, _SeriesRollup] = {}
+        self._lock = threading.Lock()
+        self.late_dropped = 0
+
+    def resolve(self, sensor_id: str) -> RollupRule | None:
+        """Get the rule for a series (cached after first lookup)."""
+        try:
+            return self._resolved[sensor_id]
+        except KeyError:
+            pass
+        rule = self._exact.get(sensor_id)
+        if rule is None:
+            rule = next(
+                (r for r in self._patterns if fnmatch.fnmatchcase(sensor_id, r.match)),
+                None,
+            )
+        if rule is not None and rule.mode == MODE_RAW:
+            rule = None
+        self._resolved[sensor_id] = rule
+        return rule
+
+    def add(
+        self, sensor_id: str, rule: RollupRule, timestamp: float, value: float, base: dict
+    ) -> list[ClosedWindow]:
+        """
+        Add one reading to its window.
+
+        Args:
+            sensor_id: Series ID
+            rule: Rule from resolve()
+            timestamp: Reading timestamp (seconds)
+            value: Reading value
+            base: Datapoint template used when emitting this series
+
+        Returns:
+            Windows closed by the advancing watermark (usually empty)
+        """
+        window = rule.window_sec
+        idx = math.floor(timestamp / window)
+
+        with self._lock:
+            series = self._series.get(sensor_id)
+            if series is None:
+                series = _SeriesRollup(rule=rule, base=base)
+                self._series[sensor_id] = series
+
+            if idx < series.closed_before:
+                self.late_dropped += 1
+                logger.debug(f"Rollup: late reading for '{sensor_id}' dropped")
+                return []
+
+            agg = series.windows.get(idx)
+            if agg is None:
+                agg = series.windows[idx] = WindowAggregate()
+                close_at = (idx + 1) * window + self._lateness
+                if close_at < series.next_close_at:
+                    series.next_close_at = close_at
+            agg.add(timestamp, value)
+
+            if timestamp > series.watermark:
+                series.watermark = timestamp
+            if series.watermark < series.next_close_at:
+                return []
+            return self._close(sensor_id, series, series.watermark)
+
+    def flush(self, now: float | None = None, force: bool = False) -> list[ClosedWindow]:
+        """
+        Close windows whose lateness allowance has passed on the wall clock.
+
+        Covers series that stopped reporting, so their last window still posts.
+
+        Args:
+            now: Current time (default: time.time())
+            force: Close every open window regardless of time (shutdown)
+        """
+        now = time.time() if now is None else now
+        closed: list[ClosedWindow] = []
+        with self._lock:
+            for sensor_id, series in self._series.items():
+                if force or now >= series.next_close_at:
+                    closed.extend(
+                        self._close(sensor_id, series, math.inf if force else now)
+                    )
+        return closed
+
+    def _close(
+        self, sensor_id: str, series: _SeriesRollup, watermark: float
+    ) -> list[ClosedWindow]:
+        """Emit windows that end (plus lateness) at or before watermark."""
+        window = series.rule.window_sec
+        # Window idx covers [idx*window, (idx+1)*window) and closes once
+        # the watermark passes its end plus the lateness allowance
+        limit = (watermark - self._lateness) / window
+        closed = []
+        for idx in sorted(series.windows):
+            if idx + 1 > limit:
+                break
+            agg = series.windows.pop(idx)
+            series.closed_before = idx + 1
+            closed.append(
+                ClosedWindow(
+                    sensor_id=sensor_id,
+                    window_start=idx * window,
+                    window_sec=window,
+                    aggregate=agg,
+                    rms=series.rule.rms,
+                    base=series.base,
+                )
+            )
+        series.next_close_at = (
+            (min(series.windows) + 1) * window + self._lateness
+            if series.windows else math.inf
+        )
+        return closed
+
+
+def build_rollup_engine(config: dict) -> RollupEngine | None:
+    """
+    Build a RollupEngine from the gateway "rollups" config section.
+
+    Example:
+        "rollups": {
+            "allowed_lateness_sec": 10,
+            "rules": [
+                {"match": "*_mma8452accelerometer_*", "window_sec": 60,
+                 "mode": "aggregate", "rms": true}
+            ]
+        }
+
+    Returns:
+        RollupEngine, or None if no rules are configured
+    """
+    rule_configs = config.get("rules", [])
+    if not config.get("enabled", True) or not rule_configs:
+        return None
+
+    rules = [
+        RollupRule(
+            match=r["match"],
+            window_sec=float(r.get("window_sec", 60)),
+            mode=r.get("mode", MODE_AGGREGATE),
+            rms=bool(r.get("rms", False)),
+        )
+        for r in rule_configs
+    ]
+    logger.info(f"Rollups enabled: {len(rules)} rule(s)")
+    return RollupEngine(rules, config.get("allowed_lateness_sec", 10.0))
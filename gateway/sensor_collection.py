@@ -8,11 +8,10 @@ Classes:
     LocalSensorReader: Background thread for reading local sensors
 
 Functions:
-    get_sensor_class: Get a Sensor class by name using reflection
+    get_sensor_class: Get a Sensor class by name (lazy driver import)
     instantiate_sensors: Create Sensor instances from configuration
 """
 
-import inspect
 import json
 import logging
 import queue
@@ -23,9 +22,13 @@ from urllib.error import HTTPError, URLError
 from urllib.request import Request, urlopen
 
 import sensors as sensors_module
+from gateway.alerts import AlertManager
+from gateway.rollups import RollupEngine
+from gateway.series_registry import UNRESOLVED, SeriesRegistry
+from gateway.series_store import SeriesStore
 from sensors import Sensor
 from utils.gateway_state import GatewayState
-from utils.protocol import SensorReading, make_sensor_id
+from utils.protocol import SensorReading
 
 logger = logging.getLogger(__name__)
 
@@ -123,6 +126,10 @@ class SensorDataCollector:
         gateway_id: str,
         dashboard_client: DashboardClient,
         max_queue_size: int = 100,
+        series_store: SeriesStore | None = None,
+        rollup_engine: RollupEngine | None = None,
+        alert_manager: AlertManager | None = None,
+        series_registry: SeriesRegistry | None = None,
     ):
         """
         Initialize the collector with async posting.
@@ -131,9 +138,17 @@ class SensorDataCollector:
             gateway_id: Gateway identifier
             dashboard_client: Client for posting to dashboard
             max_queue_size: Maximum pending posts before dropping oldest
+            series_store: Optional on-gateway history store fed with every reading
+            rollup_engine: Optional windowed aggregation applied before posting
+            alert_manager: Optional alert rules checked against every reading
+            series_registry: Interned per-series metadata (in-memory one if None)
         """
         self._gateway_id = gateway_id
         self._dashboard_client = dashboard_client
+        self._series_store = series_store
+        self._rollups = rollup_engine
+        self._alerts = alert_manager
+        self._registry = series_registry if series_registry is not None else SeriesRegistry()
         self._max_queue_size = max_queue_size
         self._post_queue: queue.Queue[PendingPost | None] = queue.Queue(
             maxsize=max_queue_size
@@ -153,33 +168,47 @@ class SensorDataCollector:
         logger.info("Dashboard poster thread started")
 
     def stop(self) -> None:
-        """Stop the background poster thread gracefully."""
+        """Stop the poster thread after it has posted everything queued."""
         if not self._running:
             return
         self._running = False
-        # Send sentinel to unblock the queue
+        # Post whatever is left in open rollup windows before exiting
+        if self._rollups is not None:
+            self._flush_rollups(force=True)
+        # The sentinel goes behind everything queued, so the poster drains first
         try:
-            self._post_queue.put_nowait(None)
+            self._post_queue.put(None, timeout=2.0)
         except queue.Full:
-            pass
+            logger.warning("Dashboard queue full at shutdown, poster may not drain")
         if self._poster_thread and self._poster_thread.is_alive():
             self._poster_thread.join(timeout=2.0)
         logger.info("Dashboard poster thread stopped")
 
     def _poster_loop(self) -> None:
-        """Background loop that posts readings to the dashboard."""
-        while self._running:
+        """Background loop that posts readings until the stop() sentinel."""
+        while True:
             try:
                 pending = self._post_queue.get(timeout=1.0)
                 if pending is None:
-                    # Sentinel received, exit
+                    # Sentinel received, everything before it is posted
                     break
                 self._do_post(pending)
             except queue.Empty:
-                continue
+                pass
             except Exception as e:
                 logger.error(f"Dashboard poster error: {e}")
 
+            # Close rollup windows for series that went quiet (cheap check)
+            if self._rollups is not None and self._running:
+                self._flush_rollups()
+
+    def _flush_rollups(self, force: bool = False) -> None:
+        """Queue aggregates for windows whose lateness allowance has passed."""
+        closed = self._rollups.flush(force=force)
+        if closed:
+            datapoints = [dp for w in closed for dp in w.to_datapoints()]
+            self._enqueue(PendingPost(datapoints=datapoints, node_id="rollups"))
+
     def _do_post(self, pending: PendingPost) -> None:
         """Actually post readings to dashboard (runs in poster thread)."""
         success = self._dashboard_client.post_readings(pending.datapoints)
@@ -189,43 +218,92 @@ class SensorDataCollector:
             logger.warning(f"Failed to post {len(pending.datapoints)} readings from '{pending.node_id}'")
 
     def add_readings(
-        self, node_id: str, readings: list[SensorReading], is_local: bool = False
+        self,
+        node_id: str,
+        readings: list[SensorReading],
+        is_local: bool = False,
+        historical: bool = False,
     ) -> None:
         """
         Queue sensor readings for async posting to dashboard.
 
         This method returns immediately - actual posting happens in background.
-        If the queue is full, the oldest pending post is dropped.
+        If the queue is full, the oldest pending post is dropped. Readings are
+        also appended to the series store (if configured) before queuing.
+
+        Series matched by a rollup rule feed their window aggregator; in
+        "aggregate" mode only the finished windows are posted, not the raw
+        readings. Alert rules (if configured) see every raw reading.
+
+        Per-series metadata (ID, display name, tags) and the store slot and
+        rollup rule are interned in the series registry on first sight, so a
+        known series costs one dict lookup plus one dict copy per reading.
+
+        Historical readings (backfilled by a confirmed-uplink node) go to the
+        store and dashboard as raw datapoints only: they don't raise alerts,
+        feed rollup windows, or count as the series reporting now.
 
         Args:
             node_id: ID of the node that produced the readings
             readings: List of SensorReading objects
             is_local: True if readings are from local sensors (vs LoRa)
+            historical: True if the readings are late backfill, not live
         """
         datapoints = []
+        get_series = self._registry.get
+        store = self._series_store
+        rollups = None if historical else self._rollups
+        alerts = None if historical else self._alerts
+
+        arrived = time.time()
 
         for reading in readings:
-            sensor_id = make_sensor_id(node_id, reading.sensor_class, reading.name)
-
-            # Build display name: "NodeId SensorClass ReadingName"
-            # e.g., "Patio BME280 Temperature"
-            display_name = f"{node_id} {reading.name}"
-
-            datapoints.append({
-                "id": sensor_id,
-                "name": display_name,
-                "units": reading.units,
-                "value": reading.value,
-                "timestamp": reading.timestamp,
-                "category": "Local Sensors" if is_local else "Remote Sensors",
-                "tags": [node_id, reading.sensor_class.lower(), "local" if is_local else "lora"],
-            })
+            series = get_series(
+                node_id, reading.sensor_class, reading.name, reading.units, is_local
+            )
+            value = reading.value
+            timestamp = reading.timestamp
+            if not historical:
+                series.last_seen = arrived
+                series.heartbeat_sec = reading.heartbeat_sec
+
+            if store is not None and value is not None:
+                slot = series.store_slot
+                if slot is None:
+                    slot = series.store_slot = store.slot_for(series.sensor_id)
+                store.append_slot(slot, timestamp, value)
+
+            if alerts is not None:
+                # Alerting must never hold up or break ingest
+                try:
+                    alerts.check(
+                        series.sensor_id, value, series.units, timestamp,
+                        heartbeat_sec=series.heartbeat_sec,
+                    )
+                except Exception as e:
+                    logger.error(f"Alert check failed for '{series.sensor_id}': {e}")
+
+            if rollups is not None:
+                rule = series.rollup_rule
+                if rule is UNRESOLVED:
+                    rule = series.rollup_rule = rollups.resolve(series.sensor_id)
+                if rule is not None and value is not None:
+                    for window in rollups.add(
+                        series.sensor_id, rule, timestamp, value, series.base
+                    ):
+                        datapoints.extend(window.to_datapoints())
+                    if not rule.posts_raw:
+                        continue
+
+            datapoints.append(series.datapoint(value, timestamp))
 
         if not datapoints:
             return
 
-        pending = PendingPost(datapoints=datapoints, node_id=node_id)
+        self._enqueue(PendingPost(datapoints=datapoints, node_id=node_id))
 
+    def _enqueue(self, pending: PendingPost) -> None:
+        """Queue a post for the poster thread, dropping the oldest if full."""
         # Try to enqueue; if full, drop oldest and retry
         try:
             self._post_queue.put_nowait(pending)
@@ -250,6 +328,10 @@ class SensorDataCollector:
     def gateway_id(self) -> str:
         return self._gateway_id
 
+    @property
+    def series_registry(self) -> SeriesRegistry:
+        return self._registry
+
 
 # =============================================================================
 # Local Sensor Reader Thread
@@ -335,11 +417,8 @@ class LocalSensorReader(threading.Thread):
 
 
 def get_sensor_class(class_name: str) -> type[Sensor] | None:
-    """Get a Sensor class by name using reflection."""
-    for name, obj in inspect.getmembers(sensors_module, inspect.isclass):
-        if name == class_name and issubclass(obj, Sensor) and obj is not Sensor:
-            return obj
-    return None
+    """Get a Sensor class by name (imports its driver on first use)."""
+    return sensors_module.load_sensor_class(class_name)
 
 
 def instantiate_sensors(sensor_configs: list[dict]) -> list[tuple[Sensor, str]]:
@@ -359,8 +438,11 @@ def instantiate_sensors(sensor_configs: list[dict]) -> list[tuple[Sensor, str]]:
         try:
             kwargs = config.get("config", {})
             sensor = sensor_class(**kwargs)
+            if calibration := config.get("calibration"):
+                sensor.set_calibration(calibration)
             sensor.init()
-            sensors.append((sensor, class_name))
+            # Simulated drivers report as the class they mirror
+            sensors.append((sensor, sensor.class_name))
             logger.info(f"Initialized local sensor: {class_name}")
         except Exception as e:
             logger.error(f"Failed to initialize {class_name}: {e}")
@@ -0,0 +1,158 @@
+"""
+Interned per-series metadata for the gateway collector.
+
+A series is one (node, sensor class, reading name) stream. Its sensor ID,
+display name, tags and category never change, so they are computed once
+and kept in a SeriesTemplate; each reading then only copies the prebuilt
+datapoint dict and sets value and timestamp.
+
+The series store, rollups and alerts key on the sensor ID, which is
+stable across restarts; the template caches the store slot and rollup rule
+resolved for it.
+
+Templates also track when each series last reported. Nodes running a
+deadband send readings only on change or heartbeat (heartbeat_sec on the
+reading), so a quiet deadband series is "unchanged" until its heartbeat is
+overdue, and only then "missing".
+
+Classes:
+    SeriesTemplate: Interned metadata and cached per-series lookups
+    SeriesRegistry: Thread-safe map from reading identity to template
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+
+from utils.protocol import make_sensor_id
+
+logger = logging.getLogger(__name__)
+
+# Marks cached lookups that have not been resolved yet
+UNRESOLVED = object()
+
+# A deadband series is missing once silent for this many heartbeats. Nodes
+# check the heartbeat when a sensor is read, so it can run one interval over.
+HEARTBEAT_GRACE = 1.5
+
+# Series status values (see SeriesTemplate.status)
+STATUS_REPORTING = "reporting"  # Sends every reading; no heartbeat to judge by
+STATUS_UNCHANGED = "unchanged"  # Deadband series, quiet within its heartbeat
+STATUS_MISSING = "missing"  # Deadband series, heartbeat overdue
+
+
+class SeriesTemplate:
+    """Interned metadata for one series."""
+
+    __slots__ = (
+        "sensor_id", "node_id", "sensor_class", "name", "units",
+        "is_local", "base", "store_slot", "rollup_rule", "heartbeat_sec", "last_seen",
+    )
+
+    def __init__(
+        self,
+        sensor_id: str,
+        node_id: str,
+        sensor_class: str,
+        name: str,
+        units: str,
+        is_local: bool,
+    ):
+        self.sensor_id = sensor_id
+        self.node_id = node_id
+        self.sensor_class = sensor_class
+        self.name = name
+        self.units = units
+        self.is_local = is_local
+        # Display name: "NodeId ReadingName", e.g. "Patio Temperature".
+        # tags is a tuple so datapoints can share it safely (JSON encodes it as a list).
+        self.base = {
+            "id": sensor_id,
+            "name": f"{node_id} {name}",
+            "units": units,
+            "category": "Local Sensors" if is_local else "Remote Sensors",
+            "tags": (node_id, sensor_class.lower(), "local" if is_local else "lora"),
+        }
+        # Per-series lookups cached by SensorDataCollector
+        self.store_slot: int | None = None
+        self.rollup_rule = UNRESOLVED
+        # Updated by SensorDataCollector on every reading
+        self.heartbeat_sec: float | None = None
+        self.last_seen = 0.0  # Gateway arrival time (time.time())
+
+    def datapoint(self, value: float | None, timestamp: float) -> dict:
+        """Build a dashboard datapoint for one reading."""
+        dp = self.base.copy()
+        dp["value"] = value
+        dp["timestamp"] = timestamp
+        return dp
+
+    def status(self, now: float) -> str:
+        """Reporting status: "reporting", "unchanged" or "missing"."""
+        if self.heartbeat_sec is None:
+            return STATUS_REPORTING
+        if now - self.last_seen <= self.heartbeat_sec * HEARTBEAT_GRACE:
+            return STATUS_UNCHANGED
+        return STATUS_MISSING
+
+
+class SeriesRegistry:
+    """
+    Maps (node_id, sensor_class, reading_name, is_local) to a SeriesTemplate.
+
+    get() is lock-free for known series; the lock is only taken to create one.
+    """
+
+    def __init__(self):
+        self._templates: dict[tuple, SeriesTemplate] = {}
+        self._by_sensor_id: dict[str, SeriesTemplate] = {}
+        self._lock = threading.Lock()
+
+    def get(
+        self, node_id: str, sensor_class: str, name: str, units: str, is_local: bool = False
+    ) -> SeriesTemplate:
+        """Get (or create) the template for a reading."""
+        key = (node_id, sensor_class, name, is_local)
+        template = self._templates.get(key)
+        if template is not None and template.units == units:
+            return template
+        return self._create(key, units)
+
+    def _create(self, key: tuple, units: str) -> SeriesTemplate:
+        node_id, sensor_class, name, is_local = key
+        with self._lock:
+            existing = self._templates.get(key)
+            if existing is not None and existing.units == units:
+                return existing
+
+            sensor_id = make_sensor_id(node_id, sensor_class, name)
+            template = SeriesTemplate(sensor_id, node_id, sensor_class, name, units, is_local)
+            if existing is not None:
+                # Units changed: rebuild metadata but keep cached lookups
+                logger.info(f"Series '{sensor_id}' units changed to '{units}'")
+                template.store_slot = existing.store_slot
+                template.rollup_rule = existing.rollup_rule
+                template.heartbeat_sec = existing.heartbeat_sec
+                template.last_seen = existing.last_seen
+            else:
+                logger.debug(f"New series '{sensor_id}'")
+
+            self._templates[key] = template
+            self._by_sensor_id[sensor_id] = template
+            return template
+
+    def by_sensor_id(self, sensor_id: str) -> SeriesTemplate | None:
+        """Look up a series by sensor ID (only series seen this run)."""
+        return self._by_sensor_id.get(sensor_id)
+
+    def statuses(self, now: float | None = None) -> dict[str, str]:
+        """Reporting status of every series seen this run, by sensor ID."""
+        now = time.time() if now is None else now
+        return {
+            sensor_id: t.status(now) for sensor_id, t in list(self._by_sensor_id.items())
+        }
+
+    def __len__(self) -> int:
+        return len(self._templates)
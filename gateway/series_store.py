@@ -0,0 +1,374 @@
+"""
+Memory-mapped columnar time-series ring store for the gateway.
+
+Keeps recent history on the gateway so it can be queried on site even when
+the dashboard is down. Every series gets a fixed-size slot in a single
+memory-mapped file, with separate timestamp and value columns (float64).
+Appends overwrite the oldest sample once a slot is full.
+
+File layout:
+    [file header: magic, version, capacity, max_series]           16 bytes
+    per slot: [count: u64, reserved: u64]                          16 bytes
+              [timestamps: f64 * capacity]
+              [values:     f64 * capacity]
+
+Series ID -> slot assignments are kept in a JSON sidecar ({path}.idx.json)
+so history survives gateway restarts.
+
+Classes:
+    SeriesStore: Fixed-size ring store with O(1) appends and range queries
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+import math
+import mmap
+import os
+import struct
+import tempfile
+import threading
+from pathlib import Path
+
+try:
+    import numpy as np
+except ImportError:  # numpy is optional; queries fall back to pure Python
+    np = None
+
+logger = logging.getLogger(__name__)
+
+_MAGIC = b"DLTS"
+_VERSION = 1
+_FILE_HEADER = struct.Struct("<4sIII")  # magic, version, capacity, max_series
+_SLOT_HEADER_SIZE = 16  # count (u64) + reserved (u64)
+
+
+class SeriesStore:
+    """
+    Fixed-size, memory-mapped ring store of (timestamp, value) series.
+
+    Appends are O(1) and allocate nothing per reading: the column views are
+    created once at open time and samples are written in place. Queries copy
+    the requested range out under the lock, so readers never see a torn ring.
+
+    Example:
+        store = SeriesStore("data/series.bin", capacity=86400, max_series=64)
+        store.append("patio_bme280temppressurehumidity_temperature", ts, 72.5)
+        result = store.query(sensor_id, t_from=ts - 3600, t_to=ts, step=60)
+    """
+
+    def __init__(
+        self,
+        path: str,
+        capacity: int = 86400,
+        max_series: int = 64,
+    ):
+        """
+        Open (or create) the store.
+
+        Args:
+            path: Path to the backing file (created if missing)
+            capacity: Samples kept per series (86400 = one day at 1 Hz)
+            max_series: Maximum number of distinct series
+        """
+        if capacity < 1 or max_series < 1:
+            raise ValueError("capacity and max_series must be positive")
+
+        self._path = Path(path)
+        self._index_path = Path(f"{path}.idx.json")
+        self._capacity = capacity
+        self._max_series = max_series
+        self._slot_size = _SLOT_HEADER_SIZE + 16 * capacity
+        self._lock = threading.Lock()
+
+        self._path.parent.mkdir(parents=True, exist_ok=True)
+        file_size = _FILE_HEADER.size + self._slot_size * max_series
+        fresh = not self._open_existing(file_size)
+        if fresh:
+            self._create(file_size)
+
+        self._mm = mmap.mmap(self._fd, file_size)
+
+        # Per-slot views, built once so append() does no allocation
+        view = memoryview(self._mm)
+        self._counts: list[memoryview] = []
+        self._ts_cols: list[memoryview] = []
+        self._val_cols: list[memoryview] = []
+        for slot in range(max_series):
+            base = _FILE_HEADER.size + slot * self._slot_size
+            col = base + _SLOT_HEADER_SIZE
+            self._counts.append(view[base : base + 8].cast("Q"))
+            self._ts_cols.append(view[col : col + 8 * capacity].cast("d"))
+            self._val_cols.append(
+                view[col + 8 * capacity : col + 16 * capacity].cast("d")
+            )
+
+        self._slots: dict[str, int] = {} if fresh else self._load_index()
+        logger.info(
+            f"Series store {'created' if fresh else 'opened'} at {self._path} "
+            f"({len(self._slots)}/{max_series} series, {capacity} samples each)"
+        )
+
+    # ─── File Management ────────────────────────────────────────────────────
+
+    def _open_existing(self, file_size: int) -> bool:
+        """Open an existing store file if its geometry matches. Returns success."""
+        if not self._path.exists() or self._path.stat().st_size != file_size:
+            return False
+        with open(self._path, "rb") as f:
+            header = f.read(_FILE_HEADER.size)
+        magic, version, capacity, max_series = _FILE_HEADER.unpack(header)
+        if (magic, version, capacity, max_series) != (
+            _MAGIC, _VERSION, self._capacity, self._max_series
+        ):
+            logger.warning(
+                f"Series store {self._path} has a different layout, recreating"
+            )
+            return False
+        self._fd = os.open(self._path, os.O_RDWR)
+        return True
+
+    def _create(self, file_size: int) -> None:
+        """Create a zero-filled store file with a fresh header."""
+        self._fd = os.open(self._path, os.O_RDWR | os.O_CREAT | os.O_TRUNC, 0o644)
+        os.ftruncate(self._fd, file_size)
+        os.pwrite(
+            self._fd,
+            _FILE_HEADER.pack(_MAGIC, _VERSION, self._capacity, self._max_series),
+            0,
+        )
+        try:
+            self._index_path.unlink()
+        except FileNotFoundError:
+            pass
+
+    def _load_index(self) -> dict[str, int]:
+        """Load series ID -> slot assignments from the sidecar file."""
+        try:
+            with open(self._index_path) as f:
+                data = json.load(f)
+            return {
+                str(k): int(v) for k, v in data.items()
+                if 0 <= int(v) < self._max_series
+            }
+        except (OSError, ValueError) as e:
+            logger.warning(f"Series index unreadable ({e}), starting empty")
+            return {}
+
+    def _save_index(self) -> None:
+        """Write the slot index atomically (temp file + rename)."""
+        try:
+            with tempfile.NamedTemporaryFile(
+                mode="w", dir=self._index_path.parent, suffix=".tmp", delete=False
+            ) as tmp:
+                json.dump(self._slots, tmp, indent=1, sort_keys=True)
+                tmp_path = tmp.name
+            os.replace(tmp_path, self._index_path)
+        except OSError as e:
+            logger.error(f"Failed to save series index: {e}")
+
+    def close(self) -> None:
+        """Flush and close the backing file."""
+        with self._lock:
+            if self._mm is None:
+                return
+            # Views must be released before the mmap can be closed
+            for views in (self._counts, self._ts_cols, self._val_cols):
+                for v in views:
+                    v.release()
+                views.clear()
+            self._mm.flush()
+            self._mm.close()
+            self._mm = None
+            os.close(self._fd)
+
+    # ─── Writes ─────────────────────────────────────────────────────────────
+
+    @property
+    def capacity(self) -> int:
+        return self._capacity
+
+    def slot_for(self, sensor_id: str) -> int:
+        """
+        Get the slot for a series, assigning one on first use.
+
+        Returns:
+            Slot index, or -1 if the store is full
+        """
+        slot = self._slots.get(sensor_id)
+        if slot is not None:
+            return slot
+        with self._lock:
+            slot = self._slots.get(sensor_id)
+            if slot is not None:
+                return slot
+            used = set(self._slots.values())
+            free = next((i for i in range(self._max_series) if i not in used), -1)
+            if free < 0:
+                logger.warning(f"Series store full, not storing '{sensor_id}'")
+                return -1
+            self._counts[free][0] = 0
+            self._slots[sensor_id] = free
+            self._save_index()
+            return free
+
+    def append_slot(self, slot: int, timestamp: float, value: float) -> None:
+        """Append one sample to a slot (O(1), no allocation)."""
+        if slot < 0:
+            return
+        with self._lock:
+            counts = self._counts[slot]
+            n = counts[0]
+            i = n % self._capacity
+            self._ts_cols[slot][i] = timestamp
+            self._val_cols[slot][i] = value
+            counts[0] = n + 1
+
+    def append(self, sensor_id: str, timestamp: float, value: float) -> None:
+        """Append one sample to a series by ID."""
+        self.append_slot(self.slot_for(sensor_id), timestamp, value)
+
+    # ─── Queries ────────────────────────────────────────────────────────────
+
+    def list_series(self) -> list[dict]:
+        """List stored series with sample counts and time span."""
+        result = []
+        with self._lock:
+            for sensor_id, slot in sorted(self._slots.items()):
+                n = self._counts[slot][0]
+                size = min(n, self._capacity)
+                entry = {"id": sensor_id, "count": size}
+                if size:
+                    newest = (n - 1) % self._capacity
+                    oldest = n % self._capacity if n > self._capacity else 0
+                    entry["oldest"] = self._ts_cols[slot][oldest]
+                    entry["newest"] = self._ts_cols[slot][newest]
+                result.append(entry)
+        return result
+
+    def _snapshot(self, slot: int):
+        """Copy a slot's columns out in chronological append order."""
+        with self._lock:
+            n = self._counts[slot][0]
+            ts_col = self._ts_cols[slot]
+            val_col = self._val_cols[slot]
+            if np is not None:
+                ts = np.frombuffer(ts_col, dtype=np.float64)
+                vals = np.frombuffer(val_col, dtype=np.float64)
+                if n <= self._capacity:
+                    return ts[:n].copy(), vals[:n].copy()
+                i = n % self._capacity
+                return (
+                    np.concatenate((ts[i:], ts[:i])),
+                    np.concatenate((vals[i:], vals[:i])),
+                )
+            if n <= self._capacity:
+                return ts_col[:n].tolist(), val_col[:n].tolist()
+            i = n % self._capacity
+            return (
+                ts_col[i:].tolist() + ts_col[:i].tolist(),
+                val_col[i:].tolist() + val_col[:i].tolist(),
+            )
+
+    def query(
+        self,
+        sensor_id: str,
+        t_from: float | None = None,
+        t_to: float | None = None,
+        step: float | None = None,
+    ) -> dict | None:
+        """
+        Query a time range, optionally downsampled into fixed-width buckets.
+
+        Args:
+            sensor_id: Series to query
+            t_from: Inclusive start timestamp (default: oldest sample)
+            t_to: Inclusive end timestamp (default: newest sample)
+            step: Bucket width in seconds. If set, each bucket returns its
+                  start time, mean, min, max and count.
+
+        Returns:
+            Columnar dict {"id", "t", "v"[, "min", "max", "count"]},
+            or None if the series is unknown.
+        """
+        slot = self._slots.get(sensor_id)
+        if slot is None:
+            return None
+        if step is not None and step <= 0:
+            raise ValueError("step must be positive")
+
+        lo = -math.inf if t_from is None else t_from
+        hi = math.inf if t_to is None else t_to
+        ts, vals = self._snapshot(slot)
+
+        if np is not None:
+            return self._query_numpy(sensor_id, ts, vals, lo, hi, step)
+        return self._query_python(sensor_id, ts, vals, lo, hi, step)
+
+    @staticmethod
+    def _query_numpy(sensor_id, ts, vals, lo, hi, step) -> dict:
+        """Vectorized range filter and bucketing."""
+        # Mask rather than bisect: late/out-of-order appends are allowed
+        mask = (ts >= lo) & (ts <= hi)
+        ts = ts[mask]
+        vals = vals[mask]
+        if step is None:
+            return {"id": sensor_id, "t": ts.tolist(), "v": vals.tolist()}
+
+        if ts.size == 0:
+            return {"id": sensor_id, "step": step,
+                    "t": [], "v": [], "min": [], "max": [], "count": []}
+
+        origin = ts.min() if lo == -math.inf else lo
+        buckets = np.floor((ts - origin) / step).astype(np.int64)
+        order = np.argsort(buckets, kind="stable")
+        buckets = buckets[order]
+        vals = vals[order]
+        starts = np.flatnonzero(np.r_[True, buckets[1:] != buckets[:-1]])
+        counts = np.diff(np.r_[starts, buckets.size])
+        sums = np.add.reduceat(vals, starts)
+        return {
+            "id": sensor_id,
+            "step": step,
+            "t": (origin + buckets[starts] * step).tolist(),
+            "v": (sums / counts).tolist(),
+            "min": np.minimum.reduceat(vals, starts).tolist(),
+            "max": np.maximum.reduceat(vals, starts).tolist(),
+            "count": counts.tolist(),
+        }
+
+    @staticmethod
+    def _query_python(sensor_id, ts, vals, lo, hi, step) -> dict:
+        """Pure-Python fallback for hosts without numpy."""
+        pairs = [(t, v) for t, v in zip(ts, vals) if lo <= t <= hi]
+        if step is None:
+            return {
+                "id": sensor_id,
+                "t": [t for t, _ in pairs],
+                "v": [v for _, v in pairs],
+            }
+
+        origin = min((t for t, _ in pairs), default=0.0) if lo == -math.inf else lo
+        # bucket -> [sum, min, max, count]
+        agg: dict[int, list] = {}
+        for t, v in pairs:
+            b = math.floor((t - origin) / step)
+            a = agg.get(b)
+            if a is None:
+                agg[b] = [v, v, v, 1]
+            else:
+                a[0] += v
+                a[1] = min(a[1], v)
+                a[2] = max(a[2], v)
+                a[3] += 1
+        keys = sorted(agg)
+        return {
+            "id": sensor_id,
+            "step": step,
+            "t": [origin + b * step for b in keys],
+            "v": [agg[b][0] / agg[b][3] for b in keys],
+            "min": [agg[b][1] for b in keys],
+            "max": [agg[b][2] for b in keys],
+            "count": [agg[b][3] for b in keys],
+        }
@@ -18,6 +18,41 @@ Configuration is loaded from config/gateway_config.json:
         "frequency_mhz": 915.0,
         "cs_pin": 24,
         "reset_pin": 25
+    },
+    "uplink_ack": {
+        "enabled": true,
+        "delay_sec": 1.0,
+        "dedup_window": 1024,
+        "max_backlog_slots": 512
+    },
+    "log_transfer": {
+        "enabled": true,
+        "output_dir": "data/logs",
+        "resend_after_sec": 5,
+        "max_resends": 5
+    },
+    "series_store": {
+        "enabled": true,
+        "path": "data/series.bin",
+        "capacity": 86400,
+        "max_series": 64
+    },
+    "rollups": {
+        "allowed_lateness_sec": 10,
+        "rules": [
+            {"match": "*_mma8452accelerometer_*", "window_sec": 60,
+             "mode": "aggregate", "rms": true}
+        ]
+    },
+    "alerts": {
+        "enabled": true,
+        "cooldown_sec": 300,
+        "rules": {
+            "patio_ads1115adc_a0": [
+                {"type": "threshold", "low": 1.5, "hysteresis": 0.3},
+                {"type": "stale", "max_age_sec": 900}
+            ]
+        }
     }
 }
 
@@ -38,8 +73,13 @@ from gpiozero import Button
 
 from display import OffPage, ScreenManager, SSD1306Display
 from gateway.display_pages import GatewayLocalSensors, LastPacketPage, SystemInfoPage
+from gateway.alerts import build_alert_manager
 from gateway.command_queue import CommandQueue
 from gateway.http_handler import CommandServer
+from gateway.log_transfers import LogTransferManager
+from gateway.rollups import build_rollup_engine
+from gateway.series_registry import SeriesRegistry
+from gateway.series_store import SeriesStore
 from gateway.sensor_collection import (
     DashboardClient,
     LocalSensorReader,
@@ -47,8 +87,10 @@ from gateway.sensor_collection import (
     instantiate_sensors,
 )
 from gateway.transceiver import LoRaTransceiver
+from gateway.uplink_acks import UplinkAckTracker
 from radio import RFM9xRadio
 from utils.gateway_state import GatewayState
+from utils.i2c_bus import get_bus
 from utils.led import RgbLed
 from utils.radio_state import RadioState
 
@@ -109,9 +151,38 @@ def run_gateway(
     gateway_state.config_path = config_path
     gateway_state.dashboard_url = dashboard_url
 
+    # Open on-gateway history store if configured
+    series_store = None
+    store_config = config.get("series_store", {})
+    if store_config.get("enabled", False):
+        try:
+            series_store = SeriesStore(
+                path=store_config.get("path", "data/series.bin"),
+                capacity=store_config.get("capacity", 86400),
+                max_series=store_config.get("max_series", 64),
+            )
+        except Exception as e:
+            logger.warning(f"Failed to open series store: {e}")
+            series_store = None
+
+    # Alert rules run on every ingested reading; notifications go out async
+    alert_manager = build_alert_manager(config.get("alerts", {}))
+    if alert_manager:
+        alert_manager.start()
+
+    # Interned per-series metadata, shared with the HTTP /series endpoint
+    series_registry = SeriesRegistry()
+
     # Create dashboard client and collector
     dashboard_client = DashboardClient(dashboard_url, node_id)
-    collector = SensorDataCollector(node_id, dashboard_client)
+    collector = SensorDataCollector(
+        node_id,
+        dashboard_client,
+        series_store=series_store,
+        rollup_engine=build_rollup_engine(config.get("rollups", {})),
+        alert_manager=alert_manager,
+        series_registry=series_registry,
+    )
     collector.start()
 
     logger.info(f"Gateway '{node_id}' posting to {dashboard_url}")
@@ -159,6 +230,17 @@ def run_gateway(
         "retry_multiplier": command_config.get("retry_multiplier", 1.5),
     }
 
+    # Reassembly of fetchlog sample-log transfers from nodes
+    log_transfer_config = config.get("log_transfer", {})
+    log_transfers = (
+        LogTransferManager(
+            output_dir=log_transfer_config.get("output_dir", "data/logs"),
+            resend_after_sec=log_transfer_config.get("resend_after_sec", 5.0),
+            max_resends=log_transfer_config.get("max_resends", 5),
+        )
+        if log_transfer_config.get("enabled", True) else None
+    )
+
     # Start command server if enabled
     command_server = None
 
@@ -169,6 +251,8 @@ def run_gateway(
             command_queue=command_queue,
             discovery_config=discovery_config,
         )
+        command_server.set_series_store(series_store, series_registry)
+        command_server.set_log_transfers(log_transfers)
         command_server.start()
         logger.info(f"Command server listening on port {port}")
 
@@ -205,6 +289,13 @@ def run_gateway(
             )
             gateway_state.radio_state = radio_state
 
+            # ACK sequenced sensor packets from confirmed-uplink nodes
+            uplink_ack_config = config.get("uplink_ack", {})
+            uplink_acks = (
+                UplinkAckTracker.from_config(uplink_ack_config)
+                if uplink_ack_config.get("enabled", True) else None
+            )
+
             lora_transceiver = LoRaTransceiver(
                 radio,
                 collector,
@@ -216,6 +307,8 @@ def run_gateway(
                 verbose_logging=verbose_logging,
                 n2g_freq=n2g_freq,
                 g2n_freq=g2n_freq,
+                uplink_acks=uplink_acks,
+                log_transfers=log_transfers,
             )
             lora_transceiver.set_flash_enabled(flash_on_recv_default)
             lora_transceiver.start()
@@ -258,9 +351,10 @@ def run_gateway(
 
     if display_config.get("enabled", False):
         try:
+            # Same bus handle and lock as the gateway's local I2C sensors
             display = SSD1306Display(
-                i2c_port=display_config.get("i2c_port", 1),
                 i2c_address=display_config.get("i2c_address", 0x3C),
+                bus=get_bus(display_config.get("i2c_port", 1)),
             )
             pages = [
                 OffPage(),
@@ -329,6 +423,10 @@ def run_gateway(
         if local_reader:
             local_reader.stop()
         collector.stop()
+        if alert_manager:
+            alert_manager.stop()
+        if series_store:
+            series_store.close()
         if screen_manager:
             screen_manager.close()
         if display_advance_button:
@@ -10,11 +10,20 @@ import threading
 import time
 
 from gateway.command_queue import CommandQueue, DiscoveryRequest
+from gateway.log_transfers import LogTransferManager
 from gateway.sensor_collection import SensorDataCollector
+from gateway.uplink_acks import UplinkAckTracker
 from radio import RFM9xRadio
 from utils.gateway_state import GatewayState
 from utils.led import RgbLed
-from utils.protocol import build_command_packet, parse_ack_packet, parse_lora_packet
+from utils.protocol import (
+    BOOT_READING_PREFIX,
+    BOOT_SENSOR_CLASS,
+    build_command_packet,
+    parse_ack_packet,
+    parse_log_chunk_packet,
+    parse_sensor_frame,
+)
 
 logger = logging.getLogger(__name__)
 cmd_logger = logging.getLogger("cmd_debug")
@@ -28,6 +37,8 @@ class LoRaTransceiver(threading.Thread):
     - Receiving sensor data from nodes → forwards to collector
     - Receiving ACKs from nodes → retires commands from queue
     - Sending commands from queue → transmits over LoRa with retry
+    - Sequenced sensor packets (confirmed uplink) → batched sensor ACKs on G2N
+    - Sample log chunks (fetchlog) → reassembly, logresend for missing chunks
     """
 
     def __init__(
@@ -42,6 +53,8 @@ class LoRaTransceiver(threading.Thread):
         verbose_logging: bool = False,
         n2g_freq: float = 915.0,
         g2n_freq: float = 915.5,
+        uplink_acks: UplinkAckTracker | None = None,
+        log_transfers: LogTransferManager | None = None,
     ):
         super().__init__(daemon=True, name="LoRaTransceiver")
         self._radio = radio
@@ -58,6 +71,8 @@ class LoRaTransceiver(threading.Thread):
         self._g2n_freq = g2n_freq  # Gateway to Node: commands
         self._discovery_request: DiscoveryRequest | None = None
         self._discovery_lock = threading.Lock()
+        self._uplink_acks = uplink_acks
+        self._log_transfers = log_transfers
 
     def request_discovery(self, request: DiscoveryRequest) -> bool:
         """Submit a discovery request. Returns False if one is already in progress."""
@@ -113,6 +128,14 @@ class LoRaTransceiver(threading.Thread):
                 # Check for pending commands to transmit
                 self._process_command_queue()
 
+                # Confirm sequenced sensor packets (batched per node)
+                if self._uplink_acks is not None:
+                    self._send_uplink_acks()
+
+                # Ask for chunks missing from stalled log transfers
+                if self._log_transfers is not None:
+                    self._request_log_resends()
+
             except Exception as e:
                 logger.error(f"LoRa transceiver error: {e}")
                 time.sleep(1)  # Back off on error
@@ -178,6 +201,32 @@ class LoRaTransceiver(threading.Thread):
                 except Exception:
                     pass
 
+    def _request_log_resends(self) -> None:
+        """Queue logresend commands for stalled log transfers."""
+        for node_id, transfer_id, ranges in self._log_transfers.due_resends():
+            command_id = self._command_queue.add("logresend", [str(transfer_id), ranges], node_id)
+            logger.info(
+                f"Log transfer {transfer_id} from '{node_id}': requesting chunks {ranges}"
+                + ("" if command_id else " (queue full)")
+            )
+
+    def _send_uplink_acks(self) -> None:
+        """Send due sensor ACKs on G2N (nodes listen there for commands)."""
+        for node_id, packet in self._uplink_acks.due_acks():
+            try:
+                self._radio.set_frequency(self._g2n_freq)
+                success = self._radio.send(packet)
+                cmd_logger.debug(
+                    "SACK_TX node=%s bytes=%d success=%s", node_id, len(packet), success
+                )
+            except Exception as e:
+                logger.error(f"Error sending sensor ACK to '{node_id}': {e}")
+            finally:
+                try:
+                    self._radio.set_frequency(self._n2g_freq)
+                except Exception:
+                    pass
+
     def _execute_discovery(self, request: DiscoveryRequest) -> None:
         """
         Execute discovery loop: broadcast ping, collect ACKs, repeat with backoff.
@@ -279,6 +328,14 @@ class LoRaTransceiver(threading.Thread):
                     else 0
                 )
                 logger.info(f"ACK received from '{ack.node_id}' (RSSI: {rssi} dB)")
+                # fetchlog ACK announces the transfer, chunks follow
+                payload = ack.payload or {}
+                if (
+                    retired.cmd == "fetchlog"
+                    and self._log_transfers is not None
+                    and "x" in payload and "m" in payload
+                ):
+                    self._log_transfers.expect(ack.node_id, payload["x"], payload["m"])
                 cmd_logger.debug(
                     "ACK_MATCH id=%s node=%s rssi=%s rtt_ms=%.0f attempts=%d payload=%s",
                     ack.command_id, ack.node_id, rssi, rtt_ms, retired.retry_count,
@@ -296,9 +353,16 @@ class LoRaTransceiver(threading.Thread):
                 )
             return
 
+        # Sample log chunk (fetchlog transfer)
+        chunk = parse_log_chunk_packet(packet)
+        if chunk is not None:
+            if self._log_transfers is not None:
+                self._log_transfers.add_chunk(chunk)
+            return
+
         # Otherwise, process as sensor data
-        result = parse_lora_packet(packet)
-        if result is None:
+        frame = parse_sensor_frame(packet)
+        if frame is None:
             # Log hex dump for debugging packet issues
             hex_bytes = ' '.join(f'{b:02x}' for b in packet[:80])
             logger.warning(
@@ -306,14 +370,21 @@ class LoRaTransceiver(threading.Thread):
             )
             return
 
-        node_id, readings = result
+        node_id, readings = frame.node_id, frame.readings
+
+        # Confirmed uplink: ACK every copy, deliver only the first
+        if frame.seq is not None and self._uplink_acks is not None:
+            if not self._uplink_acks.record(node_id, frame.seq, frame.backfill):
+                logger.debug(f"Duplicate packet {frame.seq} from '{node_id}', re-ACKing")
+                return
 
         # Replace timestamp=0 with gateway receive time
         for reading in readings:
             if reading.timestamp == 0:
                 reading.timestamp = receive_time
         logger.info(
-            f"LoRa received from '{node_id}': {len(readings)} readings (RSSI: {rssi} dB)"
+            f"LoRa received from '{node_id}': {len(readings)} "
+            f"{'backfilled ' if frame.backfill else ''}readings (RSSI: {rssi} dB)"
         )
 
         # Flash LED on successful receive
@@ -331,4 +402,21 @@ class LoRaTransceiver(threading.Thread):
                 sensor_units=r.units,
             )
 
-        self._collector.add_readings(node_id, readings, is_local=False)
+        # One-shot boot report sent after a node's first broadcast
+        if self._gateway_state:
+            boot = {
+                r.name[len(BOOT_READING_PREFIX):]: r.value
+                for r in readings
+                if r.sensor_class == BOOT_SENSOR_CLASS
+                and r.name.startswith(BOOT_READING_PREFIX)
+            }
+            if boot:
+                self._gateway_state.update_node_boot(node_id, boot)
+                logger.info(
+                    f"Node '{node_id}' boot: first packet after "
+                    f"{boot.get('First Packet', 0):.1f}s"
+                )
+
+        self._collector.add_readings(
+            node_id, readings, is_local=False, historical=frame.backfill
+        )
@@ -0,0 +1,168 @@
+"""
+Batched sensor ACKs for confirmed uplinks.
+
+Nodes in confirmed-uplink mode number their sensor packets ("q") and keep
+them until the gateway confirms them. Rather than answer every packet, the
+tracker collects received sequence numbers per node and sends one "sack"
+with inclusive ranges once ack_delay_sec has passed since the first
+unacknowledged packet, so a multi-packet broadcast costs one G2N frame.
+
+Duplicates (a backfilled packet whose original did arrive but whose ACK was
+lost) are acknowledged again but reported so the caller can drop them. A
+live seq more than the dedup window below the highest seen from a node
+means the node's sequence restarted (recreated backlog); its window is
+cleared so the new packets aren't mistaken for old ones. Backfilled seqs
+never count as a restart: they come from the node's backlog, which is why
+the window must be at least the largest node's uplink.backlog_slots.
+
+Config:
+    "uplink_ack": {"enabled": true, "delay_sec": 1.0, "dedup_window": 1024,
+                   "max_backlog_slots": 512}
+
+Classes:
+    UplinkAckTracker: Per-node received sequence numbers and pending ACKs
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from collections import deque
+
+from utils.protocol import LORA_MAX_PAYLOAD, build_sack_packet, seqs_to_ranges
+
+logger = logging.getLogger(__name__)
+
+# Ranges per sack, keeps the packet well inside the LoRa payload limit
+MAX_SACK_RANGES = 16
+
+SEQ_MASK = 0xFFFFFFFF
+
+
+class UplinkAckTracker:
+    """
+    Tracks sequenced sensor packets per node and batches their ACKs.
+
+    record() runs when a packet is received, due_acks() from the transceiver
+    loop; both are on the transceiver thread but the lock keeps stats safe
+    to read from HTTP handlers.
+    """
+
+    def __init__(
+        self,
+        ack_delay_sec: float = 1.0,
+        dedup_window: int = 1024,
+        max_backlog_slots: int = 0,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            ack_delay_sec: Wait this long after the first unACKed packet before sending
+            dedup_window: Recent sequence numbers remembered per node for dedup
+            max_backlog_slots: Largest uplink.backlog_slots of any node
+            clock: Monotonic time source (injectable for tests)
+
+        Raises:
+            ValueError: If dedup_window is smaller than max_backlog_slots
+        """
+        if dedup_window < max_backlog_slots:
+            raise ValueError(
+                f"uplink_ack.dedup_window ({dedup_window}) must be at least the "
+                f"nodes' backlog_slots ({max_backlog_slots})"
+            )
+        self._delay = ack_delay_sec
+        self._window = dedup_window
+        self._clock = clock
+        self._lock = threading.Lock()
+        # node_id -> (set, FIFO) of recently seen seqs
+        self._seen: dict[str, tuple[set[int], deque[int]]] = {}
+        # node_id -> highest seq seen (modulo 2^32)
+        self._highest: dict[str, int] = {}
+        # node_id -> (first pending monotonic time, seqs to ACK)
+        self._pending: dict[str, tuple[float, set[int]]] = {}
+        self.duplicates = 0
+        self.backfilled = 0
+        self.resets = 0
+
+    @classmethod
+    def from_config(cls, config: dict) -> UplinkAckTracker:
+        """Build from the gateway's "uplink_ack" config dict."""
+        return cls(
+            ack_delay_sec=config.get("delay_sec", 1.0),
+            dedup_window=config.get("dedup_window", 1024),
+            max_backlog_slots=config.get("max_backlog_slots", 512),
+        )
+
+    def record(self, node_id: str, seq: int, backfill: bool = False) -> bool:
+        """
+        Note a received sequenced packet and schedule its ACK.
+
+        Returns:
+            True if new, False if a duplicate (already delivered)
+        """
+        with self._lock:
+            pending = self._pending.get(node_id)
+            if pending is None:
+                self._pending[node_id] = (self._clock(), {seq})
+            else:
+                pending[1].add(seq)
+
+            seen, order = self._seen.setdefault(node_id, (set(), deque()))
+            if seq in seen:
+                self.duplicates += 1
+                return False
+
+            highest = self._highest.get(node_id)
+            # Modular distance back from the highest; >= 2^31 means seq is ahead
+            behind = (highest - seq) & SEQ_MASK if highest is not None else 0
+            ahead = highest is None or behind >= 1 << 31
+            # Backfill is old by design; only a live seq can show a restart
+            restarted = not backfill and self._window < behind < 1 << 31
+            if restarted:
+                logger.info(
+                    f"Node {node_id} sequence restarted ({highest} -> {seq}), "
+                    f"clearing dedup window"
+                )
+                self.resets += 1
+                seen.clear()
+                order.clear()
+            if ahead or restarted:
+                self._highest[node_id] = seq
+
+            seen.add(seq)
+            order.append(seq)
+            if len(order) > self._window:
+                seen.discard(order.popleft())
+            if backfill:
+                self.backfilled += 1
+            return True
+
+    def due_acks(self) -> list[tuple[str, bytes]]:
+        """
+        Sack packets ready to send, as (node_id, packet).
+
+        Nodes with more than MAX_SACK_RANGES ranges (or more than fit in
+        one LoRa payload; node seqs start at a random 31-bit number) get the
+        oldest ranges now and the rest on the next call.
+        """
+        now = self._clock()
+        result = []
+        with self._lock:
+            for node_id, (first_at, seqs) in list(self._pending.items()):
+                if now - first_at < self._delay:
+                    continue
+                ranges = seqs_to_ranges(seqs)
+                count = min(len(ranges), MAX_SACK_RANGES)
+                packet = build_sack_packet(node_id, ranges[:count])
+                while count > 1 and len(packet) > LORA_MAX_PAYLOAD:
+                    count -= 1
+                    packet = build_sack_packet(node_id, ranges[:count])
+                rest = ranges[count:]
+                if rest:
+                    remaining = {q for start, end in rest for q in range(start, end + 1)}
+                    self._pending[node_id] = (now - self._delay, remaining)
+                else:
+                    del self._pending[node_id]
+                result.append((node_id, packet))
+        return result
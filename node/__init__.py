@@ -3,5 +3,18 @@ Node package - outdoor sensor node that broadcasts via LoRa.
 
 This package contains:
 - data_log: Main node logic (sensor reading, LoRa broadcasting, command receiving)
+- command_executor: Command handler pool with ACK caching and retry dedup
+- aggregation: Background sampling with windowed statistics per reading
+- boot: Concurrent sensor init and boot-to-first-packet timing
+- duty_cycle: Low-power RX window schedule
+- adaptive: Variance-driven adaptive sensor intervals
+- deadband: Report-by-exception filtering of unchanged readings
+- scheduler: Monotonic, phase-aligned sensor scheduler with uplink coalescing
+- metrics: Timing samples and metered radio lock for self-telemetry
+- telemetry: NodeTelemetry sensor (radio energy, timing, host resources)
+- sensor_reader: Concurrent sensor reads with per-sensor deadlines
+- uplink_backlog: On-disk backlog of unconfirmed uplinks for backfill
+- sample_log: Full-resolution on-disk ring of every sample
+- log_transfer: Chunked fetchlog streaming with selective resend
 - display: Display pages for sensor node OLED
 """
@@ -0,0 +1,167 @@
+"""
+Variance-driven adaptive sensor intervals.
+
+A sensor with an "adaptive" config has its interval adjusted after every
+read. If any watched reading is active, the interval shrinks by "shrink"
+(bounded by min_interval_sec). A reading is active when it changes faster
+than "rate" units per second, or when its spread over the last "window"
+reads (standard deviation) is above "std". After "quiet_samples" quiet reads
+in a row, the interval relaxes by "relax", up to max_interval_sec.
+
+Events therefore get a fast response (halving per read), and quiet periods
+drift back to the slow interval gradually. The spread window is a natural
+hysteresis: one spike keeps the sensor fast until it has left the window.
+
+The scheduler keeps the phase: the next due time becomes the previous
+scheduled time plus the new interval (SensorScheduler.set_interval).
+
+Config (per sensor, starts at its "interval_sec"):
+    "adaptive": {"min_interval_sec": 5, "max_interval_sec": 300,
+                 "std": 0.2, "rate": 0.01, "readings": ["Temperature"],
+                 "window": 8, "shrink": 0.5, "relax": 1.5, "quiet_samples": 3}
+
+Classes:
+    AdaptiveConfig: Bounds, thresholds and step factors for one sensor
+    AdaptiveInterval: Per-sensor controller fed with each read's readings
+"""
+
+from __future__ import annotations
+
+import logging
+import math
+from collections import deque
+from dataclasses import dataclass
+
+from utils.protocol import SensorReading
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class AdaptiveConfig:
+    """Adaptive interval settings. At least one of std/rate must be set."""
+
+    min_interval_sec: float
+    max_interval_sec: float
+    std: float | None = None  # Spread over the window that counts as active
+    rate: float | None = None  # Units per second that counts as active
+    readings: list[str] | None = None  # Reading names watched (None = all)
+    window: int = 8
+    shrink: float = 0.5
+    relax: float = 1.5
+    quiet_samples: int = 3
+
+    def __post_init__(self):
+        if self.std is None and self.rate is None:
+            raise ValueError("adaptive needs at least one of std/rate")
+        if not 0 < self.min_interval_sec <= self.max_interval_sec:
+            raise ValueError("adaptive needs 0 < min_interval_sec <= max_interval_sec")
+        if not 0 < self.shrink < 1 or self.relax <= 1:
+            raise ValueError("adaptive needs 0 < shrink < 1 and relax > 1")
+        if self.window < 2 or self.quiet_samples < 1:
+            raise ValueError("adaptive needs window >= 2 and quiet_samples >= 1")
+
+    @classmethod
+    def from_config(cls, config: dict | None, interval_sec: float) -> AdaptiveConfig | None:
+        """
+        Build from a sensor's "adaptive" config dict (None if absent).
+
+        The bounds default to a tenth of interval_sec and interval_sec itself.
+        """
+        if not config:
+            return None
+        return cls(
+            min_interval_sec=config.get("min_interval_sec", interval_sec / 10),
+            max_interval_sec=config.get("max_interval_sec", interval_sec),
+            std=config.get("std"),
+            rate=config.get("rate"),
+            readings=config.get("readings"),
+            window=config.get("window", 8),
+            shrink=config.get("shrink", 0.5),
+            relax=config.get("relax", 1.5),
+            quiet_samples=config.get("quiet_samples", 3),
+        )
+
+    def check_names(self, names: tuple[str, ...]) -> None:
+        """
+        Raise ValueError if a watched reading isn't one of the sensor's names.
+
+        With "aggregate" the names are the summaries, e.g. "Temperature mean".
+        """
+        names = tuple(names)
+        for name in self.readings or ():
+            if name not in names:
+                raise ValueError(f"adaptive watches unknown reading {name!r}; readings: {names}")
+
+
+class AdaptiveInterval:
+    """
+    Picks a sensor's next interval from its recent readings.
+
+    Only used from the broadcast loop; interval may be read from any thread.
+    """
+
+    def __init__(self, config: AdaptiveConfig, interval_sec: float):
+        """
+        Args:
+            config: Bounds and thresholds
+            interval_sec: Starting interval (clamped into the bounds)
+        """
+        self.config = config
+        self.interval_sec = self._clamp(interval_sec)
+        self._history: dict[str, deque[tuple[float, float]]] = {}
+        self._quiet = 0
+
+    def _clamp(self, interval: float) -> float:
+        return min(self.config.max_interval_sec, max(self.config.min_interval_sec, interval))
+
+    def _is_active(self, reading: SensorReading) -> bool:
+        config = self.config
+        history = self._history.get(reading.name)
+        if history is None:
+            history = self._history[reading.name] = deque(maxlen=config.window)
+        ts = reading.timestamp or 0.0
+        active = False
+
+        if config.rate is not None and history:
+            last_ts, last_value = history[-1]
+            dt = ts - last_ts
+            if dt > 0 and abs(reading.value - last_value) / dt > config.rate:
+                active = True
+
+        history.append((ts, reading.value))
+
+        if config.std is not None and len(history) >= 3:
+            n = len(history)
+            mean = sum(v for _, v in history) / n
+            spread = math.sqrt(sum((v - mean) ** 2 for _, v in history) / n)
+            if spread > config.std:
+                active = True
+        return active
+
+    def update(self, readings: list[SensorReading]) -> float:
+        """
+        Feed one read's readings and return the interval to use next.
+
+        Readings without a value or not in config.readings are ignored; a read
+        with nothing usable leaves the interval unchanged.
+        """
+        watched = self.config.readings
+        usable = [
+            r for r in readings
+            if r.value is not None and (watched is None or r.name in watched)
+        ]
+        if not usable:
+            return self.interval_sec
+
+        # Every reading goes through _is_active so all histories stay current
+        active = [self._is_active(r) for r in usable]
+        if any(active):
+            self._quiet = 0
+            self.interval_sec = self._clamp(self.interval_sec * self.config.shrink)
+        else:
+            self._quiet += 1
+            if self._quiet >= self.config.quiet_samples:
+                self._quiet = 0
+                self.interval_sec = self._clamp(self.interval_sec * self.config.relax)
+        return self.interval_sec
@@ -0,0 +1,257 @@
+"""
+On-node windowed statistics for high-rate sampling.
+
+AggregatingSensor wraps any Sensor and samples it on a background thread at
+its own sample_interval_sec. Each reading name gets a streaming accumulator
+(Welford mean/variance, min, max, count, plus an optional bounded sample
+buffer for percentiles). When the broadcast loop reads the sensor on its
+interval_sec, the window's summary is returned and the window resets.
+
+Summaries are ordinary readings named "{reading} {stat}", e.g. "Accel X max",
+"Accel X p95", sent under the wrapped sensor's class ID, so sample rate and
+transmit rate are independent and the gateway needs no changes.
+
+Config (per sensor):
+    "aggregate": {"sample_interval_sec": 0.05,
+                  "stats": ["min", "max", "mean", "std", "count"],
+                  "percentiles": [50, 95]}
+
+Classes:
+    RunningStats: Streaming statistics for one reading
+    AggregatingSensor: Sensor wrapper that samples in the background
+"""
+
+from __future__ import annotations
+
+import logging
+import math
+import random
+import threading
+import time
+
+from sensors import Sensor
+from utils.log_throttle import log_throttled
+
+logger = logging.getLogger(__name__)
+
+VALID_STATS = ("min", "max", "mean", "std", "count")
+DEFAULT_STATS = VALID_STATS
+
+# Samples kept per reading for percentiles; beyond this, reservoir sampling
+DEFAULT_MAX_SAMPLES = 2048
+
+
+class RunningStats:
+    """Streaming min/max/mean/std (Welford) with optional reservoir for percentiles."""
+
+    __slots__ = ("count", "mean", "m2", "min", "max", "samples", "max_samples")
+
+    def __init__(self, keep_samples: bool = False, max_samples: int = DEFAULT_MAX_SAMPLES):
+        self.count = 0
+        self.mean = 0.0
+        self.m2 = 0.0
+        self.min = math.inf
+        self.max = -math.inf
+        self.samples: list[float] | None = [] if keep_samples else None
+        self.max_samples = max_samples
+
+    def add(self, value: float) -> None:
+        self.count += 1
+        delta = value - self.mean
+        self.mean += delta / self.count
+        self.m2 += delta * (value - self.mean)
+        if value < self.min:
+            self.min = value
+        if value > self.max:
+            self.max = value
+        samples = self.samples
+        if samples is not None:
+            if len(samples) < self.max_samples:
+                samples.append(value)
+            else:
+                # Reservoir sampling keeps a uniform subset of the window
+                j = random.randrange(self.count)
+                if j < self.max_samples:
+                    samples[j] = value
+
+    @property
+    def std(self) -> float:
+        """Population standard deviation."""
+        return math.sqrt(self.m2 / self.count) if self.count else 0.0
+
+    def percentile(self, p: float) -> float:
+        """Linear-interpolated percentile (0-100) of the kept samples."""
+        ordered = sorted(self.samples)
+        pos = (len(ordered) - 1) * p / 100.0
+        lo = math.floor(pos)
+        hi = min(lo + 1, len(ordered) - 1)
+        return ordered[lo] + (ordered[hi] - ordered[lo]) * (pos - lo)
+
+
+class AggregatingSensor(Sensor):
+    """
+    Samples an inner sensor in the background and reports window summaries.
+
+    The inner sensor's transform() is applied per sample, so summaries are
+    in final units. read() returns None for every stat of an empty window.
+    """
+
+    def __init__(
+        self,
+        inner: Sensor,
+        sample_interval_sec: float,
+        stats: list[str] | tuple[str, ...] = DEFAULT_STATS,
+        percentiles: list[float] | tuple[float, ...] = (),
+        max_samples: int = DEFAULT_MAX_SAMPLES,
+    ):
+        """
+        Args:
+            inner: Sensor to sample
+            sample_interval_sec: Time between samples
+            stats: Subset of "min", "max", "mean", "std", "count"
+            percentiles: Percentiles to report (0-100), e.g. [50, 95]
+            max_samples: Samples kept per reading for percentiles
+        """
+        unknown = [s for s in stats if s not in VALID_STATS]
+        if unknown:
+            raise ValueError(f"Unknown aggregate stats {unknown}; valid: {VALID_STATS}")
+        if sample_interval_sec <= 0:
+            raise ValueError("sample_interval_sec must be positive")
+        if any(not 0 <= p <= 100 for p in percentiles):
+            raise ValueError("percentiles must be within 0-100")
+
+        self._inner = inner
+        self._interval = sample_interval_sec
+        self._stats = tuple(stats)
+        self._percentiles = tuple(percentiles)
+        self._max_samples = max_samples
+        self._lock = threading.Lock()
+        self._window = self._new_window()
+        self._thread: threading.Thread | None = None
+        self._stop = threading.Event()
+        self.sample_errors = 0
+        self.sample_log = None  # Optional SampleLog that gets every raw sample
+
+    @property
+    def inner(self) -> Sensor:
+        return self._inner
+
+    def _new_window(self) -> list[RunningStats]:
+        keep = bool(self._percentiles)
+        return [
+            RunningStats(keep, self._max_samples) for _ in self._inner.get_names()
+        ]
+
+    # ─── Sensor Interface ───────────────────────────────────────────────────
+
+    def init(self) -> None:
+        self._inner.init()
+        self._window = self._new_window()
+        self._stop.clear()
+        self._thread = threading.Thread(
+            target=self._sample_loop,
+            daemon=True,
+            name=f"Sampler-{self._inner.class_name}",
+        )
+        self._thread.start()
+        logger.info(
+            f"Sampling {self._inner.class_name} every {self._interval}s "
+            f"(stats: {', '.join(self._stat_labels())})"
+        )
+
+    def read(self) -> tuple:
+        """Summarize the current window and start a new one."""
+        with self._lock:
+            window = self._window
+            self._window = self._new_window()
+
+        values = []
+        for acc in window:
+            for stat in self._stat_labels():
+                values.append(self._stat_value(acc, stat))
+        return tuple(values)
+
+    def get_names(self) -> tuple[str, ...]:
+        return tuple(
+            f"{name} {stat}"
+            for name in self._inner.get_names()
+            for stat in self._stat_labels()
+        )
+
+    def get_units(self) -> tuple[str, ...]:
+        return tuple(
+            "" if stat == "count" else unit
+            for unit in self._inner.get_units()
+            for stat in self._stat_labels()
+        )
+
+    def get_precision(self) -> int:
+        return self._inner.get_precision()
+
+    def close(self) -> None:
+        self._stop.set()
+        if self._thread and self._thread.is_alive():
+            self._thread.join(timeout=2.0)
+        self._inner.close()
+
+    # ─── Sampling ───────────────────────────────────────────────────────────
+
+    def sample_once(self) -> None:
+        """Take one sample from the inner sensor into the current window."""
+        values = self._inner.transform(self._inner.read())
+        with self._lock:
+            for acc, value in zip(self._window, values):
+                if value is not None:
+                    acc.add(value)
+        if self.sample_log is not None:
+            self.sample_log.append_values(
+                self._inner.class_name, self._inner.get_names(), values, time.time()
+            )
+
+    def _sample_loop(self) -> None:
+        # Fixed-rate on the monotonic clock; overruns skip ahead, not burst
+        next_at = time.monotonic()
+        while not self._stop.is_set():
+            try:
+                self.sample_once()
+            except Exception as e:
+                self.sample_errors += 1
+                log_throttled(
+                    logger, logging.ERROR, self.sample_errors,
+                    f"{self._inner.class_name} sample error (#{self.sample_errors}): {e}",
+                )
+            next_at += self._interval
+            now = time.monotonic()
+            if next_at < now:
+                next_at = now
+            self._stop.wait(next_at - now)
+
+    def _stat_labels(self) -> list[str]:
+        return list(self._stats) + [f"p{p:g}" for p in self._percentiles]
+
+    @staticmethod
+    def _stat_value(acc: RunningStats, stat: str) -> float | None:
+        if stat == "count":
+            return acc.count
+        if acc.count == 0:
+            return None
+        if stat == "min":
+            return acc.min
+        if stat == "max":
+            return acc.max
+        if stat == "mean":
+            return acc.mean
+        if stat == "std":
+            return acc.std
+        return acc.percentile(float(stat[1:]))
+
+    @classmethod
+    def from_config(cls, inner: Sensor, config: dict) -> AggregatingSensor:
+        """Build from a sensor's "aggregate" config dict."""
+        return cls(
+            inner,
+            sample_interval_sec=config.get("sample_interval_sec", 1.0),
+            stats=config.get("stats", DEFAULT_STATS),
+            percentiles=config.get("percentiles", ()),
+            max_samples=config.get("max_samples", DEFAULT_MAX_SAMPLES),
+        )
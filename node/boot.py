@@ -0,0 +1,281 @@
+"""
+Node cold-start helpers: concurrent sensor init and boot timing.
+
+Most of a node's start-up is spent waiting on hardware (BME280 and MMA8452
+settle delays, radio reset), not on the CPU, so data_log runs sensor init()
+calls on a thread pool and overlaps them with radio init.
+
+A sensor whose init() fails at start-up (bus not probed yet, device still
+powering up) is kept and given an InitRetry: its reads retry init() with a
+growing wait in between, instead of the sensor being dropped until the
+process restarts.
+
+BootTimer records where the time went between process start and the first
+packet on air. The node sends it once, as NodeTelemetry readings, right
+after the first broadcast; the gateway keeps the latest per node
+(GET /gateway/boots):
+
+    Boot Since Kernel  s  Kernel boot to process start (only after a reboot)
+    Boot Imports       s  Process start to data_log's imports done
+    Boot Sensor Init   s  Constructing and initializing all sensors
+    Boot Radio Init    s  Radio reset and configuration
+    Boot First Packet  s  Process start to the first packet sent
+
+Classes:
+    BootTimer: Phase durations from process start to first packet
+    InitResult: Outcome of one sensor init()
+    InitRetry: Backed-off init() retries for a sensor that failed at start-up
+    SensorInitPending: Raised by reads while waiting for the next retry
+
+Functions:
+    init_concurrently: Run init() for several sensors on a thread pool
+    process_start_uptime: Seconds after kernel boot this process started
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import contextmanager
+from dataclasses import dataclass
+
+from sensors import Sensor
+from utils.protocol import BOOT_READING_PREFIX, BOOT_SENSOR_CLASS, SensorReading
+
+logger = logging.getLogger(__name__)
+
+PHASE_SENSOR_INIT = "Sensor Init"
+PHASE_RADIO_INIT = "Radio Init"
+
+# A process that started this long after kernel boot was restarted, not booted
+_RESTART_AFTER_SEC = 300.0
+
+# Wait before retrying a failed sensor init(), doubling per failure up to the max
+INIT_RETRY_FIRST_SEC = 5.0
+INIT_RETRY_MAX_SEC = 300.0
+
+
+# =============================================================================
+# Process Start
+# =============================================================================
+
+
+def _system_uptime() -> float | None:
+    try:
+        with open("/proc/uptime") as f:
+            return float(f.read().split()[0])
+    except (OSError, ValueError, IndexError):
+        return None
+
+
+def process_start_uptime() -> float | None:
+    """Seconds after kernel boot that this process started (None off Linux)."""
+    try:
+        with open("/proc/self/stat") as f:
+            stat = f.read()
+        # comm may contain spaces; field 3 onwards follows the last ")"
+        fields = stat[stat.rindex(")") + 2 :].split()
+        return int(fields[19]) / os.sysconf("SC_CLK_TCK")
+    except (OSError, ValueError, IndexError):
+        return None
+
+
+# =============================================================================
+# Boot Timer
+# =============================================================================
+
+
+class BootTimer:
+    """
+    Phase durations from process start to the first packet.
+
+    Create it as early as possible (data_log does so right after its
+    imports); everything before that is attributed to imports. Phases may
+    overlap and be timed from different threads.
+    """
+
+    def __init__(self, clock=time.monotonic):
+        self._clock = clock
+        self._created = clock()
+        self._lock = threading.Lock()
+        self._phases: dict[str, float] = {}
+        self._first_packet: float | None = None
+
+        start = process_start_uptime()
+        uptime = _system_uptime()
+        if start is not None and uptime is not None:
+            self.imports_sec = max(0.0, uptime - start)
+            self.since_kernel_sec = start if start < _RESTART_AFTER_SEC else None
+        else:
+            self.imports_sec = 0.0
+            self.since_kernel_sec = None
+
+    @contextmanager
+    def phase(self, name: str):
+        """Time a block as the named phase."""
+        start = self._clock()
+        try:
+            yield
+        finally:
+            elapsed = self._clock() - start
+            with self._lock:
+                self._phases[name] = elapsed
+            logger.info(f"Boot: {name.lower()} took {elapsed:.2f}s")
+
+    def mark_first_packet(self) -> None:
+        """Record the first packet on air (later calls are ignored)."""
+        with self._lock:
+            if self._first_packet is not None:
+                return
+            self._first_packet = self._clock()
+        logger.info(f"Boot: first packet {self.first_packet_sec:.2f}s after process start")
+
+    @property
+    def first_packet_sec(self) -> float | None:
+        """Process start to first packet, or None before it is sent."""
+        if self._first_packet is None:
+            return None
+        return self.imports_sec + self._first_packet - self._created
+
+    def readings(self) -> list[SensorReading]:
+        """Boot breakdown as NodeTelemetry readings."""
+        with self._lock:
+            phases = dict(self._phases)
+        values = []
+        if self.since_kernel_sec is not None:
+            values.append(("Since Kernel", self.since_kernel_sec))
+        values.append(("Imports", self.imports_sec))
+        for name in (PHASE_SENSOR_INIT, PHASE_RADIO_INIT):
+            if name in phases:
+                values.append((name, phases[name]))
+        if self.first_packet_sec is not None:
+            values.append(("First Packet", self.first_packet_sec))
+        return [
+            SensorReading(
+                name=BOOT_READING_PREFIX + name,
+                units="s",
+                value=round(value, 3),
+                sensor_class=BOOT_SENSOR_CLASS,
+                timestamp=0,
+                precision=3,
+            )
+            for name, value in values
+        ]
+
+
+# =============================================================================
+# Concurrent Init
+# =============================================================================
+
+
+@dataclass
+class InitResult:
+    """Outcome of one sensor's init()."""
+
+    elapsed_sec: float
+    error: Exception | None = None
+
+
+def init_concurrently(
+    sensors: list[Sensor], max_workers: int | None = None
+) -> list[InitResult]:
+    """
+    Call init() on every sensor, concurrently.
+
+    Args:
+        sensors: Constructed sensors
+        max_workers: Thread cap (default: one per sensor; 0 or 1 = sequential)
+
+    Returns:
+        One InitResult per sensor, in input order. Exceptions are captured,
+        not raised, so one bad sensor doesn't stop the others.
+    """
+
+    def run(sensor: Sensor) -> InitResult:
+        start = time.monotonic()
+        try:
+            sensor.init()
+        except Exception as e:
+            return InitResult(time.monotonic() - start, e)
+        return InitResult(time.monotonic() - start)
+
+    workers = len(sensors) if max_workers is None else max_workers
+    if workers <= 1 or len(sensors) <= 1:
+        return [run(sensor) for sensor in sensors]
+    with ThreadPoolExecutor(
+        max_workers=min(workers, len(sensors)), thread_name_prefix="sensor-init"
+    ) as pool:
+        return list(pool.map(run, sensors))
+
+
+# =============================================================================
+# Init Retry
+# =============================================================================
+
+
+class SensorInitPending(RuntimeError):
+    """A read of a sensor whose init() is waiting for its next retry."""
+
+
+class InitRetry:
+    """
+    Retries a sensor's failed init() from its reads.
+
+    read_entry() calls ensure() before each read until init() succeeds.
+    Before the next attempt is due, ensure() raises SensorInitPending so
+    the read is skipped; a failed attempt re-raises the init() error and
+    doubles the wait, up to max_delay_sec.
+    """
+
+    def __init__(
+        self,
+        error: Exception,
+        first_delay_sec: float = INIT_RETRY_FIRST_SEC,
+        max_delay_sec: float = INIT_RETRY_MAX_SEC,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            error: The start-up init() failure
+            first_delay_sec: Wait before the first retry
+            max_delay_sec: Longest wait between retries
+            clock: Monotonic time source (injectable for tests)
+        """
+        self._delay = first_delay_sec
+        self._max_delay = max_delay_sec
+        self._clock = clock
+        self._next_at = clock() + first_delay_sec
+        self.last_error = error
+        self.attempts = 1  # The start-up attempt
+
+    def ensure(self, sensor: Sensor, name: str) -> None:
+        """
+        Retry init() if due.
+
+        Raises:
+            SensorInitPending: If the next retry isn't due yet
+            Exception: Whatever init() raised on a failed retry
+        """
+        now = self._clock()
+        if now < self._next_at:
+            raise SensorInitPending(
+                f"{name} not initialized ({self.last_error}), "
+                f"retry in {self._next_at - now:.0f}s"
+            )
+        self.attempts += 1
+        try:
+            sensor.init()
+        except Exception as e:
+            self.last_error = e
+            # Release whatever the failed attempt opened before the next one
+            try:
+                sensor.close()
+            except Exception:
+                pass
+            self._delay = min(self._delay * 2, self._max_delay)
+            self._next_at = self._clock() + self._delay
+            raise
+        logger.info(f"{name}: initialized on attempt {self.attempts}")
@@ -21,6 +21,7 @@ from typing import TYPE_CHECKING
 from utils.command_registry import CommandRegistry, CommandScope
 from utils.led import parse_color, scale_brightness
 from utils.params import ParamDef, param_get, param_set, params_list, cmds_list, params_save
+from utils.protocol import encode_log_records, parse_ranges
 from utils.radio_state import RadioState
 
 if TYPE_CHECKING:
@@ -164,6 +165,59 @@ def _handle_reset(_cmd: str, args: list[str]) -> None:
     )
 
 
+def _handle_fetchlog(state: NodeState, _cmd: str, args: list[str]) -> dict:
+    """
+    Handle fetchlog command - stream a time range of the sample log.
+
+    Args:
+        args[0], args[1]: Range start/end, unix seconds; values <= 0 are
+            relative to now (e.g. "-600" "0" = the last ten minutes)
+        args[2]: Max records (optional, capped by sample_log.max_fetch_records)
+
+    Uses early_ack=false: the ACK carries the transfer ID (x), chunk count
+    (m), record count (r) and compressed bytes (b); chunks follow as "log"
+    packets from the LogSender. Returns {"r": 0} if the range is empty.
+    """
+    if len(args) < 2:
+        return {"e": "usage: from to [max_records]"}
+    sender = state.log_sender
+    try:
+        now = time.time()
+        t_from, t_to = (float(a) + now if float(a) <= 0 else float(a) for a in args[:2])
+        limit = min(int(args[2]), sender.max_records) if len(args) >= 3 else sender.max_records
+    except ValueError:
+        return {"e": "bad number"}
+
+    records = state.sample_log.query(t_from, t_to, limit)
+    logger.info(f"[HANDLER] fetchlog: {len(records)} records in [{t_from:.0f}, {t_to:.0f}]")
+    if not records:
+        return {"r": 0}
+    blob = encode_log_records(state.sample_log.names(), records)
+    transfer_id, chunks = sender.start_transfer(blob)
+    return {"b": len(blob), "m": chunks, "r": len(records), "x": transfer_id}
+
+
+def _handle_logresend(state: NodeState, _cmd: str, args: list[str]) -> dict:
+    """
+    Handle logresend command - resend chunks of a recent log transfer.
+
+    Args:
+        args[0]: Transfer ID
+        args[1]: Chunk ranges, e.g. "3-5,9"
+
+    Returns {"r": chunks_queued}, or an error if the transfer has been dropped.
+    """
+    if len(args) < 2:
+        return {"e": "usage: transfer_id ranges"}
+    try:
+        count = state.log_sender.resend(int(args[0]), parse_ranges(args[1]))
+    except ValueError:
+        return {"e": "bad ranges"}
+    if count < 0:
+        return {"e": "unknown transfer"}
+    return {"r": count}
+
+
 def _handle_blink(state: NodeState, _cmd: str, args: list[str]) -> None:
     """
     Handle blink command - sets LED to a color for a duration (non-blocking).
@@ -376,6 +430,18 @@ def commands_init(registry: CommandRegistry, state: NodeState) -> None:
         ),
     ]
 
+    # Current sensor intervals, read-only: ivl0, ivl1, ... in config order.
+    # Adaptive sensors change theirs at runtime.
+    params += [
+        ParamDef(
+            f"ivl{i}",
+            getter=lambda entry=entry: round(entry.interval_sec, 3),
+            value_type=float,
+        )
+        for i, entry in enumerate(state.sensor_entries)
+    ]
+    params.sort(key=lambda p: p.name)
+
     # ─── Sorted Command Name List ────────────────────────────────────────────
     # Built from command table, sorted for getcmds response
     cmd_names = sorted([
@@ -395,6 +461,11 @@ def commands_init(registry: CommandRegistry, state: NodeState) -> None:
         "uptime",
     ])
 
+    # Bulk log retrieval only exists when a sample log is configured
+    log_commands = state.sample_log is not None and state.log_sender is not None
+    if log_commands:
+        cmd_names = sorted(cmd_names + ["fetchlog", "logresend"])
+
     # ─── Command Table ───────────────────────────────────────────────────────
     # Format: (name, handler, scope, early_ack, ack_jitter)
     #
@@ -431,8 +502,23 @@ def commands_init(registry: CommandRegistry, state: NodeState) -> None:
         ("uptime", partial(_handle_uptime, state.start_time), CommandScope.ANY, False, False),
     ]
 
+    if log_commands:
+        commands += [
+            # fetchlog - stream a sample log range; late_ack carries the transfer ID
+            ("fetchlog", partial(_handle_fetchlog, state), CommandScope.PRIVATE, False, False),
+            # logresend - selective retransmit of missing chunks
+            ("logresend", partial(_handle_logresend, state), CommandScope.PRIVATE, False, False),
+        ]
+
+    # Handlers that touch the radio run on the receive thread; the rest run
+    # on the CommandReceiver's handler pool so they can't block RX
+    inline_commands = {"rcfg_radio", "rssi"}
+
     # Register all commands
     for name, handler, scope, early_ack, ack_jitter in commands:
-        registry.register(name, handler, scope, early_ack=early_ack, ack_jitter=ack_jitter)
+        registry.register(
+            name, handler, scope, early_ack=early_ack, ack_jitter=ack_jitter,
+            inline=name in inline_commands,
+        )
 
     logger.info(f"Registered {len(commands)} command handlers")
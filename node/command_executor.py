@@ -0,0 +1,201 @@
+"""
+Command handler execution off the radio receive thread.
+
+CommandReceiver used to run every handler on its own thread, so while
+testled cycled colors or savecfg wrote the config file the node could not
+receive or ACK anything else. CommandExecutor runs handlers on a small
+worker pool instead:
+
+- early_ack handlers: ACK sent immediately, handler queued
+- late-ACK handlers: handler queued, ACK (with payload) sent when it finishes
+
+Handlers registered inline (they touch the radio, e.g. rcfg_radio, rssi)
+still run on the receive thread.
+
+Retries are answered from a small cache of recent ACKs. A retry of a
+late-ACK command that is still running is ignored - the ACK goes out when
+it finishes, and the handler never runs twice.
+
+Classes:
+    CommandExecutor: Dedup, ACK and dispatch of received commands
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from collections import OrderedDict
+from collections.abc import Callable
+from concurrent.futures import Future, ThreadPoolExecutor
+from typing import TYPE_CHECKING
+
+from utils.command_registry import CommandRegistry
+from utils.protocol import CommandPacket, build_ack_packet
+
+if TYPE_CHECKING:
+    from node.metrics import NodeMetrics
+
+logger = logging.getLogger(__name__)
+
+# Recent ACKs kept for retransmissions (the gateway sends one command at a time)
+DEFAULT_ACK_CACHE_SIZE = 8
+
+# Outcomes of CommandExecutor.submit()
+DISPATCHED = "dispatched"
+DUPLICATE = "duplicate"  # Already ACKed, cached ACK resent
+IN_FLIGHT = "in_flight"  # Late-ACK handler still running, retry ignored
+
+
+class CommandExecutor:
+    """
+    Runs command handlers on a worker pool and sends their ACKs.
+
+    send_ack(packet, add_jitter) is called from the receive thread for early
+    ACKs and cache hits, and from a worker thread for late ACKs; it must take
+    the radio lock itself.
+    """
+
+    def __init__(
+        self,
+        registry: CommandRegistry,
+        node_id: str,
+        send_ack: Callable[[bytes, bool], bool],
+        max_workers: int = 2,
+        ack_cache_size: int = DEFAULT_ACK_CACHE_SIZE,
+        metrics: NodeMetrics | None = None,
+    ):
+        """
+        Args:
+            registry: Command registry to dispatch to
+            node_id: This node's ID (for ACK packets)
+            send_ack: Sends an ACK packet, with optional broadcast jitter
+            max_workers: Handler threads (0 = run handlers on the caller's thread)
+            ack_cache_size: Recent ACKs remembered for retransmissions
+            metrics: Records received-to-done latency of each handler
+        """
+        self._registry = registry
+        self._node_id = node_id
+        self._send_ack = send_ack
+        self._ack_cache_size = ack_cache_size
+        self._metrics = metrics
+        self._pool = (
+            ThreadPoolExecutor(max_workers=max_workers, thread_name_prefix="CmdHandler")
+            if max_workers > 0 else None
+        )
+        self._lock = threading.Lock()
+        self._acks: OrderedDict[str, bytes] = OrderedDict()
+        self._in_flight: set[str] = set()
+
+    def submit(self, cmd: CommandPacket, add_jitter: bool = False) -> str:
+        """
+        Handle a command addressed to this node.
+
+        Returns:
+            DISPATCHED, DUPLICATE or IN_FLIGHT
+        """
+        received = time.monotonic()
+        command_id = cmd.get_command_id()
+        handler = self._registry.lookup(cmd.command, cmd.node_id)
+        early_ack = handler is None or handler.early_ack
+
+        with self._lock:
+            cached = self._acks.get(command_id)
+            if cached is None and command_id in self._in_flight:
+                logger.info(
+                    f"Command '{cmd.command}' (id: {command_id}) still running, "
+                    f"retry ignored"
+                )
+                return IN_FLIGHT
+            if cached is None:
+                if early_ack:
+                    cached = build_ack_packet(command_id, self._node_id)
+                    self._cache_ack(command_id, cached)
+                else:
+                    self._in_flight.add(command_id)
+                duplicate = False
+            else:
+                duplicate = True
+
+        if duplicate:
+            logger.info(
+                f"Duplicate command '{cmd.command}' (id: {command_id}), "
+                f"resending cached ACK"
+            )
+            self._send_ack(cached, add_jitter)
+            return DUPLICATE
+
+        if early_ack:
+            if self._send_ack(cached, add_jitter):
+                logger.debug(f"Sent early ACK for '{cmd.command}' (id: {command_id})")
+            else:
+                logger.warning(f"Failed to send early ACK for '{cmd.command}'")
+
+        if self._pool is None or handler is None or handler.inline:
+            response = self._dispatch(cmd, received)
+            self._finish(cmd, command_id, early_ack, add_jitter, response)
+            return DISPATCHED
+
+        future = self._pool.submit(self._dispatch, cmd, received)
+        future.add_done_callback(
+            lambda f: self._finish(cmd, command_id, early_ack, add_jitter, self._result(cmd, f))
+        )
+        return DISPATCHED
+
+    def close(self) -> None:
+        """Stop accepting work; running handlers finish in the background."""
+        if self._pool is not None:
+            self._pool.shutdown(wait=False, cancel_futures=True)
+
+    @property
+    def in_flight_count(self) -> int:
+        with self._lock:
+            return len(self._in_flight)
+
+    # ─── Internals ──────────────────────────────────────────────────────────
+
+    def _dispatch(self, cmd: CommandPacket, received: float) -> dict | None:
+        handled, response = self._registry.dispatch(cmd.command, cmd.args, cmd.node_id)
+        if not handled:
+            logger.debug(f"No handler for command '{cmd.command}'")
+        elif self._metrics is not None:
+            self._metrics.add_handler_latency(time.monotonic() - received)
+        return response
+
+    @staticmethod
+    def _result(cmd: CommandPacket, future: Future) -> dict | None:
+        if future.cancelled():
+            return {"e": "cancelled"}
+        error = future.exception()
+        if error is not None:
+            # dispatch() already catches handler errors; this is a bug guard
+            logger.error(f"Command '{cmd.command}' failed: {error}")
+            return {"e": str(error)}
+        return future.result()
+
+    def _finish(
+        self,
+        cmd: CommandPacket,
+        command_id: str,
+        early_ack: bool,
+        add_jitter: bool,
+        response: dict | None,
+    ) -> None:
+        """Send the late ACK with the handler's response."""
+        if early_ack:
+            return
+        ack_packet = build_ack_packet(command_id, self._node_id, payload=response)
+        with self._lock:
+            self._in_flight.discard(command_id)
+            self._cache_ack(command_id, ack_packet)
+        if self._send_ack(ack_packet, add_jitter):
+            logger.debug(f"Sent ACK+payload for '{cmd.command}' (id: {command_id})")
+        else:
+            logger.warning(f"Failed to send ACK for '{cmd.command}'")
+
+    def _cache_ack(self, command_id: str, ack_packet: bytes) -> None:
+        # Caller holds self._lock
+        self._acks[command_id] = ack_packet
+        self._acks.move_to_end(command_id)
+        while len(self._acks) > self._ack_cache_size:
+            self._acks.popitem(last=False)
@@ -29,13 +29,61 @@ via setparam command and persisted with savecfg.
 Each sensor can have its own "interval_sec". If not specified, falls back
 to the global "default_sensor_interval_sec" (default: 30s).
 
+Due times run on the monotonic clock and stay phase-aligned. With
+"coalesce_tolerance_sec" > 0, sensors due within that many seconds of a
+broadcast are read early and sent with it, so fewer, fuller packets go out.
+
+A sensor with an "aggregate" config ({"sample_interval_sec", "stats",
+"percentiles"}) is sampled in the background and broadcasts only window
+summaries ("Accel X max", ...) on its interval_sec.
+
+A sensor with a "deadband" ({"abs", "rel", "heartbeat_sec"}) only transmits
+readings that moved beyond the band, or when the heartbeat expires.
+
+A sensor with an "adaptive" config ({"min_interval_sec", "max_interval_sec",
+"std", "rate"}) reads faster while its values move or spread, and relaxes
+back when quiet (node.adaptive). Current intervals are the read-only params
+ivl0, ivl1, ... in config order.
+
+With "uplink": {"confirmed": true}, sensor packets carry sequence numbers
+and are kept in an on-disk backlog until the gateway ACKs them; unconfirmed
+packets are backfilled (flagged historical) a few per broadcast once the
+link is back. Needs the command receiver to hear the ACKs.
+
+With "low_power": {"enabled": true}, the radio sleeps between short RX
+windows (periodic, plus one after each broadcast) instead of listening
+continuously. "telemetry": {"interval_sec": ...} adds a NodeTelemetry
+sensor reporting the estimated radio mAh/h and TX/RX/sleep duty, plus
+schedule lateness, radio_lock wait and command handler latency percentiles,
+dropped readings, CPU temperature, load and RSS (node.metrics).
+
+With "sample_log": {"enabled": true}, every sample (each read, and each
+background sample of an aggregated sensor) is kept at full resolution in a
+ring file on disk; the gateway pulls time ranges on demand with the fetchlog
+command (node.sample_log, node.log_transfer).
+
+Sensor init() calls run concurrently ("sensor_init_workers", default: one
+per sensor) and overlap radio init. After the first broadcast the node
+sends its boot-to-first-packet breakdown once (node.boot); the gateway keeps
+it per node.
+
+Due sensors are read concurrently ("sensor_read_workers", default: one per
+sensor). Each read has a deadline, "read_timeout_sec" (default: 5s); a
+sensor that misses it is skipped for that broadcast. Set
+"sensor_read_workers" to 0 to read sequentially.
+
+With "lora": {"simulated": {...}} and Simulated* sensor classes, the node
+runs without hardware (radio.simulated, sensors.simulated); the process
+lock is then per node_id, so scripts/sim_fleet.py can run a fleet.
+
 Usage:
     python3 -m node.data_log [config_file]
     python3 node/data_log.py [config_file]
 """
 
+from __future__ import annotations
+
 import argparse
-import inspect
 import json
 import logging
 import random
@@ -43,19 +91,47 @@ import signal
 import sys
 import threading
 import time
-from dataclasses import dataclass
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 
 import sensors as sensors_module
-from radio import RFM9xRadio
+from radio import RFM9xRadio, SimulatedRadio
 from sensors import Sensor
 from node.command import commands_init
+from node.command_executor import CommandExecutor
+from node.adaptive import AdaptiveConfig, AdaptiveInterval
+from node.aggregation import AggregatingSensor
+from node.boot import (
+    INIT_RETRY_FIRST_SEC,
+    PHASE_RADIO_INIT,
+    PHASE_SENSOR_INIT,
+    BootTimer,
+    InitRetry,
+    SensorInitPending,
+    init_concurrently,
+)
+from node.deadband import DeadbandConfig, DeadbandFilter
+from node.duty_cycle import DutyCycle
+from node.log_transfer import LogSender
+from node.metrics import MeteredLock, NodeMetrics
+from node.sample_log import SampleLog
+from node.scheduler import SensorScheduler
+from node.telemetry import NodeTelemetry
+from node.uplink_backlog import UplinkBacklog
+from node.sensor_reader import (
+    DEFAULT_READ_TIMEOUT_SEC,
+    ReadResult,
+    SensorEntry,
+    SensorReadPool,
+    read_entry,
+)
 from utils.command_registry import CommandRegistry
+from utils.energy import STATE_RX, STATE_SLEEP, STATE_STANDBY, EnergyMeter, EnergyModel
+from utils.i2c_bus import bus_stats, get_bus
 from utils.protocol import (
-    SensorReading,
-    build_ack_packet,
     build_lora_packets,
     parse_command_packet,
+    parse_sack_packet,
 )
 from utils.node_state import NodeState
 from utils.radio_state import RadioState
@@ -87,20 +163,36 @@ logger = logging.getLogger(__name__)
 sensor_logger = logging.getLogger("sensor_debug")
 
 
-@dataclass
-class SensorEntry:
-    """A sensor instance with its broadcast configuration."""
-
-    sensor: Sensor
-    interval_sec: float
-    last_broadcast: float = 0.0
-
-    @property
-    def class_name(self) -> str:
-        """Get the sensor's class name."""
-        return type(self.sensor).__name__
+def _account_tx(energy: EnergyMeter | None, radio: RFM9xRadio, packet: bytes) -> None:
+    """Add a sent packet's airtime to the energy meter (radio idles after TX)."""
+    if energy is None:
+        return
+    energy.add_tx(
+        len(packet), radio.spreading_factor, radio.signal_bandwidth, radio.tx_power
+    )
+    energy.set_state(STATE_STANDBY)
 
 
+def _send_uplink(
+    radio: RFM9xRadio,
+    packet: bytes,
+    radio_lock: threading.Lock | None,
+    node_state: NodeState | None,
+    energy: EnergyMeter | None,
+) -> bool:
+    """Send one packet to the gateway, on N2G when sharing the radio."""
+    # Acquire lock if using half-duplex coordination
+    if radio_lock:
+        with radio_lock:
+            # Set N2G frequency before sending (CommandReceiver leaves radio on G2N)
+            if node_state:
+                radio.set_frequency(node_state.n2g_freq)
+            success = radio.send(packet)
+            _account_tx(energy, radio, packet)
+            return success
+    success = radio.send(packet)
+    _account_tx(energy, radio, packet)
+    return success
 
 
 # =============================================================================
@@ -114,7 +206,8 @@ class CommandReceiver(threading.Thread):
 
     Runs continuously, acquiring radio_lock for short receive windows.
     This ensures commands are received promptly even while the main
-    broadcast loop is sleeping between broadcasts.
+    broadcast loop is sleeping between broadcasts. Handlers run on a small
+    pool (CommandExecutor), so a slow handler doesn't hold up RX or ACKs.
 
     Reads frequencies dynamically from RadioState to see updates from rcfg_radio.
     """
@@ -128,6 +221,11 @@ class CommandReceiver(threading.Thread):
         receive_timeout: float = 0.5,
         radio_state: RadioState | None = None,
         broadcast_ack_jitter_sec: float = 0.5,
+        uplink_backlog: UplinkBacklog | None = None,
+        handler_workers: int = 2,
+        duty_cycle: DutyCycle | None = None,
+        energy: EnergyMeter | None = None,
+        metrics: NodeMetrics | None = None,
     ):
         """
         Initialize the command receiver.
@@ -140,6 +238,11 @@ class CommandReceiver(threading.Thread):
             receive_timeout: Timeout for each receive attempt (default 0.5s)
             radio_state: RadioState for dynamic frequency reading (sees rcfg_radio updates)
             broadcast_ack_jitter_sec: Max random delay before ACKing broadcast commands
+            uplink_backlog: Confirmed-uplink backlog to update from sensor ACKs
+            handler_workers: Threads running command handlers (0 = on this thread)
+            duty_cycle: Low-power RX window schedule (None = listen continuously)
+            energy: Meter for radio state and airtime accounting
+            metrics: Self-telemetry collector for handler latency
         """
         super().__init__(daemon=True, name="CommandReceiver")
         self._radio = radio
@@ -149,10 +252,17 @@ class CommandReceiver(threading.Thread):
         self._receive_timeout = receive_timeout
         self._radio_state = radio_state
         self._broadcast_ack_jitter_sec = broadcast_ack_jitter_sec
+        self._uplink_backlog = uplink_backlog
+        self._duty_cycle = duty_cycle
+        self._energy = energy
+        if duty_cycle is not None:
+            duty_cycle.has_listener = True
         self._running = False
-        # Single-slot dedup (matches AB01 pattern)
-        self._last_command_id: str = ""
-        self._last_ack_packet: bytes | None = None
+        # Handler pool plus recent-ACK cache and in-flight dedup
+        self._executor = CommandExecutor(
+            registry, node_id, self._send_ack, max_workers=handler_workers,
+            metrics=metrics,
+        )
 
     def _get_n2g_freq(self) -> float:
         """Get current N2G frequency (from RadioState if available)."""
@@ -176,10 +286,20 @@ class CommandReceiver(threading.Thread):
 
         while self._running:
             try:
+                timeout = self._receive_timeout
+                if self._duty_cycle is not None:
+                    # Low power: radio asleep and thread blocked between windows
+                    wait = self._duty_cycle.time_until_rx()
+                    if wait > 0:
+                        self._sleep_radio()
+                        self._duty_cycle.wait(wait)
+                        continue
+                    timeout = min(timeout, self._duty_cycle.rx_remaining())
+
                 # Use interruptible receive with fine-grained internal locking
                 # This allows broadcast_loop to transmit during 100ms sleep intervals
                 # while maintaining long effective RX windows (4+ seconds)
-                packet = self._receive_interruptible(self._receive_timeout)
+                packet = self._receive_interruptible(timeout)
 
                 if packet is not None:
                     self._process_packet(packet)
@@ -191,6 +311,27 @@ class CommandReceiver(threading.Thread):
     def stop(self) -> None:
         """Signal the thread to stop."""
         self._running = False
+        self._executor.close()
+        if self._duty_cycle is not None:
+            self._duty_cycle.wake()
+
+    def _sleep_radio(self) -> None:
+        """Put the radio to sleep until the next RX window or transmit."""
+        with self._radio_lock:
+            self._radio.sleep()
+            if self._energy is not None:
+                self._energy.set_state(STATE_SLEEP)
+
+    def _process_sack(self, packet: bytes) -> None:
+        """Apply a gateway sensor ACK to the uplink backlog."""
+        sack = parse_sack_packet(packet)
+        if sack is None or sack[0] != self._node_id:
+            return
+        confirmed = self._uplink_backlog.ack(sack[1])
+        logger.debug(
+            f"Sensor ACK {sack[1]}: {confirmed} confirmed, "
+            f"{self._uplink_backlog.pending_count} pending"
+        )
 
     def _send_ack(self, ack_packet: bytes, add_jitter: bool = False) -> bool:
         """Send an ACK packet, optionally applying jitter to stagger responses.
@@ -219,6 +360,7 @@ class CommandReceiver(threading.Thread):
             # Set N2G frequency, send ACK, then switch back to G2N (matches AB01)
             self._radio.set_frequency(n2g_freq)
             success = self._radio.send(ack_packet)
+            _account_tx(self._energy, self._radio, ack_packet)
             self._radio.set_frequency(g2n_freq)  # Resume on G2N for next receive
             logger.info(f"ACK sent on N2G={n2g_freq} MHz, success={success}")
             return success
@@ -252,6 +394,8 @@ class CommandReceiver(threading.Thread):
                 # (broadcast_loop may have changed frequency, or rcfg_radio applied)
                 self._radio.set_frequency(self._get_g2n_freq())
                 self._radio.listen()
+                if self._energy is not None:
+                    self._energy.set_state(STATE_RX)
 
                 # Check for packet
                 if self._radio.rx_done():
@@ -268,18 +412,21 @@ class CommandReceiver(threading.Thread):
         return None  # Shutdown requested
 
     def _process_packet(self, packet: bytes) -> None:
-        """Parse and dispatch a received command packet, send ACK.
+        """Parse a received packet and hand commands to the executor.
 
         Follows the AB01 earlyAck pattern:
-        - early_ack=True: Send ACK before dispatching handler
-        - early_ack=False: Dispatch handler first, send ACK after with response payload
+        - early_ack=True: ACK sent before the handler runs
+        - early_ack=False: Handler runs first, ACK sent after with response payload
 
-        Dedup: If the same command_id is received again (retransmission),
-        resend the cached ACK but skip handler re-execution (matches AB01).
+        Handlers run on the executor's pool, so this returns to RX at once.
+        Retransmissions get the cached ACK; a retry of a command that is
+        still running is ignored and never starts it twice.
         """
         cmd = parse_command_packet(packet)
         if cmd is None:
-            # Not a valid command packet (might be a sensor packet from another node)
+            if self._uplink_backlog is not None:
+                self._process_sack(packet)
+            # Otherwise not for us (might be a sensor packet from another node)
             return
 
         # Check if command is for this node
@@ -287,59 +434,13 @@ class CommandReceiver(threading.Thread):
             return  # Not for us (targeted to another node)
 
         target = cmd.node_id if cmd.node_id else "broadcast"
-        command_id = cmd.get_command_id()
-        is_duplicate = command_id == self._last_command_id
-
-        # Look up handler to check early_ack flag
-        handler = self._registry.lookup(cmd.command, cmd.node_id)
-        use_early_ack = handler is None or handler.early_ack
         # Add jitter for ALL broadcast responses to prevent ACK collisions
-        is_broadcast = cmd.node_id == ""
-        add_jitter = is_broadcast and self._broadcast_ack_jitter_sec > 0
+        add_jitter = cmd.is_broadcast() and self._broadcast_ack_jitter_sec > 0
 
-        if is_duplicate:
-            logger.info(
-                f"Duplicate command '{cmd.command}' for {target} "
-                f"(id: {command_id}), resending cached ACK"
-            )
-            if self._last_ack_packet is not None:
-                self._send_ack(self._last_ack_packet, add_jitter)
-            return
-
-        logger.info(f"Received command '{cmd.command}' for {target} (id: {command_id})")
-
-        # For early_ack handlers, send ACK before dispatch
-        if use_early_ack:
-            ack_packet = build_ack_packet(command_id, self._node_id)
-            self._last_command_id = command_id
-            self._last_ack_packet = ack_packet
-            success = self._send_ack(ack_packet, add_jitter)
-            if success:
-                logger.debug(f"Sent early ACK for '{cmd.command}' (id: {command_id})")
-            else:
-                logger.warning(f"Failed to send early ACK for '{cmd.command}'")
-
-        # Dispatch to handlers
-        handled, response = self._registry.dispatch(
-            cmd.command, cmd.args, cmd.node_id
+        logger.info(
+            f"Received command '{cmd.command}' for {target} (id: {cmd.get_command_id()})"
         )
-        if not handled:
-            logger.debug(f"No handler for command '{cmd.command}'")
-
-        # For late-ack handlers, send ACK after dispatch with response payload
-        if not use_early_ack:
-            ack_packet = build_ack_packet(
-                command_id, self._node_id, payload=response
-            )
-            self._last_command_id = command_id
-            self._last_ack_packet = ack_packet
-            success = self._send_ack(ack_packet, add_jitter)
-            if success:
-                logger.debug(
-                    f"Sent ACK+payload for '{cmd.command}' (id: {command_id})"
-                )
-            else:
-                logger.warning(f"Failed to send ACK for '{cmd.command}'")
+        self._executor.submit(cmd, add_jitter)
 
 
 def load_config(config_path: str) -> dict:
@@ -354,7 +455,7 @@ def load_config(config_path: str) -> dict:
 
 def get_sensor_class(class_name: str) -> type[Sensor] | None:
     """
-    Get a Sensor class by name using reflection.
+    Get a Sensor class by name, importing its driver on first use.
 
     Args:
         class_name: Name of the sensor class (e.g., "BME280TempPressureHumidity")
@@ -362,27 +463,32 @@ def get_sensor_class(class_name: str) -> type[Sensor] | None:
     Returns:
         The sensor class, or None if not found
     """
-    for name, obj in inspect.getmembers(sensors_module, inspect.isclass):
-        if name == class_name and issubclass(obj, Sensor) and obj is not Sensor:
-            return obj
-    return None
+    return sensors_module.load_sensor_class(class_name)
 
 
 def instantiate_sensors(
-    sensor_configs: list[dict], default_interval: float
+    sensor_configs: list[dict],
+    default_interval: float,
+    init_workers: int | None = None,
 ) -> list[SensorEntry]:
     """
     Instantiate sensors from configuration.
 
+    Sensors are constructed in config order, then their init() calls (where
+    the hardware settle delays are) run concurrently.
+
     Args:
         sensor_configs: List of sensor config dicts with 'class', optional 'config',
-                        and optional 'interval_sec'
+                        optional 'interval_sec', 'read_timeout_sec', 'deadband',
+                        'adaptive', 'aggregate' and 'calibration'
         default_interval: Default interval for sensors without explicit interval_sec
+        init_workers: Max concurrent init() calls (default: one per sensor, 0 = sequential)
 
     Returns:
-        List of SensorEntry objects for successfully initialized sensors
+        List of SensorEntry objects in config order. Sensors whose init()
+        failed are included with an init_retry, so their reads retry it.
     """
-    sensors = []
+    constructed = []
 
     for config in sensor_configs:
         class_name = config.get("class")
@@ -398,73 +504,87 @@ def instantiate_sensors(
         try:
             # Get optional constructor arguments
             kwargs = config.get("config", {})
-            sensor = sensor_class(**kwargs)
-            sensor.init()
-
-            # Get per-sensor interval or use default
+            # Validate before touching hardware so a bad config can't leak a sensor
+            deadband = DeadbandConfig.from_config(config.get("deadband"))
             interval = config.get("interval_sec", default_interval)
-
-            entry = SensorEntry(sensor=sensor, interval_sec=interval)
-            sensors.append(entry)
-            logger.info(f"Initialized sensor: {entry.class_name} (interval: {interval}s)")
+            adaptive = AdaptiveConfig.from_config(config.get("adaptive"), interval)
+            sensor = sensor_class(**kwargs)
+            # Compiled once here; read_entry applies it through transform()
+            if calibration := config.get("calibration"):
+                sensor.set_calibration(calibration)
+            # Sample in the background, broadcast window summaries
+            if aggregate := config.get("aggregate"):
+                sensor = AggregatingSensor.from_config(sensor, aggregate)
+
+            if adaptive is not None:
+                adaptive.check_names(sensor.get_names())
+
+            # Adaptive sensors start at interval_sec clamped into their bounds
+            controller = AdaptiveInterval(adaptive, interval) if adaptive else None
+            if controller is not None:
+                interval = controller.interval_sec
+
+            constructed.append(
+                SensorEntry(
+                    sensor=sensor,
+                    interval_sec=interval,
+                    read_timeout_sec=config.get("read_timeout_sec", DEFAULT_READ_TIMEOUT_SEC),
+                    deadband=deadband,
+                    adaptive=controller,
+                )
+            )
         except Exception as e:
             logger.error(f"Failed to initialize {class_name}: {e}")
 
-    return sensors
+    results = init_concurrently([entry.sensor for entry in constructed], init_workers)
+    for entry, result in zip(constructed, results):
+        if result.error is not None:
+            # Kept, and retried from its reads (the device may just not be up yet)
+            logger.error(
+                f"Failed to initialize {entry.class_name}: {result.error}; "
+                f"retrying in {INIT_RETRY_FIRST_SEC:g}s"
+            )
+            entry.sensor.close()
+            entry.init_retry = InitRetry(result.error)
+            continue
+        logger.info(
+            f"Initialized sensor: {entry.class_name} "
+            f"(interval: {entry.interval_sec}s, init {result.elapsed_sec:.2f}s)"
+        )
+
+    return constructed
 
 
-def read_sensors(entries: list[SensorEntry]) -> list[SensorReading]:
+def read_sensors(entries: list[SensorEntry]) -> ReadResult:
     """
-    Read specified sensors and build a list of readings.
+    Read specified sensors one after another and build a list of readings.
+
+    Used when no SensorReadPool is configured; a slow sensor delays the rest.
 
     Args:
         entries: List of SensorEntry objects to read
 
     Returns:
-        List of SensorReading objects with current timestamps
+        ReadResult with current-timestamp readings, overall and per sensor
     """
-    readings = []
+    result = ReadResult()
     timestamp = time.time()
-    debug = sensor_logger.isEnabledFor(logging.DEBUG)
 
     for entry in entries:
         try:
-            raw_values = entry.sensor.read()
-            values = entry.sensor.transform(raw_values)
-            names = entry.sensor.get_names()
-            units = entry.sensor.get_units()
-            precision = entry.sensor.get_precision()
-
-            if debug:
-                for raw, val, name, unit in zip(
-                    raw_values, values, names, units
-                ):
-                    if raw != val:
-                        sensor_logger.debug(
-                            "%-20s %.*f %s  →  %.*f",
-                            name, precision, raw, unit, precision, val,
-                        )
-                    else:
-                        sensor_logger.debug(
-                            "%-20s %.*f %s",
-                            name, precision, val, unit,
-                        )
-
-            for value, name, unit in zip(values, names, units):
-                readings.append(
-                    SensorReading(
-                        name=name,
-                        units=unit,
-                        value=value,
-                        sensor_class=entry.class_name,
-                        timestamp=timestamp,
-                        precision=precision,
-                    )
-                )
+            readings = read_entry(entry, timestamp)
+        except SensorInitPending as e:
+            logger.debug(str(e))
+            result.failed.append(entry)
+            continue
         except Exception as e:
             logger.error(f"Error reading {entry.class_name}: {e}")
+            result.failed.append(entry)
+            continue
+        result.readings.extend(readings)
+        result.by_entry.append((entry, readings))
 
-    return readings
+    return result
 
 
 def broadcast_loop(
@@ -473,12 +593,23 @@ def broadcast_loop(
     sensors: list[SensorEntry],
     node_state: NodeState | None = None,
     radio_lock: threading.Lock | None = None,
+    read_pool: SensorReadPool | None = None,
+    coalesce_tolerance_sec: float = 0.0,
+    stats_log_interval_sec: float = 3600.0,
+    backlog: UplinkBacklog | None = None,
+    duty_cycle: DutyCycle | None = None,
+    energy: EnergyMeter | None = None,
+    boot: BootTimer | None = None,
+    sample_log: SampleLog | None = None,
+    metrics: NodeMetrics | None = None,
 ) -> None:
     """
     Main broadcast loop with per-sensor intervals.
 
     Continuously reads sensors and broadcasts via LoRa based on each
-    sensor's configured interval.
+    sensor's configured interval. Due times come from a SensorScheduler on
+    the monotonic clock; sensors due within coalesce_tolerance_sec of a
+    broadcast are pulled into it to share packets.
 
     Args:
         radio: Initialized radio instance
@@ -486,29 +617,83 @@ def broadcast_loop(
         sensors: List of SensorEntry objects with interval configuration
         node_state: Optional shared state for display updates
         radio_lock: Optional lock for half-duplex coordination with CommandReceiver
+        read_pool: Optional pool for concurrent reads with per-sensor deadlines
+        coalesce_tolerance_sec: Max seconds a sensor may be read early to share a broadcast
+        stats_log_interval_sec: How often to log schedule lateness/jitter
+        backlog: Optional confirmed-uplink backlog (sequenced packets + backfill)
+        duty_cycle: Low-power schedule; each broadcast opens an RX window, or
+            puts the radio to sleep if no receiver follows the schedule
+        energy: Meter for radio state and airtime accounting
+        boot: Start-up timer; its breakdown is sent once after the first broadcast
+        sample_log: Full-resolution log; every reading is appended before filtering
+        metrics: Self-telemetry collector for schedule lateness and dropped readings
     """
     logger.info(f"Starting broadcast loop for node '{node_id}'")
     logger.info(f"Radio: {radio.frequency_mhz} MHz, TX power: {radio.tx_power} dBm")
 
     for entry in sensors:
-        logger.info(f"  {entry.class_name}: every {entry.interval_sec}s")
+        mode = (
+            f", deadband (heartbeat {entry.deadband.heartbeat_sec}s)"
+            if entry.deadband else ""
+        )
+        if entry.adaptive is not None:
+            bounds = entry.adaptive.config
+            mode += (
+                f", adaptive {bounds.min_interval_sec}-{bounds.max_interval_sec}s"
+            )
+        logger.info(f"  {entry.class_name}: every {entry.interval_sec}s{mode}")
+
+    scheduler = SensorScheduler(sensors, coalesce_tolerance_sec, metrics=metrics)
+    # Deadband state is per entry (position in the list), not per sensor class
+    entry_keys = {id(entry): index for index, entry in enumerate(sensors)}
+    deadband = DeadbandFilter(
+        {entry_keys[id(e)]: e.deadband for e in sensors if e.deadband is not None}
+    )
+    if coalesce_tolerance_sec > 0:
+        logger.info(f"  coalescing sensors due within {coalesce_tolerance_sec}s")
+    next_stats_log = time.monotonic() + stats_log_interval_sec
+
+    def send_packet(packet: bytes) -> bool:
+        return _send_uplink(radio, packet, radio_lock, node_state, energy)
+
+    def after_transmit() -> None:
+        if duty_cycle is None:
+            return
+        if duty_cycle.has_listener:
+            duty_cycle.open_window()
+            return
+        # Nobody listens: sleep straight away
+        if radio_lock:
+            with radio_lock:
+                radio.sleep()
+        else:
+            radio.sleep()
+        if energy is not None:
+            energy.set_state(STATE_SLEEP)
 
     broadcast_count = 0
 
     while not _shutdown_requested:
         now = time.time()
 
-        # Find sensors that are due for broadcast
-        due_sensors = [
-            entry
-            for entry in sensors
-            if (now - entry.last_broadcast) >= entry.interval_sec
-        ]
+        # Sensors due now (plus near-due ones pulled in), already rescheduled
+        due_sensors = scheduler.pop_due()
 
         if due_sensors:
             try:
-                # Read only sensors that are due
-                readings = read_sensors(due_sensors)
+                # Read only sensors that are due. With a pool, a sensor that
+                # misses its deadline is left out of this broadcast and
+                # retried at its next interval.
+                if read_pool is not None:
+                    result = read_pool.read(due_sensors)
+                else:
+                    result = read_sensors(due_sensors)
+                readings = result.readings
+                if metrics is not None:
+                    metrics.add_dropped(sum(
+                        len(entry.sensor.get_names())
+                        for entry in result.timed_out + result.busy + result.failed
+                    ))
 
                 # Update node state with latest readings for display
                 if node_state and readings:
@@ -519,27 +704,64 @@ def broadcast_loop(
                         ]
                     )
 
+                # Adaptive sensors pick their next interval from their own readings
+                for entry, entry_readings in result.by_entry:
+                    if entry.adaptive is None:
+                        continue
+                    interval = entry.adaptive.update(entry_readings)
+                    if interval != entry.interval_sec:
+                        logger.info(
+                            f"{entry.class_name}: interval "
+                            f"{entry.interval_sec:g}s -> {interval:g}s"
+                        )
+                        scheduler.set_interval(entry, interval)
+
+                # Full resolution on disk, whatever the uplink drops
+                if sample_log is not None and readings:
+                    sample_log.append_readings(readings)
+
+                # Report-by-exception: drop readings still inside their deadband
+                unsent = 0
+                transmitted = False
+                if deadband and readings:
+                    sent = [
+                        reading
+                        for entry, entry_readings in result.by_entry
+                        for reading in deadband.filter(entry_keys[id(entry)], entry_readings)
+                    ]
+                    unsent = len(readings) - len(sent)
+                    readings = sent
+
                 if readings:
                     # Build compact packets (auto-splits if too large)
-                    packets = build_lora_packets(node_id, readings)
+                    if backlog is not None:
+                        # Stored before sending so a failed send is backfilled
+                        seq = backlog.next_seq
+                        packets = build_lora_packets(node_id, readings, seq=seq)
+                        backlog.record(seq, packets)
+                    else:
+                        packets = build_lora_packets(node_id, readings)
 
                     broadcast_count += 1
                     all_success = True
                     total_bytes = 0
 
                     for packet in packets:
-                        # Acquire lock if using half-duplex coordination
-                        if radio_lock:
-                            with radio_lock:
-                                # Set N2G frequency before sending (CommandReceiver leaves radio on G2N)
-                                if node_state:
-                                    radio.set_frequency(node_state.n2g_freq)
-                                success = radio.send(packet)
-                        else:
-                            success = radio.send(packet)
+                        success = send_packet(packet)
                         total_bytes += len(packet)
                         if not success:
                             all_success = False
+                    transmitted = True
+                    # A backlog resends failed packets; without one they're lost
+                    if metrics is not None and not all_success and backlog is None:
+                        metrics.add_dropped(len(readings))
+
+                    # One-shot boot-to-first-packet report
+                    if boot is not None and all_success:
+                        boot.mark_first_packet()
+                        for packet in build_lora_packets(node_id, boot.readings()):
+                            send_packet(packet)
+                        boot = None
 
                     # Update last broadcast time for sensors we just read
                     for entry in due_sensors:
@@ -560,27 +782,39 @@ def broadcast_loop(
                         logger.warning(
                             f"Broadcast #{broadcast_count} failed [{sensor_names}]"
                         )
+                elif unsent:
+                    logger.debug(f"{unsent} readings inside deadband, nothing sent")
                 else:
                     logger.warning("No sensor readings available")
 
+                # Low-priority backfill after the live packets, a few at a time
+                if backlog is not None:
+                    backfill = backlog.take_backfill()
+                    for packet in backfill:
+                        send_packet(packet)
+                    if backfill:
+                        transmitted = True
+                        logger.info(
+                            f"Backfilled {len(backfill)} packet(s), "
+                            f"{backlog.pending_count} unconfirmed"
+                        )
+
+                if transmitted:
+                    after_transmit()
+
             except Exception as e:
                 logger.error(f"Broadcast error: {e}")
 
-        # Calculate sleep time until next sensor is due
-        sleep_times = []
-        for entry in sensors:
-            time_since_last = now - entry.last_broadcast
-            time_until_next = entry.interval_sec - time_since_last
-            sleep_times.append(max(0.1, time_until_next))
+        if time.monotonic() >= next_stats_log:
+            scheduler.log_stats()
+            next_stats_log = time.monotonic() + stats_log_interval_sec
 
-        sleep_time = min(sleep_times) if sleep_times else 1.0
-        time.sleep(sleep_time)
+        # Sleep until the next sensor is due
+        time.sleep(scheduler.time_until_next())
 
 
 def main():
-    from utils.process_lock import acquire_lock
-
-    acquire_lock("node")
+    boot = BootTimer()
 
     # Register signal handlers for graceful shutdown
     signal.signal(signal.SIGTERM, _signal_handler)
@@ -628,6 +862,13 @@ def main():
         logger.error("Config missing 'node_id'")
         sys.exit(1)
 
+    # One node per machine owns the radio; simulated nodes lock per node_id
+    # so a fleet can run side by side
+    from utils.process_lock import acquire_lock
+
+    simulated = config.get("lora", {}).get("simulated")
+    acquire_lock(f"node_sim_{node_id}" if simulated else "node")
+
     # Get default broadcast interval
     default_interval = config.get("default_sensor_interval_sec", 30)
 
@@ -637,11 +878,30 @@ def main():
         logger.error("Config has no sensors defined")
         sys.exit(1)
 
-    sensors = instantiate_sensors(sensor_configs, default_interval)
-    if not sensors:
-        logger.error("No sensors could be initialized")
-        sys.exit(1)
+    # Sensors initialize in the background while the radio is set up
+    def init_sensors() -> list[SensorEntry]:
+        with boot.phase(PHASE_SENSOR_INIT):
+            return instantiate_sensors(
+                sensor_configs, default_interval, config.get("sensor_init_workers")
+            )
 
+    boot_executor = ThreadPoolExecutor(max_workers=1, thread_name_prefix="boot")
+    sensors_future = boot_executor.submit(init_sensors)
+    boot_executor.shutdown(wait=False)
+
+    # Low-power RX duty cycling and radio energy accounting
+    low_power_config = config.get("low_power", {})
+    telemetry_config = config.get("telemetry", {})
+    duty_cycle = (
+        DutyCycle.from_config(low_power_config)
+        if low_power_config.get("enabled", False) else None
+    )
+    energy = (
+        EnergyMeter(EnergyModel.from_config(telemetry_config.get("energy")))
+        if duty_cycle is not None or telemetry_config else None
+    )
+    # Loop/lock/handler timing for the telemetry sensor
+    metrics = NodeMetrics() if telemetry_config else None
     # Initialize radio with dual-channel support
     lora_config = config.get("lora", {})
 
@@ -661,16 +921,54 @@ def main():
     bandwidth_code = lora_config.get("bandwidth", 0)
     bandwidth_hz = BW_HZ_MAP.get(bandwidth_code, 125000)
 
-    radio = RFM9xRadio(
-        frequency_mhz=n2g_freq,  # Start on N2G (sensor broadcasts + ACKs)
-        tx_power=tx_power,
-        cs_pin=LORA_CS_PIN,
-        reset_pin=LORA_RESET_PIN,
-    )
+    if simulated:
+        # No hardware: airtime and losses only (radio.simulated)
+        radio = SimulatedRadio(
+            frequency_mhz=n2g_freq,
+            tx_power=tx_power,
+            **(simulated if isinstance(simulated, dict) else {}),
+        )
+    else:
+        radio = RFM9xRadio(
+            frequency_mhz=n2g_freq,  # Start on N2G (sensor broadcasts + ACKs)
+            tx_power=tx_power,
+            cs_pin=LORA_CS_PIN,
+            reset_pin=LORA_RESET_PIN,
+        )
     # Apply SF/BW from config (radio.init() will use these)
     radio.spreading_factor = spreading_factor
     radio.signal_bandwidth = bandwidth_hz
 
+    try:
+        with boot.phase(PHASE_RADIO_INIT):
+            radio.init()
+        logger.info("Radio initialized")
+    except Exception:
+        for entry in sensors_future.result():
+            entry.sensor.close()
+        radio.close()
+        raise
+
+    sensors = sensors_future.result()
+    if not sensors:
+        logger.error("No sensors could be created")
+        radio.close()
+        sys.exit(1)
+
+    if telemetry_config:
+        telemetry = NodeTelemetry(energy, metrics)
+        telemetry.init()
+        sensors.append(
+            SensorEntry(
+                sensor=telemetry,
+                interval_sec=telemetry_config.get("interval_sec", 300),
+            )
+        )
+        logger.info(
+            f"Initialized sensor: NodeTelemetry "
+            f"(interval: {telemetry_config.get('interval_sec', 300)}s)"
+        )
+
     # Create RadioState (encapsulates radio hardware and frequencies)
     radio_state = RadioState(
         radio=radio,
@@ -683,8 +981,24 @@ def main():
         node_id=node_id,
         radio_state=radio_state,
         config_path=args.config,
+        sensor_entries=sensors,
     )
 
+    # Concurrent sensor reads with per-sensor deadlines
+    read_workers = config.get("sensor_read_workers", len(sensors))
+    read_pool = (
+        SensorReadPool(max_workers=read_workers, node_state=node_state)
+        if read_workers > 0 else None
+    )
+
+    # Warm camera for the OCR page (opened on first capture, released when idle)
+    camera_session = None
+    arducam_config = config.get("arducam", {})
+    if arducam_config.get("enabled", False) and arducam_config.get("warm", False):
+        from sensors.camera_session import CameraSession
+
+        camera_session = CameraSession.from_config(arducam_config)
+
     # Initialize display if configured
     screen_manager = None
     display_advance_button = None
@@ -707,15 +1021,16 @@ def main():
                 SensorValuesPage,
             )
 
+            # Same bus handle and lock as the I2C sensors
             display = SSD1306Display(
-                i2c_port=display_config.get("i2c_port", 1),
                 i2c_address=display_config.get("i2c_address", 0x3C),
+                bus=get_bus(display_config.get("i2c_port", 1)),
             )
             pages = [
                 OffPage(),
                 SensorValuesPage(node_state, auto_scroll=display_config.get("auto_scroll", False)),
                 NodeInfoPage(node_state),
-                ArducamOCRPage(node_state),
+                ArducamOCRPage(node_state, session=camera_session),
             ]
             screen_manager = ScreenManager(
                 display=display,
@@ -762,12 +1077,21 @@ def main():
         except Exception as e:
             logger.warning(f"Failed to initialize LED: {e}")
 
-    # Create command registry and register handlers
-    command_registry = CommandRegistry(node_id)
-    commands_init(command_registry, node_state)
+    # Full-resolution sample log, fetched on demand over LoRa
+    sample_log: SampleLog | None = None
+    log_sender: LogSender | None = None
+    sample_log_config = config.get("sample_log", {})
+    if sample_log_config.get("enabled", False):
+        sample_log = SampleLog.from_config(sample_log_config)
+        for entry in sensors:
+            inner = getattr(entry.sensor, "inner", entry.sensor)
+            sample_log.register(entry.class_name, inner.get_names(), inner.get_units())
+            if isinstance(entry.sensor, AggregatingSensor):
+                entry.sensor.sample_log = sample_log
+        node_state.sample_log = sample_log
 
     # Create radio lock for half-duplex coordination
-    radio_lock: threading.Lock | None = None
+    radio_lock: threading.Lock | MeteredLock | None = None
     command_receiver: CommandReceiver | None = None
 
     # Check if command receiver is enabled
@@ -775,11 +1099,45 @@ def main():
     command_receiver_enabled = command_config.get("enabled", False)
 
     if command_receiver_enabled:
-        radio_lock = threading.Lock()
+        # Metered when telemetry is on, so lock contention shows up remotely
+        radio_lock = MeteredLock(metrics) if metrics is not None else threading.Lock()
+
+    if sample_log is not None:
+        if command_receiver_enabled:
+            log_sender = LogSender(
+                node_id,
+                lambda packet: _send_uplink(radio, packet, radio_lock, node_state, energy),
+                chunk_gap_sec=sample_log_config.get("chunk_gap_sec", 0.1),
+                max_records=sample_log_config.get("max_fetch_records", 5000),
+            )
+            node_state.log_sender = log_sender
+        else:
+            logger.warning("Sample log needs command_receiver for fetchlog; logging only")
+
+    # Create command registry and register handlers
+    command_registry = CommandRegistry(node_id)
+    commands_init(command_registry, node_state)
+
+    # Confirmed uplink: sequenced packets, on-disk backlog, backfill
+    backlog: UplinkBacklog | None = None
+    uplink_config = config.get("uplink", {})
+    if uplink_config.get("confirmed", False):
+        if not command_receiver_enabled:
+            logger.warning(
+                "Confirmed uplink needs command_receiver to hear gateway ACKs; "
+                "packets will be sequenced but never confirmed"
+            )
+        backlog = UplinkBacklog(
+            uplink_config.get("backlog_path", "data/uplink_backlog.bin"),
+            slots=uplink_config.get("backlog_slots", 512),
+            ack_timeout_sec=uplink_config.get("ack_timeout_sec", 30.0),
+            link_timeout_sec=uplink_config.get("link_timeout_sec", 300.0),
+            max_per_broadcast=uplink_config.get("backfill_per_broadcast", 2),
+        )
 
     try:
-        radio.init()
-        logger.info("Radio initialized")
+        if log_sender is not None:
+            log_sender.start()
 
         # Start command receiver if enabled
         if command_receiver_enabled and radio_lock is not None:
@@ -793,12 +1151,31 @@ def main():
                 receive_timeout=receive_timeout,
                 radio_state=radio_state,
                 broadcast_ack_jitter_sec=jitter_ms / 1000.0,
+                uplink_backlog=backlog,
+                handler_workers=command_config.get("handler_workers", 2),
+                duty_cycle=duty_cycle,
+                energy=energy,
+                metrics=metrics,
             )
             command_receiver.start()
             logger.info("Command receiver enabled")
 
         # Start broadcast loop
-        broadcast_loop(radio, node_id, sensors, node_state, radio_lock)
+        broadcast_loop(
+            radio,
+            node_id,
+            sensors,
+            node_state,
+            radio_lock,
+            read_pool,
+            coalesce_tolerance_sec=config.get("coalesce_tolerance_sec", 0.0),
+            backlog=backlog,
+            duty_cycle=duty_cycle,
+            energy=energy,
+            boot=boot,
+            sample_log=sample_log,
+            metrics=metrics,
+        )
 
     except KeyboardInterrupt:
         logger.info("Shutting down...")
@@ -812,10 +1189,29 @@ def main():
             display_advance_button.close()
         if action_button:
             action_button.close()
+        if camera_session:
+            camera_session.close()
         if led:
             led.close()
+        if read_pool:
+            read_pool.close()
+        if backlog:
+            backlog.close()
+        if log_sender:
+            log_sender.stop()
+        for bus in bus_stats():
+            logger.info(
+                f"I2C bus {bus.bus}: {bus.transactions} transactions, "
+                f"{bus.errors} errors, lock wait max {bus.lock_wait_max_sec * 1000:.1f}ms"
+                + "".join(
+                    f", 0x{addr:02X} {dev.busy_sec:.2f}s/{dev.transactions}"
+                    for addr, dev in sorted(bus.devices.items())
+                )
+            )
         for entry in sensors:
             entry.sensor.close()
+        if sample_log:
+            sample_log.close()
         radio.close()
         logger.info("Cleanup complete")
 
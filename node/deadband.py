@@ -0,0 +1,125 @@
+"""
+Report-by-exception (deadband) filtering for node broadcasts.
+
+A sensor with a "deadband" config only transmits a reading when it moves
+beyond the band since the last *transmitted* value, or when its heartbeat
+expires. Slow-moving series (soil moisture, indoor temperature) then cost
+one packet per heartbeat instead of one per interval.
+
+The band is the larger of the absolute and relative limits, so a relative
+band doesn't collapse to nothing near zero. Comparing against the last sent
+value (not the last read) means slow drift is still reported once it adds
+up to the band.
+
+Transmitted readings carry heartbeat_sec, so the gateway can tell a quiet
+series ("unchanged") from a dead one ("missing").
+
+Config (per sensor):
+    "deadband": {"abs": 0.05, "rel": 0.01, "heartbeat_sec": 900}
+
+Classes:
+    DeadbandConfig: Band limits and heartbeat for one sensor
+    DeadbandFilter: Per-series last-sent state for all deadband sensors
+"""
+
+from __future__ import annotations
+
+import logging
+import time
+from collections.abc import Hashable
+from dataclasses import dataclass, replace
+
+from utils.protocol import SensorReading
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class DeadbandConfig:
+    """Deadband limits for one sensor. Either limit may be None (unused)."""
+
+    abs: float | None = None
+    rel: float | None = None  # Fraction of the last sent value
+    heartbeat_sec: float = 900.0
+
+    def __post_init__(self):
+        if self.abs is None and self.rel is None:
+            raise ValueError("deadband needs at least one of abs/rel")
+        if (self.abs or 0) < 0 or (self.rel or 0) < 0:
+            raise ValueError("deadband limits must be >= 0")
+        if self.heartbeat_sec <= 0:
+            raise ValueError("heartbeat_sec must be positive")
+
+    @classmethod
+    def from_config(cls, config: dict | None) -> DeadbandConfig | None:
+        """Build from a sensor's "deadband" config dict (None if absent)."""
+        if not config:
+            return None
+        return cls(
+            abs=config.get("abs"),
+            rel=config.get("rel"),
+            heartbeat_sec=config.get("heartbeat_sec", 900.0),
+        )
+
+    def exceeded(self, value: float, last: float) -> bool:
+        band = max(self.abs or 0.0, (self.rel or 0.0) * abs(last))
+        return abs(value - last) > band
+
+
+class DeadbandFilter:
+    """
+    Drops readings that stayed inside their sensor's deadband.
+
+    Configs and state are per sensor entry (the node passes its position in
+    the sensor list), so two sensors of one class, e.g. two ADS1115s at
+    different addresses, keep their own bands and reference values. Entries
+    without a config pass through untouched.
+    """
+
+    def __init__(self, configs: dict[Hashable, DeadbandConfig], clock=time.monotonic):
+        """
+        Args:
+            configs: Deadband config by sensor entry key
+            clock: Monotonic time source (injectable for tests)
+        """
+        self._configs = configs
+        self._clock = clock
+        # (entry key, reading name) -> (last sent value, monotonic send time)
+        self._last_sent: dict[tuple[Hashable, str], tuple[float | None, float]] = {}
+        self.suppressed = 0
+
+    def __bool__(self) -> bool:
+        return bool(self._configs)
+
+    def filter(self, entry_key: Hashable, readings: list[SensorReading]) -> list[SensorReading]:
+        """
+        Return the readings of one sensor entry that should be transmitted.
+
+        Deadband readings that pass are copies tagged with heartbeat_sec;
+        their value becomes the new reference for the band.
+        """
+        config = self._configs.get(entry_key)
+        if config is None:
+            return list(readings)
+
+        now = self._clock()
+        result = []
+        for reading in readings:
+            key = (entry_key, reading.name)
+            last = self._last_sent.get(key)
+            value = reading.value
+            if last is not None:
+                last_value, sent_at = last
+                expired = now - sent_at >= config.heartbeat_sec
+                if value is None or last_value is None:
+                    changed = value is not last_value
+                else:
+                    changed = config.exceeded(value, last_value)
+                if not (changed or expired):
+                    self.suppressed += 1
+                    continue
+
+            self._last_sent[key] = (value, now)
+            result.append(replace(reading, heartbeat_sec=config.heartbeat_sec))
+
+        return result
@@ -10,7 +10,6 @@ Provides ScreenPage implementations specific to sensor nodes:
 import logging
 import threading
 import time
-from pathlib import Path
 
 from display.base import ScreenPage, _format_duration, _get_ip_address
 from utils.node_state import NodeState
@@ -78,10 +77,12 @@ class ArducamOCRPage(ScreenPage):
 
     Shows last OCR result or "No result found".
     The do_action() method triggers capture+OCR when the action button is pressed.
+    With a warm camera session the capture skips the camera start-up.
     """
 
-    def __init__(self, state: NodeState):
+    def __init__(self, state: NodeState, session=None):
         self._state = state
+        self._session = session
         # Import at construction time to avoid delay on first button press
         from sensors.arducam import CropMode, capture_and_ocr
         self._capture_and_ocr = capture_and_ocr
@@ -124,9 +125,9 @@ class ArducamOCRPage(ScreenPage):
         def _do_capture():
             try:
                 result = self._capture_and_ocr(
-                    output_dir=Path.home() / "Pictures",
                     crop_mode=self._crop_mode.NONE,
-                    preprocess=False
+                    preprocess=False,
+                    session=self._session,
                 )
                 self._state.set_ocr_result(result if result else "No result found")
             except Exception as e:
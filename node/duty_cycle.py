@@ -0,0 +1,120 @@
+"""
+RX duty cycling for low-power nodes.
+
+Normally the command receiver keeps the radio listening and polls it every
+100 ms, which is fine on mains but drains a battery. In low-power mode the
+radio only listens during short windows:
+
+- a periodic window of rx_window_sec every rx_period_sec, phase-aligned to
+  start-up, so queued gateway commands (which retry for tens of seconds)
+  are still heard
+- a window of post_tx_window_sec after every broadcast, for sensor ACKs
+  and commands the gateway sends right after hearing the node
+
+Between windows the radio sleeps and the receiver thread blocks on an
+event instead of polling; open_window() (called after a transmit) wakes it.
+
+Config:
+    "low_power": {"enabled": true, "rx_window_sec": 2, "rx_period_sec": 30,
+                  "post_tx_window_sec": 2}
+
+Classes:
+    DutyCycle: RX window schedule on the monotonic clock
+"""
+
+from __future__ import annotations
+
+import logging
+import math
+import threading
+import time
+
+logger = logging.getLogger(__name__)
+
+
+class DutyCycle:
+    """
+    When the radio should listen, on the monotonic clock.
+
+    Thread-safe: the broadcast loop opens windows, the receiver waits on them.
+    """
+
+    def __init__(
+        self,
+        rx_window_sec: float = 2.0,
+        rx_period_sec: float = 30.0,
+        post_tx_window_sec: float = 2.0,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            rx_window_sec: Length of each periodic listen window
+            rx_period_sec: Time between periodic window starts (0 = no periodic windows)
+            post_tx_window_sec: Listen window opened after each transmit
+            clock: Monotonic time source (injectable for tests)
+        """
+        if rx_period_sec and rx_window_sec > rx_period_sec:
+            raise ValueError("rx_window_sec must not exceed rx_period_sec")
+        self._window = rx_window_sec
+        self._period = rx_period_sec
+        self._post_tx = post_tx_window_sec
+        self._clock = clock
+        self._epoch = clock()
+        self._lock = threading.Lock()
+        self._extra_until = -math.inf  # End of the latest post-TX window
+        self._wake = threading.Event()
+        self.has_listener = False  # Set by the receiver that follows this schedule
+
+    @classmethod
+    def from_config(cls, config: dict) -> DutyCycle:
+        """Build from the node's "low_power" config dict."""
+        return cls(
+            rx_window_sec=config.get("rx_window_sec", 2.0),
+            rx_period_sec=config.get("rx_period_sec", 30.0),
+            post_tx_window_sec=config.get("post_tx_window_sec", 2.0),
+        )
+
+    def _periodic_window(self, now: float) -> tuple[float, float]:
+        """(start, end) of the periodic window containing now, or the next one."""
+        if not self._period:
+            return math.inf, math.inf
+        k = math.floor((now - self._epoch) / self._period)
+        start = self._epoch + k * self._period
+        if now >= start + self._window:
+            start += self._period
+        return start, start + self._window
+
+    def rx_remaining(self, now: float | None = None) -> float:
+        """Seconds left in the current listen window (0 if not in one)."""
+        now = self._clock() if now is None else now
+        start, end = self._periodic_window(now)
+        periodic = end - now if start <= now else 0.0
+        with self._lock:
+            extra = self._extra_until - now
+        return max(0.0, periodic, extra)
+
+    def time_until_rx(self, now: float | None = None) -> float:
+        """Seconds until the radio should listen (0 if it should now)."""
+        now = self._clock() if now is None else now
+        if self.rx_remaining(now) > 0:
+            return 0.0
+        start, _ = self._periodic_window(now)
+        return start - now
+
+    def open_window(self, now: float | None = None) -> None:
+        """Open a post-transmit listen window and wake a sleeping receiver."""
+        if self._post_tx <= 0:
+            return
+        now = self._clock() if now is None else now
+        with self._lock:
+            self._extra_until = max(self._extra_until, now + self._post_tx)
+        self._wake.set()
+
+    def wait(self, timeout: float) -> None:
+        """Block until timeout or open_window()/wake() (no polling)."""
+        if self._wake.wait(timeout if timeout != math.inf else None):
+            self._wake.clear()
+
+    def wake(self) -> None:
+        """Wake a waiting receiver (e.g. for shutdown)."""
+        self._wake.set()
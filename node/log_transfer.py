@@ -0,0 +1,156 @@
+"""
+Bulk sample-log retrieval over LoRa.
+
+The gateway asks for a time range with the fetchlog command; the handler
+queries the SampleLog, compresses the records (utils.protocol
+encode_log_records) and hands the blob to LogSender, which streams it as
+numbered "log" chunk packets on N2G. The late ACK tells the gateway the
+transfer ID and chunk count. Once chunks stop arriving the gateway asks for
+just the missing ones with logresend, so a lost packet costs one chunk, not
+the whole transfer.
+
+Chunks are paced (chunk_gap_sec) and the radio lock is released between
+them, so commands and sensor broadcasts still get through during a long
+transfer. The last few transfers stay in memory for resends.
+
+Commands (registered by node.command when a sample log is configured):
+    fetchlog <from> <to> [max_records]  from/to: unix time, or <= 0 for
+                                        seconds relative to now (-600 0)
+    logresend <transfer_id> <ranges>    ranges: "3-5,9"
+
+Config:
+    "sample_log": {..., "max_fetch_records": 5000, "chunk_gap_sec": 0.1}
+
+Classes:
+    LogSender: Background thread streaming log transfers
+"""
+
+from __future__ import annotations
+
+import logging
+import random
+import threading
+import time
+from collections import OrderedDict, deque
+from typing import Callable
+
+from utils.protocol import build_log_chunk_packets
+
+logger = logging.getLogger(__name__)
+
+
+class LogSender(threading.Thread):
+    """
+    Streams queued log chunks to the gateway.
+
+    start_transfer() and resend() are called from command handlers; the
+    thread sends one chunk at a time through send_packet.
+    """
+
+    def __init__(
+        self,
+        node_id: str,
+        send_packet: Callable[[bytes], bool],
+        chunk_gap_sec: float = 0.1,
+        start_delay_sec: float = 1.0,
+        keep_transfers: int = 2,
+        max_records: int = 5000,
+    ):
+        """
+        Args:
+            node_id: This node's ID
+            send_packet: Sends one packet on N2G (takes the radio lock)
+            chunk_gap_sec: Pause between chunks, radio lock released
+            start_delay_sec: Wait before a new transfer so the fetchlog ACK goes first
+            keep_transfers: Finished transfers kept for resends
+            max_records: Cap on records per fetchlog
+        """
+        super().__init__(daemon=True, name="LogSender")
+        self._node_id = node_id
+        self._send_packet = send_packet
+        self._gap = chunk_gap_sec
+        self._start_delay = start_delay_sec
+        self._keep = keep_transfers
+        self.max_records = max_records
+        self._lock = threading.Lock()
+        self._wake = threading.Event()
+        self._running = True
+        self._transfers: OrderedDict[int, list[bytes]] = OrderedDict()
+        self._queue: deque[tuple[float, int, int]] = deque()  # (not_before, transfer, chunk)
+        # Random start so IDs from before a restart aren't reused at once
+        self._next_id = random.randrange(256)
+        self.chunks_sent = 0
+
+    def start_transfer(self, blob: bytes) -> tuple[int, int]:
+        """
+        Queue a new transfer.
+
+        Returns:
+            (transfer ID, chunk count)
+        """
+        with self._lock:
+            transfer_id = self._next_id
+            self._next_id = (self._next_id + 1) % 256
+            packets = build_log_chunk_packets(self._node_id, transfer_id, blob)
+            self._transfers[transfer_id] = packets
+            self._transfers.move_to_end(transfer_id)
+            while len(self._transfers) > self._keep:
+                old_id, _ = self._transfers.popitem(last=False)
+                self._queue = deque(q for q in self._queue if q[1] != old_id)
+            not_before = time.monotonic() + self._start_delay
+            self._queue.extend((not_before, transfer_id, i) for i in range(len(packets)))
+        self._wake.set()
+        logger.info(
+            f"Log transfer {transfer_id}: {len(blob)} bytes in {len(packets)} chunks"
+        )
+        return transfer_id, len(packets)
+
+    def resend(self, transfer_id: int, ranges: list[tuple[int, int]]) -> int:
+        """
+        Queue chunks again (gateway selective retransmit).
+
+        Returns:
+            Chunks queued, or -1 if the transfer is no longer held
+        """
+        with self._lock:
+            packets = self._transfers.get(transfer_id)
+            if packets is None:
+                return -1
+            queued = {(q[1], q[2]) for q in self._queue}
+            count = 0
+            for start, end in ranges:
+                for i in range(max(0, start), min(end, len(packets) - 1) + 1):
+                    if (transfer_id, i) not in queued:
+                        self._queue.append((0.0, transfer_id, i))
+                        count += 1
+        self._wake.set()
+        logger.info(f"Log transfer {transfer_id}: resending {count} chunks")
+        return count
+
+    @property
+    def queued_count(self) -> int:
+        with self._lock:
+            return len(self._queue)
+
+    def run(self) -> None:
+        while self._running:
+            with self._lock:
+                item = self._queue[0] if self._queue else None
+                wait = None if item is None else item[0] - time.monotonic()
+                if item is not None and wait <= 0:
+                    self._queue.popleft()
+                    packet = self._transfers[item[1]][item[2]]
+            if item is None or wait > 0:
+                self._wake.wait(wait)
+                self._wake.clear()
+                continue
+            try:
+                if self._send_packet(packet):
+                    self.chunks_sent += 1
+            except Exception as e:
+                logger.error(f"Log chunk send error: {e}")
+            time.sleep(self._gap)
+
+    def stop(self) -> None:
+        self._running = False
+        self._wake.set()
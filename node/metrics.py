@@ -0,0 +1,129 @@
+"""
+Node-side performance counters for self-telemetry.
+
+Things like ACK lock waits and schedule lateness used to go only to the
+node's local log. NodeMetrics collects them from the broadcast loop, the
+command receiver and the handler pool; NodeTelemetry takes a window every
+interval and sends percentiles through the normal uplink.
+
+Samples are kept per window in bounded deques (the most recent
+MAX_SAMPLES), so a long window costs fixed memory and the percentiles
+describe its recent part.
+
+Classes:
+    MetricsWindow: Percentiles and counters for one telemetry window
+    NodeMetrics: Thread-safe sample collector
+    MeteredLock: Lock that records how long each acquire waited
+
+Functions:
+    percentile: Nearest-rank percentile of a sample list
+"""
+
+from __future__ import annotations
+
+import math
+import threading
+import time
+from collections import deque
+from dataclasses import dataclass
+
+# Samples kept per series per window
+MAX_SAMPLES = 4096
+
+
+def percentile(samples: list[float], pct: float) -> float | None:
+    """Nearest-rank percentile (None for no samples)."""
+    if not samples:
+        return None
+    ordered = sorted(samples)
+    rank = max(1, math.ceil(pct / 100.0 * len(ordered)))
+    return ordered[rank - 1]
+
+
+@dataclass
+class MetricsWindow:
+    """Samples taken since the previous window (seconds)."""
+
+    lateness: list[float]
+    lock_wait: list[float]
+    handler_latency: list[float]
+    dropped_readings: int
+
+
+class NodeMetrics:
+    """Collects timing samples and drop counts from node threads."""
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._lateness: deque[float] = deque(maxlen=MAX_SAMPLES)
+        self._lock_wait: deque[float] = deque(maxlen=MAX_SAMPLES)
+        self._handler: deque[float] = deque(maxlen=MAX_SAMPLES)
+        self._dropped = 0
+
+    def add_lateness(self, seconds: float) -> None:
+        """Sensor fired this long after its scheduled time (negative = early)."""
+        with self._lock:
+            self._lateness.append(seconds)
+
+    def add_lock_wait(self, seconds: float) -> None:
+        with self._lock:
+            self._lock_wait.append(seconds)
+
+    def add_handler_latency(self, seconds: float) -> None:
+        """Command received to handler finished (includes pool queueing)."""
+        with self._lock:
+            self._handler.append(seconds)
+
+    def add_dropped(self, count: int) -> None:
+        """Readings that never left the node (failed reads/sends)."""
+        if count <= 0:
+            return
+        with self._lock:
+            self._dropped += count
+
+    def take_window(self) -> MetricsWindow:
+        """Return samples since the last call and start a new window."""
+        with self._lock:
+            window = MetricsWindow(
+                list(self._lateness),
+                list(self._lock_wait),
+                list(self._handler),
+                self._dropped,
+            )
+            self._lateness.clear()
+            self._lock_wait.clear()
+            self._handler.clear()
+            self._dropped = 0
+        return window
+
+
+class MeteredLock:
+    """
+    threading.Lock that reports each acquire's wait to NodeMetrics.
+
+    Drop-in for the radio lock: supports "with" and acquire()/release().
+    """
+
+    def __init__(self, metrics: NodeMetrics, clock=time.monotonic):
+        self._lock = threading.Lock()
+        self._metrics = metrics
+        self._clock = clock
+
+    def acquire(self, blocking: bool = True, timeout: float = -1) -> bool:
+        t0 = self._clock()
+        acquired = self._lock.acquire(blocking, timeout)
+        if acquired:
+            self._metrics.add_lock_wait(self._clock() - t0)
+        return acquired
+
+    def release(self) -> None:
+        self._lock.release()
+
+    def locked(self) -> bool:
+        return self._lock.locked()
+
+    def __enter__(self) -> bool:
+        return self.acquire()
+
+    def __exit__(self, *exc) -> None:
+        self.release()
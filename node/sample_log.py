@@ -0,0 +1,345 @@
+"""
+Full-resolution sample log on the node.
+
+The uplink only carries what fits the airtime budget (window summaries,
+deadband-filtered readings). SampleLog keeps every sample — each sensor read
+and every background sample of an aggregated sensor — in a fixed-size ring
+file, so an event can be pulled in detail later with the fetchlog command
+(see node.log_transfer) without running the whole fleet at high uplink rates.
+
+File layout (fixed-size records, slot = record number % slots):
+    header:  magic "DLSL", version u16, record_size u16, slots u32,
+             head hint u32 (next record number at the last flush), reserved u32
+    record:  number u32, timestamp f64, value f32, sensor class ID u8,
+             reading index u8, pad u16, crc32 u32 (over the preceding bytes)
+
+Appends are buffered and written in batches (flush_records or flush_sec,
+whichever first) to spare the SD card; a crash loses at most the unflushed
+batch. On open the head is found from the hint by scanning forward over
+records whose number and CRC check out, so a torn write is simply the end of
+the log.
+
+Reading names are stored once per sensor class in a JSON sidecar
+("<path>.names"), append-only, so reading indexes stay valid across
+restarts.
+
+Config:
+    "sample_log": {"enabled": true, "path": "data/sample_log.bin",
+                   "size_mb": 16, "flush_sec": 10}
+
+Classes:
+    SampleLog: Crash-safe ring of timestamped samples
+"""
+
+from __future__ import annotations
+
+import json
+import logging
+import os
+import struct
+import threading
+import time
+import zlib
+from pathlib import Path
+
+from sensors import get_sensor_class_id
+from utils.protocol import SensorReading
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b"DLSL"
+VERSION = 1
+HEADER = struct.Struct("<4sHHIII")
+RECORD = struct.Struct("<IdfBBxxI")
+CRC_SPAN = RECORD.size - 4
+
+NUMBER_MASK = 0xFFFFFFFF
+
+# Records read per pread when streaming a query
+READ_BLOCK = 1024
+
+# Timestamps are only roughly append-ordered (the broadcast loop stamps
+# readings at cycle start while aggregation samplers stamp as they append),
+# so a query's binary search aims this far before t_from
+QUERY_SLACK_SEC = 600.0
+
+
+class SampleLog:
+    """
+    Fixed-size on-disk ring of (timestamp, sensor, reading, value) samples.
+
+    Thread-safe: the broadcast loop, aggregation samplers and the fetchlog
+    handler may call it concurrently.
+    """
+
+    def __init__(
+        self,
+        path: str | Path,
+        slots: int = 700_000,
+        flush_records: int = 256,
+        flush_sec: float = 10.0,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            path: Log file (created if missing)
+            slots: Ring capacity in records (24 bytes each)
+            flush_records: Write once this many records are buffered
+            flush_sec: Write buffered records at least this often
+            clock: Monotonic time source (injectable for tests)
+        """
+        self._path = Path(path)
+        self._names_path = self._path.with_name(self._path.name + ".names")
+        self._slots = slots
+        self._flush_records = flush_records
+        self._flush_sec = flush_sec
+        self._clock = clock
+        self._lock = threading.Lock()
+        self._buffer: list[bytes] = []
+        self._last_flush = clock()
+        self.next_number = 0
+        self.written = 0
+
+        # Sensor class -> reading names/units, index = position
+        self._names: dict[str, list[list[str]]] = {}
+        self._index: dict[tuple[str, str], tuple[int, int]] = {}
+        self._load_names()
+
+        self._path.parent.mkdir(parents=True, exist_ok=True)
+        self._fd = os.open(self._path, os.O_RDWR | os.O_CREAT, 0o644)
+        if not self._load():
+            self._create()
+
+    @classmethod
+    def from_config(cls, config: dict) -> SampleLog:
+        """Build from the node's "sample_log" config dict."""
+        size_bytes = int(config.get("size_mb", 16) * 1024 * 1024)
+        return cls(
+            config.get("path", "data/sample_log.bin"),
+            slots=max(1, (size_bytes - HEADER.size) // RECORD.size),
+            flush_records=config.get("flush_records", 256),
+            flush_sec=config.get("flush_sec", 10.0),
+        )
+
+    # ─── File Handling ──────────────────────────────────────────────────────
+
+    def _offset(self, number: int) -> int:
+        return HEADER.size + (number % self._slots) * RECORD.size
+
+    def _create(self) -> None:
+        os.ftruncate(self._fd, 0)
+        self._write_header(0)
+        os.ftruncate(self._fd, HEADER.size + self._slots * RECORD.size)
+        logger.info(f"Created sample log {self._path} ({self._slots} records)")
+
+    def _write_header(self, head: int) -> None:
+        header = HEADER.pack(MAGIC, VERSION, RECORD.size, self._slots, head, 0)
+        os.pwrite(self._fd, header, 0)
+
+    def _load(self) -> bool:
+        """Find the head of an existing file. False if absent/incompatible."""
+        raw = os.pread(self._fd, HEADER.size, 0)
+        if len(raw) < HEADER.size:
+            return False
+        magic, version, record_size, slots, hint, _ = HEADER.unpack(raw)
+        if (magic, version, record_size, slots) != (MAGIC, VERSION, RECORD.size, self._slots):
+            logger.warning(f"Sample log {self._path} has a different layout, recreating")
+            return False
+
+        # Records written after the last header update extend the log
+        number = hint
+        while self._read(number) is not None:
+            number = (number + 1) & NUMBER_MASK
+        self.next_number = number
+        logger.info(f"Sample log loaded: {self.count} records, next {number}")
+        return True
+
+    def _read(self, number: int) -> tuple[float, int, int, float] | None:
+        """(timestamp, class ID, reading index, value), or None if not valid."""
+        raw = os.pread(self._fd, RECORD.size, self._offset(number))
+        return self._unpack(raw, number)
+
+    @staticmethod
+    def _unpack(raw: bytes, number: int) -> tuple[float, int, int, float] | None:
+        if len(raw) < RECORD.size:
+            return None
+        stored, ts, value, class_id, index, crc = RECORD.unpack(raw)
+        if stored != number or zlib.crc32(raw[:CRC_SPAN]) != crc:
+            return None
+        return ts, class_id, index, value
+
+    def _load_names(self) -> None:
+        try:
+            with open(self._names_path) as f:
+                self._names = json.load(f)
+        except FileNotFoundError:
+            return
+        except (OSError, ValueError) as e:
+            logger.warning(f"Ignoring unreadable {self._names_path}: {e}")
+            return
+        for class_name, entries in self._names.items():
+            class_id = get_sensor_class_id(class_name)
+            if class_id is None:
+                continue
+            for i, (name, _units) in enumerate(entries):
+                self._index[(class_name, name)] = (class_id, i)
+
+    def _save_names(self) -> None:
+        tmp = self._names_path.with_name(self._names_path.name + ".tmp")
+        with open(tmp, "w") as f:
+            json.dump(self._names, f)
+        os.replace(tmp, self._names_path)
+
+    def close(self) -> None:
+        with self._lock:
+            if self._fd >= 0:
+                self._flush()
+                os.close(self._fd)
+                self._fd = -1
+
+    # ─── Writing ────────────────────────────────────────────────────────────
+
+    def register(self, class_name: str, names, units) -> None:
+        """Declare a sensor's readings so they can be logged."""
+        class_id = get_sensor_class_id(class_name)
+        if class_id is None:
+            logger.debug(f"Not logging {class_name}: no sensor class ID")
+            return
+        with self._lock:
+            entries = self._names.setdefault(class_name, [])
+            changed = False
+            for name, unit in zip(names, units):
+                if (class_name, name) in self._index:
+                    continue
+                self._index[(class_name, name)] = (class_id, len(entries))
+                entries.append([name, unit])
+                changed = True
+            if changed:
+                self._save_names()
+
+    def append_values(self, class_name: str, names, values, timestamp: float) -> None:
+        """Log one sample of several readings (None values are skipped)."""
+        with self._lock:
+            for name, value in zip(names, values):
+                key = self._index.get((class_name, name))
+                if key is None or value is None:
+                    continue
+                self._append(timestamp, key[0], key[1], value)
+            self._maybe_flush()
+
+    def append_readings(self, readings: list[SensorReading]) -> None:
+        """Log broadcast-loop readings; unregistered names are ignored."""
+        now = time.time()
+        with self._lock:
+            for r in readings:
+                key = self._index.get((r.sensor_class, r.name))
+                if key is None or r.value is None:
+                    continue
+                self._append(r.timestamp or now, key[0], key[1], r.value)
+            self._maybe_flush()
+
+    def _append(self, ts: float, class_id: int, index: int, value: float) -> None:
+        # Caller holds self._lock
+        number = (self.next_number + len(self._buffer)) & NUMBER_MASK
+        head = struct.pack("<IdfBBxx", number, ts, value, class_id, index)
+        self._buffer.append(head + struct.pack("<I", zlib.crc32(head)))
+
+    def _maybe_flush(self) -> None:
+        if (
+            len(self._buffer) >= self._flush_records
+            or self._clock() - self._last_flush >= self._flush_sec
+        ):
+            self._flush()
+
+    def _flush(self) -> None:
+        """Write buffered records and advance the head hint."""
+        self._last_flush = self._clock()
+        if not self._buffer or self._fd < 0:
+            return
+        number = self.next_number
+        # One pwrite per contiguous run (the ring may wrap mid-batch)
+        i = 0
+        while i < len(self._buffer):
+            run = min(len(self._buffer) - i, self._slots - number % self._slots)
+            os.pwrite(self._fd, b"".join(self._buffer[i:i + run]), self._offset(number))
+            number = (number + run) & NUMBER_MASK
+            i += run
+        self.written += len(self._buffer)
+        self.next_number = number
+        self._buffer.clear()
+        self._write_header(number)
+
+    def flush(self) -> None:
+        with self._lock:
+            self._flush()
+
+    # ─── Reading ────────────────────────────────────────────────────────────
+
+    @property
+    def count(self) -> int:
+        """Records currently held on disk."""
+        return min(self.next_number, self._slots)
+
+    def names(self) -> dict[str, list[list[str]]]:
+        """Class ID (as str) -> [[name, units], ...] for encode_log_records()."""
+        with self._lock:
+            return {
+                str(get_sensor_class_id(class_name)): [list(e) for e in entries]
+                for class_name, entries in self._names.items()
+                if get_sensor_class_id(class_name) is not None
+            }
+
+    def query(
+        self, t_from: float, t_to: float, limit: int | None = None
+    ) -> list[tuple[float, int, int, float]]:
+        """
+        Records with t_from <= timestamp <= t_to, in append order.
+
+        Timestamps are only ordered to within QUERY_SLACK_SEC (mixed
+        stamping), so the binary search aims that far before t_from and the
+        forward scan stops at the first record that far past t_to.
+
+        The lock is held only to flush and snapshot the head; records carry
+        their number and CRC, so the reads need no lock, and a record
+        overwritten by a wrap during the scan just fails its check.
+
+        Args:
+            t_from: Start time (unix seconds)
+            t_to: End time (unix seconds)
+            limit: Max records returned (earliest kept)
+        """
+        with self._lock:
+            self._flush()
+            head = self.next_number
+            oldest = head - self.count
+
+        start = t_from - QUERY_SLACK_SEC
+        stop = t_to + QUERY_SLACK_SEC
+        lo, hi = oldest, head
+        while lo < hi:
+            mid = (lo + hi) // 2
+            record = self._read(mid)
+            if record is None or record[0] < start:
+                lo = mid + 1
+            else:
+                hi = mid
+
+        result = []
+        number = lo
+        while number < head:
+            # Contiguous block, not crossing the end of the file
+            block = min(READ_BLOCK, head - number, self._slots - number % self._slots)
+            raw = os.pread(self._fd, block * RECORD.size, self._offset(number))
+            for i in range(block):
+                record = self._unpack(raw[i * RECORD.size:(i + 1) * RECORD.size], number + i)
+                if record is None:
+                    continue
+                if record[0] > stop:
+                    return result
+                if not t_from <= record[0] <= t_to:
+                    continue
+                result.append(record)
+                if limit is not None and len(result) >= limit:
+                    return result
+            number += block
+        return result
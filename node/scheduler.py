@@ -0,0 +1,194 @@
+"""
+Monotonic sensor scheduler with phase alignment and uplink coalescing.
+
+Each sensor's next due time lives in a min-heap keyed on time.monotonic(),
+so NTP steps can't make sensors fire early, late or in bursts, and finding
+the due set costs O(log n) per fired sensor instead of a scan per wakeup.
+
+Schedules are phase-aligned: every sensor starts from the same epoch and the
+next due time is the previous *scheduled* time plus the interval, never
+"now + interval". Lateness therefore doesn't accumulate, and sensors whose
+intervals divide each other stay in step and land in the same broadcast.
+
+With coalesce_tolerance_sec > 0, sensors due within the tolerance of a
+broadcast are pulled into it so they share packets. A pulled-in sensor is
+read at most `tolerance` early and keeps its phase, so sampling is never
+later or less frequent than configured.
+
+set_interval() changes a sensor's interval between fires (adaptive
+sampling); the pending due time moves to the last scheduled time plus the
+new interval, so a shorter interval takes effect at once.
+
+Classes:
+    ScheduleStats: Lateness statistics for one sensor
+    SensorScheduler: Heap-based scheduler for SensorEntry objects
+"""
+
+from __future__ import annotations
+
+import heapq
+import logging
+import math
+import time
+from dataclasses import dataclass
+from typing import TYPE_CHECKING
+
+from node.sensor_reader import entry_labels
+
+if TYPE_CHECKING:
+    from node.metrics import NodeMetrics
+    from node.sensor_reader import SensorEntry
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass
+class ScheduleStats:
+    """
+    Lateness of one sensor's reads against its schedule.
+
+    Lateness is (fire time - scheduled time); negative when coalesced early.
+    Jitter is the standard deviation of lateness (Welford's method).
+    """
+
+    fires: int = 0
+    coalesced: int = 0  # Fired early to share a broadcast
+    skipped: int = 0  # Whole intervals missed (loop stalled)
+    mean_lateness: float = 0.0
+    max_lateness: float = 0.0
+    _m2: float = 0.0
+
+    def add(self, lateness: float) -> None:
+        self.fires += 1
+        delta = lateness - self.mean_lateness
+        self.mean_lateness += delta / self.fires
+        self._m2 += delta * (lateness - self.mean_lateness)
+        if lateness > self.max_lateness:
+            self.max_lateness = lateness
+
+    @property
+    def jitter(self) -> float:
+        return math.sqrt(self._m2 / self.fires) if self.fires > 1 else 0.0
+
+
+class SensorScheduler:
+    """
+    Min-heap of sensor due times on the monotonic clock.
+
+    Example:
+        scheduler = SensorScheduler(sensors, coalesce_tolerance_sec=2.0)
+        while running:
+            time.sleep(scheduler.time_until_next())
+            due = scheduler.pop_due()
+            ...read and broadcast due...
+    """
+
+    def __init__(
+        self,
+        entries: list[SensorEntry],
+        coalesce_tolerance_sec: float = 0.0,
+        clock=time.monotonic,
+        metrics: NodeMetrics | None = None,
+    ):
+        """
+        Args:
+            entries: Sensors to schedule (all due immediately at start)
+            coalesce_tolerance_sec: Pull in sensors due within this many seconds
+            clock: Monotonic time source (injectable for tests)
+            metrics: Also report each fire's lateness here (self-telemetry)
+        """
+        self._clock = clock
+        self._metrics = metrics
+        self._tolerance = max(0.0, coalesce_tolerance_sec)
+        epoch = clock()
+        # (due, index, entry): index breaks ties in config order
+        self._heap: list[tuple[float, int, SensorEntry]] = [
+            (epoch, i, entry) for i, entry in enumerate(entries)
+        ]
+        heapq.heapify(self._heap)
+        self._stats = {i: ScheduleStats() for i in range(len(entries))}
+        self._entries = list(entries)
+
+    @property
+    def coalesce_tolerance_sec(self) -> float:
+        return self._tolerance
+
+    def time_until_next(self) -> float:
+        """Seconds until the next sensor is due (0 if already due)."""
+        if not self._heap:
+            return 1.0
+        return max(0.0, self._heap[0][0] - self._clock())
+
+    def pop_due(self, now: float | None = None) -> list[SensorEntry]:
+        """
+        Take every sensor that is due, plus any due within the tolerance.
+
+        Sensors returned are rescheduled immediately (phase-aligned), so the
+        caller only reads and broadcasts them. Returned in config order.
+        """
+        now = self._clock() if now is None else now
+        heap = self._heap
+        if not heap or heap[0][0] > now:
+            return []
+
+        horizon = now + self._tolerance
+        fired: list[tuple[int, SensorEntry]] = []
+        # Pushed back after the loop, so a sensor whose interval is within the
+        # tolerance isn't taken twice in one call
+        rescheduled: list[tuple[float, int, SensorEntry]] = []
+        while heap and heap[0][0] <= horizon:
+            due, index, entry = heapq.heappop(heap)
+            stats = self._stats[index]
+            stats.add(now - due)
+            if self._metrics is not None:
+                self._metrics.add_lateness(now - due)
+            if due > now:
+                stats.coalesced += 1
+
+            interval = entry.interval_sec
+            next_due = due + interval
+            if next_due <= now:
+                # Stalled past whole intervals: skip them rather than burst
+                missed = math.floor((now - next_due) / interval) + 1
+                stats.skipped += missed
+                next_due += missed * interval
+            rescheduled.append((next_due, index, entry))
+            fired.append((index, entry))
+        for item in rescheduled:
+            heapq.heappush(heap, item)
+
+        fired.sort(key=lambda item: item[0])
+        return [entry for _, entry in fired]
+
+    def set_interval(self, entry: SensorEntry, interval_sec: float) -> None:
+        """
+        Change a sensor's interval and move its pending due time.
+
+        The new due time is the last scheduled time plus the new interval,
+        but never in the past.
+        """
+        old = entry.interval_sec
+        entry.interval_sec = interval_sec
+        for pos, (due, index, queued) in enumerate(self._heap):
+            if queued is entry:
+                next_due = max(due - old + interval_sec, self._clock())
+                self._heap[pos] = (next_due, index, entry)
+                heapq.heapify(self._heap)
+                return
+
+    def stats(self) -> dict[str, ScheduleStats]:
+        """Per-sensor schedule stats keyed by class name (index suffix on duplicates)."""
+        return {
+            label: self._stats[index]
+            for index, label in enumerate(entry_labels(self._entries))
+        }
+
+    def log_stats(self) -> None:
+        """Log lateness/jitter per sensor."""
+        for name, s in self.stats().items():
+            logger.info(
+                f"Schedule {name}: {s.fires} fires, lateness mean "
+                f"{s.mean_lateness * 1000:.1f}ms max {s.max_lateness * 1000:.1f}ms, "
+                f"jitter {s.jitter * 1000:.1f}ms, {s.coalesced} coalesced, "
+                f"{s.skipped} skipped"
+            )
@@ -0,0 +1,259 @@
+"""
+Concurrent sensor reads with per-sensor deadlines.
+
+Sensors due in the same broadcast cycle are read in parallel on a small
+worker pool. Each sensor has its own deadline (read_timeout_sec); a sensor
+that misses it is skipped for that cycle and its readings are left out of
+the broadcast, so one hung I2C transaction can't delay the others.
+
+Python can't cancel a running read, so a timed-out read keeps its worker
+until the driver returns. The sensor is marked in-flight meanwhile and is
+not submitted again, so a stuck sensor holds at most one worker; with the
+default pool size (one worker per sensor) it can never starve the rest.
+
+Classes:
+    SensorEntry: A sensor with its broadcast configuration
+    ReadResult: Outcome of one read cycle
+    SensorReadPool: Worker pool that reads due sensors concurrently
+
+Functions:
+    read_entry: Read one sensor and build SensorReadings
+    entry_labels: Per-entry names for stats, unique among duplicate classes
+"""
+
+from __future__ import annotations
+
+import logging
+import time
+from concurrent.futures import Future, ThreadPoolExecutor
+from concurrent.futures import TimeoutError as FutureTimeoutError
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING
+
+from node.boot import SensorInitPending
+from sensors import Sensor
+from utils.protocol import SensorReading
+
+if TYPE_CHECKING:
+    from node.boot import InitRetry
+    from node.adaptive import AdaptiveInterval
+    from node.deadband import DeadbandConfig
+    from utils.node_state import NodeState
+
+logger = logging.getLogger(__name__)
+sensor_logger = logging.getLogger("sensor_debug")
+
+DEFAULT_READ_TIMEOUT_SEC = 5.0
+
+
+@dataclass
+class SensorEntry:
+    """A sensor instance with its broadcast configuration."""
+
+    sensor: Sensor
+    interval_sec: float
+    last_broadcast: float = 0.0
+    read_timeout_sec: float = DEFAULT_READ_TIMEOUT_SEC
+    deadband: DeadbandConfig | None = None  # Report-by-exception (None = always send)
+    adaptive: AdaptiveInterval | None = None  # Variance-driven interval (None = fixed)
+    # Read still running after missing its deadline (None when idle)
+    in_flight: Future | None = field(default=None, repr=False)
+    # Start-up init() failed; reads retry it until it succeeds (None = initialized)
+    init_retry: InitRetry | None = field(default=None, repr=False)
+
+    @property
+    def class_name(self) -> str:
+        """Get the sensor's class name (the wrapped sensor's, if aggregating)."""
+        sensor = getattr(self.sensor, "inner", self.sensor)
+        return sensor.class_name if isinstance(sensor, Sensor) else type(sensor).__name__
+
+
+def entry_labels(entries: list[SensorEntry]) -> list[str]:
+    """Class name of each entry, with "#<index>" added to repeats of a class."""
+    labels = []
+    seen = set()
+    for index, entry in enumerate(entries):
+        name = entry.class_name
+        labels.append(f"{name}#{index}" if name in seen else name)
+        seen.add(name)
+    return labels
+
+
+def read_entry(entry: SensorEntry, timestamp: float) -> list[SensorReading]:
+    """
+    Read one sensor and build its readings.
+
+    Raises whatever the driver raises, or SensorInitPending while a failed
+    init() waits for its retry; callers handle errors.
+    """
+    sensor = entry.sensor
+    if entry.init_retry is not None:
+        entry.init_retry.ensure(sensor, entry.class_name)
+        entry.init_retry = None
+    raw_values = sensor.read()
+    values = sensor.transform(raw_values)
+    names = sensor.get_names()
+    units = sensor.get_units()
+    precision = sensor.get_precision()
+
+    if sensor_logger.isEnabledFor(logging.DEBUG):
+        for raw, val, name, unit in zip(raw_values, values, names, units):
+            if val is None:
+                continue
+            if raw != val:
+                sensor_logger.debug(
+                    "%-20s %.*f %s  →  %.*f",
+                    name, precision, raw, unit, precision, val,
+                )
+            else:
+                sensor_logger.debug(
+                    "%-20s %.*f %s",
+                    name, precision, val, unit,
+                )
+
+    return [
+        SensorReading(
+            name=name,
+            units=unit,
+            value=value,
+            sensor_class=entry.class_name,
+            timestamp=timestamp,
+            precision=precision,
+        )
+        for value, name, unit in zip(values, names, units)
+    ]
+
+
+@dataclass
+class ReadResult:
+    """Outcome of one read cycle."""
+
+    readings: list[SensorReading] = field(default_factory=list)
+    # Each sensor read in time, with its own readings (sensor order)
+    by_entry: list[tuple[SensorEntry, list[SensorReading]]] = field(default_factory=list)
+    timed_out: list[SensorEntry] = field(default_factory=list)  # Missed deadline
+    busy: list[SensorEntry] = field(default_factory=list)  # Previous read still hung
+    failed: list[SensorEntry] = field(default_factory=list)  # Driver raised
+
+
+class SensorReadPool:
+    """
+    Reads due sensors concurrently, each against its own deadline.
+
+    Example:
+        pool = SensorReadPool(max_workers=len(sensors), node_state=node_state)
+        result = pool.read(due_sensors)
+        broadcast(result.readings)
+    """
+
+    def __init__(self, max_workers: int = 4, node_state: NodeState | None = None):
+        """
+        Args:
+            max_workers: Worker threads (use at least the sensor count)
+            node_state: Optional state for per-sensor latency/timeout stats
+        """
+        self._executor = ThreadPoolExecutor(
+            max_workers=max(1, max_workers), thread_name_prefix="SensorRead"
+        )
+        self._node_state = node_state
+        # id(entry) -> stats label, rebuilt when node_state.sensor_entries changes
+        self._labels: dict[int, str] = {}
+        self._labelled_count = -1
+
+    def read(self, entries: list[SensorEntry]) -> ReadResult:
+        """
+        Read sensors concurrently and wait for each up to its deadline.
+
+        Readings keep sensor order and share one cycle timestamp.
+        """
+        result = ReadResult()
+        timestamp = time.time()
+        start = time.monotonic()
+
+        submitted: list[tuple[SensorEntry, Future]] = []
+        for entry in entries:
+            if entry.in_flight is not None:
+                if not entry.in_flight.done():
+                    logger.warning(
+                        f"{entry.class_name}: previous read still running, skipping"
+                    )
+                    result.busy.append(entry)
+                    self._record(entry, None, timed_out=True)
+                    continue
+                entry.in_flight = None
+            future = self._executor.submit(self._timed_read, entry, timestamp)
+            submitted.append((entry, future))
+
+        for entry, future in submitted:
+            remaining = start + entry.read_timeout_sec - time.monotonic()
+            try:
+                readings, latency = future.result(timeout=max(0.0, remaining))
+            except FutureTimeoutError:
+                logger.warning(
+                    f"{entry.class_name}: read missed {entry.read_timeout_sec}s "
+                    f"deadline, skipped this cycle"
+                )
+                entry.in_flight = future
+                future.add_done_callback(
+                    lambda f, e=entry: self._late_done(e, f, start)
+                )
+                result.timed_out.append(entry)
+                self._record(entry, None, timed_out=True)
+                continue
+            except SensorInitPending as e:
+                logger.debug(str(e))
+                result.failed.append(entry)
+                continue
+            except Exception as e:
+                logger.error(f"Error reading {entry.class_name}: {e}")
+                result.failed.append(entry)
+                self._record(entry, None, error=True)
+                continue
+
+            result.readings.extend(readings)
+            result.by_entry.append((entry, readings))
+            self._record(entry, latency)
+
+        return result
+
+    def close(self) -> None:
+        """Shut down the pool without waiting for hung reads."""
+        self._executor.shutdown(wait=False, cancel_futures=True)
+
+    @staticmethod
+    def _timed_read(entry: SensorEntry, timestamp: float):
+        t0 = time.monotonic()
+        readings = read_entry(entry, timestamp)
+        return readings, time.monotonic() - t0
+
+    def _late_done(self, entry: SensorEntry, future: Future, start: float) -> None:
+        """A timed-out read finally returned; its readings are discarded."""
+        outcome = "failed" if future.exception() is not None else "returned"
+        logger.info(
+            f"{entry.class_name}: late read {outcome} after "
+            f"{time.monotonic() - start:.1f}s (discarded)"
+        )
+
+    def _record(
+        self,
+        entry: SensorEntry,
+        latency_sec: float | None,
+        timed_out: bool = False,
+        error: bool = False,
+    ) -> None:
+        if self._node_state is not None:
+            self._node_state.record_sensor_read(
+                self._label(entry), latency_sec, timed_out=timed_out, error=error
+            )
+
+    def _label(self, entry: SensorEntry) -> str:
+        """Stats key: two sensors of one class are told apart by config position."""
+        entries = self._node_state.sensor_entries
+        label = self._labels.get(id(entry))
+        if label is None or len(entries) != self._labelled_count:
+            self._labels = {
+                id(known): label for known, label in zip(entries, entry_labels(entries))
+            }
+            self._labelled_count = len(entries)
+            label = self._labels.get(id(entry))
+        return label if label is not None else entry.class_name
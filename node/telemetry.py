@@ -0,0 +1,138 @@
+"""
+Node self-telemetry as an ordinary sensor.
+
+NodeTelemetry reports the node's own health through the normal uplink path
+under its own sensor class ID, so it shows up on the dashboard like any
+other series. It is added by data_log when "telemetry" is configured:
+
+    "telemetry": {"interval_sec": 300}
+
+Readings (each from the window since the previous read):
+    Radio Energy   mAh/h  Estimated radio charge per hour (utils.energy)
+    TX Duty        %      Time on air
+    RX Duty        %      Time listening
+    Sleep Duty     %      Time with the radio asleep
+    Late p95       ms     Sensor schedule lateness in the broadcast loop
+    Late Max       ms
+    Lock Wait p50  ms     radio_lock acquire wait (all threads)
+    Lock Wait p95  ms
+    Lock Wait Max  ms
+    Handler p95    ms     Command received to handler done
+    Dropped        count  Readings lost to failed reads or sends
+    CPU Temp       C      SoC temperature (thermal_zone0)
+    Load 1m               1-minute load average
+    RSS            MB     Resident memory of this process
+
+Timing readings are None for a window without samples (e.g. no commands),
+and host readings are None where the source isn't available.
+
+Classes:
+    NodeTelemetry: Sensor reporting node health readings
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+
+from node.metrics import NodeMetrics, percentile
+from sensors import Sensor
+from utils.energy import STATE_RX, STATE_SLEEP, EnergyMeter
+
+logger = logging.getLogger(__name__)
+
+CPU_TEMP_PATH = "/sys/class/thermal/thermal_zone0/temp"
+
+_ENERGY_NAMES = ("Radio Energy", "TX Duty", "RX Duty", "Sleep Duty")
+_METRIC_NAMES = (
+    "Late p95", "Late Max", "Lock Wait p50", "Lock Wait p95", "Lock Wait Max",
+    "Handler p95", "Dropped",
+)
+_HOST_NAMES = ("CPU Temp", "Load 1m", "RSS")
+
+
+def _ms(seconds: float | None) -> float | None:
+    return None if seconds is None else seconds * 1000.0
+
+
+def read_cpu_temp_c(path: str = CPU_TEMP_PATH) -> float | None:
+    try:
+        with open(path) as f:
+            return int(f.read().strip()) / 1000.0
+    except (OSError, ValueError):
+        return None
+
+
+def read_rss_mb() -> float | None:
+    try:
+        with open("/proc/self/statm") as f:
+            resident_pages = int(f.read().split()[1])
+    except (OSError, ValueError, IndexError):
+        return None
+    return resident_pages * os.sysconf("SC_PAGE_SIZE") / (1024 * 1024)
+
+
+def read_load_1m() -> float | None:
+    try:
+        return os.getloadavg()[0]
+    except OSError:
+        return None
+
+
+class NodeTelemetry(Sensor):
+    """Reports radio energy, loop/lock/handler timing and host resource use."""
+
+    def __init__(self, energy: EnergyMeter | None, metrics: NodeMetrics | None = None):
+        """
+        Args:
+            energy: Meter fed by the broadcast loop and command receiver
+            metrics: Timing/drop samples (None = those readings are omitted)
+        """
+        self._energy = energy
+        self._metrics = metrics
+
+    def init(self) -> None:
+        # Start the first window at init, not construction
+        if self._energy is not None:
+            self._energy.take_window()
+        if self._metrics is not None:
+            self._metrics.take_window()
+
+    def read(self) -> tuple:
+        values: list[float | None] = []
+        if self._energy is not None:
+            report = self._energy.take_window()
+            values += [
+                report.mah_per_hour,
+                report.duty("tx") * 100.0,
+                report.duty(STATE_RX) * 100.0,
+                report.duty(STATE_SLEEP) * 100.0,
+            ]
+        if self._metrics is not None:
+            window = self._metrics.take_window()
+            values += [
+                _ms(percentile(window.lateness, 95)),
+                _ms(max(window.lateness, default=None)),
+                _ms(percentile(window.lock_wait, 50)),
+                _ms(percentile(window.lock_wait, 95)),
+                _ms(max(window.lock_wait, default=None)),
+                _ms(percentile(window.handler_latency, 95)),
+                window.dropped_readings,
+            ]
+        values += [read_cpu_temp_c(), read_load_1m(), read_rss_mb()]
+        return tuple(values)
+
+    def get_names(self) -> tuple[str, ...]:
+        names = _ENERGY_NAMES if self._energy is not None else ()
+        if self._metrics is not None:
+            names += _METRIC_NAMES
+        return names + _HOST_NAMES
+
+    def get_units(self) -> tuple[str, ...]:
+        units = ("mAh/h", "%", "%", "%") if self._energy is not None else ()
+        if self._metrics is not None:
+            units += ("ms", "ms", "ms", "ms", "ms", "ms", "")
+        return units + ("C", "", "MB")
+
+    def get_precision(self) -> int:
+        return 4
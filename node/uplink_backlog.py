@@ -0,0 +1,250 @@
+"""
+Store-and-forward backlog for confirmed uplinks.
+
+In confirmed-uplink mode every sensor packet carries a sequence number and
+is written to a fixed-size on-disk ring before it is sent. The gateway
+confirms received sequence numbers with batched sensor ACKs ("sack"); any
+packet still unconfirmed after ack_timeout_sec is resent later, flagged as
+backfill, so readings survive gateway restarts and channel outages.
+
+Backfill is low priority: it only runs while the link is known to be up
+(a sack arrived within link_timeout_sec), after the live broadcast, and at
+most max_per_broadcast packets at a time, so a returning gateway isn't
+flooded.
+
+A new backlog file starts numbering at a random sequence number, kept in
+the header. The gateway dedups on recently seen numbers per node, so a
+recreated backlog (layout change, wiped data dir) restarting at 0 would
+have its fresh packets ACKed and dropped as duplicates of old ones.
+
+File layout (fixed-size slots, slot = seq % slots):
+    header:  magic "DLUB", version u16, slot_size u16, slots u32, first seq u32
+    slot:    seq u32, state u8, pad u8, length u16, crc32 u32, payload bytes
+
+Only changed slots are written (pwrite, no fsync per packet, to spare the SD
+card); a crash can lose at most what the page cache hadn't flushed. Torn
+slots fail their CRC and are ignored on load.
+
+Classes:
+    UplinkBacklog: On-disk ring of sent-but-unconfirmed sensor packets
+"""
+
+from __future__ import annotations
+
+import logging
+import os
+import struct
+import threading
+import time
+import zlib
+from pathlib import Path
+
+from utils.protocol import LORA_MAX_PAYLOAD, mark_backfill
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b"DLUB"
+VERSION = 1
+HEADER = struct.Struct("<4sHHII")
+SLOT_HEADER = struct.Struct("<IBxHI")
+SLOT_SIZE = SLOT_HEADER.size + LORA_MAX_PAYLOAD + 8  # Room for the backfill mark
+
+STATE_EMPTY = 0
+STATE_PENDING = 1
+STATE_ACKED = 2
+
+SEQ_MASK = 0xFFFFFFFF
+
+
+class UplinkBacklog:
+    """
+    Bounded on-disk ring of sent-but-unconfirmed sensor packets.
+
+    Thread-safe: record()/take_backfill() run on the broadcast loop, ack()
+    on the command receiver thread.
+    """
+
+    def __init__(
+        self,
+        path: str | Path,
+        slots: int = 512,
+        ack_timeout_sec: float = 30.0,
+        link_timeout_sec: float = 300.0,
+        max_per_broadcast: int = 2,
+        clock=time.monotonic,
+        first_seq: int | None = None,
+    ):
+        """
+        Args:
+            path: Backlog file (created if missing)
+            slots: Ring capacity in packets
+            ack_timeout_sec: Wait this long for a sack before a packet may be backfilled
+            link_timeout_sec: Link counts as up this long after the last sack
+            max_per_broadcast: Backfill packets sent per broadcast
+            clock: Monotonic time source (injectable for tests)
+            first_seq: First sequence number of a newly created file (default random)
+        """
+        self._path = Path(path)
+        self._slots = slots
+        self._ack_timeout = ack_timeout_sec
+        self._link_timeout = link_timeout_sec
+        self._max_per_broadcast = max_per_broadcast
+        self._clock = clock
+        self._lock = threading.Lock()
+        # seq -> monotonic time last sent (None = loaded from disk, resend when link is up)
+        self._pending: dict[int, float | None] = {}
+        self._last_ack_at: float | None = None
+        self._first_seq = first_seq
+        self.next_seq = 0
+        self.overwritten = 0  # Unconfirmed packets lost to ring wrap
+        self.backfilled = 0
+
+        self._path.parent.mkdir(parents=True, exist_ok=True)
+        self._fd = os.open(self._path, os.O_RDWR | os.O_CREAT, 0o644)
+        if not self._load():
+            self._create()
+
+    # ─── File Handling ──────────────────────────────────────────────────────
+
+    def _offset(self, seq: int) -> int:
+        return HEADER.size + (seq % self._slots) * SLOT_SIZE
+
+    def _create(self) -> None:
+        first_seq = self._first_seq
+        if first_seq is None:
+            # Lower half, so the u32 seq doesn't wrap within a node's lifetime
+            first_seq = int.from_bytes(os.urandom(4), "little") >> 1
+        self.next_seq = first_seq & SEQ_MASK
+        os.ftruncate(self._fd, 0)
+        os.pwrite(
+            self._fd, HEADER.pack(MAGIC, VERSION, SLOT_SIZE, self._slots, self.next_seq), 0
+        )
+        os.ftruncate(self._fd, HEADER.size + self._slots * SLOT_SIZE)
+        logger.info(
+            f"Created uplink backlog {self._path} ({self._slots} slots, first seq {self.next_seq})"
+        )
+
+    def _load(self) -> bool:
+        """Load pending packets from an existing file. False if absent/incompatible."""
+        head = os.pread(self._fd, HEADER.size, 0)
+        if len(head) < HEADER.size:
+            return False
+        magic, version, slot_size, slots, first_seq = HEADER.unpack(head)
+        if (magic, version, slot_size, slots) != (MAGIC, VERSION, SLOT_SIZE, self._slots):
+            logger.warning(f"Uplink backlog {self._path} has a different layout, recreating")
+            return False
+
+        # Nothing written yet: continue from the file's first seq
+        self.next_seq = first_seq
+        highest = None
+        for i in range(self._slots):
+            seq, state, payload = self._read_slot_at(HEADER.size + i * SLOT_SIZE)
+            if state == STATE_EMPTY or payload is None:
+                continue
+            if highest is None or seq > highest:
+                highest = seq
+            if state == STATE_PENDING:
+                self._pending[seq] = None
+        if highest is not None:
+            self.next_seq = (highest + 1) & SEQ_MASK
+        logger.info(
+            f"Uplink backlog loaded: {len(self._pending)} unconfirmed, next seq {self.next_seq}"
+        )
+        return True
+
+    def _read_slot_at(self, offset: int) -> tuple[int, int, bytes | None]:
+        raw = os.pread(self._fd, SLOT_SIZE, offset)
+        if len(raw) < SLOT_HEADER.size:
+            return 0, STATE_EMPTY, None
+        seq, state, length, crc = SLOT_HEADER.unpack_from(raw)
+        if state == STATE_EMPTY:
+            return seq, state, None
+        payload = raw[SLOT_HEADER.size:SLOT_HEADER.size + length]
+        if len(payload) != length or zlib.crc32(payload) != crc:
+            return seq, STATE_EMPTY, None  # Torn or corrupt slot
+        return seq, state, payload
+
+    def close(self) -> None:
+        with self._lock:
+            if self._fd >= 0:
+                os.close(self._fd)
+                self._fd = -1
+
+    # ─── Uplink ─────────────────────────────────────────────────────────────
+
+    def record(self, first_seq: int, packets: list[bytes]) -> None:
+        """
+        Store packets just built with seq=first_seq (call before sending).
+
+        Packets must be numbered first_seq, first_seq + 1, ...
+        """
+        now = self._clock()
+        with self._lock:
+            if first_seq != self.next_seq:
+                raise ValueError(f"expected seq {self.next_seq}, got {first_seq}")
+            for i, packet in enumerate(packets):
+                seq = (first_seq + i) & SEQ_MASK
+                offset = self._offset(seq)
+                old_seq, old_state, _ = self._read_slot_at(offset)
+                if old_state == STATE_PENDING and old_seq in self._pending:
+                    self._pending.pop(old_seq)
+                    self.overwritten += 1
+                    logger.warning(f"Uplink backlog full, dropped unconfirmed seq {old_seq}")
+                header = SLOT_HEADER.pack(seq, STATE_PENDING, len(packet), zlib.crc32(packet))
+                os.pwrite(self._fd, header + packet, offset)
+                self._pending[seq] = now
+            self.next_seq = (first_seq + len(packets)) & SEQ_MASK
+
+    def ack(self, ranges: list[tuple[int, int]]) -> int:
+        """
+        Mark sequence ranges as confirmed by the gateway.
+
+        Returns:
+            Number of pending packets confirmed
+        """
+        confirmed = 0
+        with self._lock:
+            self._last_ack_at = self._clock()
+            for start, end in ranges:
+                if end - start >= self._slots:
+                    start = end - self._slots + 1  # Older seqs can't be in the ring
+                for seq in range(start, end + 1):
+                    if self._pending.pop(seq, None) is None:
+                        continue
+                    # Only the state byte changes
+                    os.pwrite(self._fd, bytes([STATE_ACKED]), self._offset(seq) + 4)
+                    confirmed += 1
+        return confirmed
+
+    def take_backfill(self) -> list[bytes]:
+        """
+        Packets to resend now, flagged as backfill (oldest first).
+
+        Empty unless the link is up; at most max_per_broadcast packets, each
+        unconfirmed for at least ack_timeout_sec since it was last sent.
+        """
+        now = self._clock()
+        result = []
+        with self._lock:
+            if self._last_ack_at is None or now - self._last_ack_at > self._link_timeout:
+                return []
+            for seq in sorted(self._pending):
+                if len(result) >= self._max_per_broadcast:
+                    break
+                sent_at = self._pending[seq]
+                if sent_at is not None and now - sent_at < self._ack_timeout:
+                    continue
+                _, state, payload = self._read_slot_at(self._offset(seq))
+                packet = mark_backfill(payload) if payload is not None else None
+                if state != STATE_PENDING or packet is None:
+                    self._pending.pop(seq)
+                    continue
+                self._pending[seq] = now
+                result.append(packet)
+            self.backfilled += len(result)
+        return result
+
+    @property
+    def pending_count(self) -> int:
+        with self._lock:
+            return len(self._pending)
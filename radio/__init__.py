@@ -7,10 +7,12 @@ LoRa communication on Raspberry Pi.
 
 from .base import Radio
 from .rfm9x import RFM9xRadio, rssi_to_brightness, RSSI_MAX, RSSI_MIN
+from .simulated import SimulatedRadio
 
 __all__ = [
     "Radio",
     "RFM9xRadio",
+    "SimulatedRadio",
     "rssi_to_brightness",
     "RSSI_MAX",
     "RSSI_MIN",
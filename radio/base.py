@@ -76,6 +76,14 @@ class Radio(ABC):
         """
         pass
 
+    def sleep(self) -> None:
+        """
+        Put the radio in its lowest-power mode until the next send/listen.
+
+        Default: no-op, for radios without a sleep mode.
+        """
+        pass
+
     def __enter__(self):
         """Context manager entry."""
         self.init()
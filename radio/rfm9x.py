@@ -111,6 +111,15 @@ class RFM9xRadio(Radio):
             return False
         return self._rfm9x.rx_done()
 
+    def sleep(self) -> None:
+        """Enter sleep mode (~0.2 uA); send() and listen() wake the radio.
+
+        Register contents (frequency, SF, BW, power) are kept in sleep.
+        """
+        if self._rfm9x is None:
+            return
+        self._rfm9x.sleep()
+
     def get_last_rssi(self) -> int | None:
         """Get RSSI of last received packet."""
         if self._rfm9x is None:
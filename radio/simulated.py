@@ -0,0 +1,179 @@
+"""
+Simulated LoRa radio for running a node without hardware.
+
+Implements the RFM9xRadio interface data_log uses (send, listen/rx_done,
+receive, sleep, frequency/SF/BW/power). send() takes the packet's real
+time on air (utils.energy.time_on_air) when realtime is on, so a node's
+duty cycle and lock contention look like the real thing; packets are lost
+with probability loss_rate (seeded). Nothing is transmitted: sent packets
+are counted, optionally kept in `sent`, and handed to on_send.
+
+Packets for the node (commands, ACKs) are queued with inject().
+
+Selected in node_config.json with:
+
+    "lora": {"simulated": {"loss_rate": 0.05, "seed": 1, "realtime": true}}
+
+Classes:
+    SimulatedRadio: In-process stand-in for RFM9xRadio
+"""
+
+from __future__ import annotations
+
+import logging
+import queue
+import random
+import time
+from typing import Callable
+
+from utils.energy import time_on_air
+
+from .base import Radio
+
+logger = logging.getLogger(__name__)
+
+
+class SimulatedRadio(Radio):
+    """RFM9xRadio stand-in with airtime, loss and an injectable receive queue."""
+
+    def __init__(
+        self,
+        frequency_mhz: float = 915.0,
+        tx_power: int = 23,
+        loss_rate: float = 0.0,
+        seed: int = 0,
+        realtime: bool = True,
+        rssi: int = -70,
+        keep_sent: int = 0,
+        on_send: Callable[[bytes], None] | None = None,
+        **_hardware_kwargs,
+    ):
+        """
+        Args:
+            frequency_mhz: Initial frequency
+            tx_power: Transmit power (dBm)
+            loss_rate: Fraction of sends lost (send() still returns True, like LoRa)
+            seed: Seed for losses
+            realtime: send() blocks for the packet's time on air
+            rssi: Reported RSSI of received packets
+            keep_sent: Keep the last N sent packets in `sent` (0 = none)
+            on_send: Called with each packet that isn't lost
+            **_hardware_kwargs: RFM9xRadio pin options, ignored
+        """
+        if not 0 <= loss_rate <= 1:
+            raise ValueError("loss_rate must be within 0-1")
+        self._frequency_mhz = frequency_mhz
+        self._tx_power = tx_power
+        self._spreading_factor = 7
+        self._signal_bandwidth = 125000
+        self._loss_rate = loss_rate
+        self._rng = random.Random(seed)
+        self._realtime = realtime
+        self._rssi = rssi
+        self._on_send = on_send
+        self._inbox: queue.Queue[bytes] = queue.Queue()
+        self._pending: bytes | None = None
+        self._initialized = False
+        self.sent: list[bytes] = []
+        self._keep_sent = keep_sent
+        self.packets_sent = 0
+        self.packets_lost = 0
+        self.bytes_sent = 0
+        self.airtime_sec = 0.0
+
+    def init(self) -> None:
+        self._initialized = True
+        logger.info(
+            f"Simulated radio: {self._frequency_mhz} MHz, loss {self._loss_rate:.0%}"
+        )
+
+    def _check(self) -> None:
+        if not self._initialized:
+            raise RuntimeError("Radio not initialized. Call init() first.")
+
+    def send(self, data: bytes) -> bool:
+        self._check()
+        airtime = time_on_air(len(data), self._spreading_factor, self._signal_bandwidth)
+        if self._realtime:
+            time.sleep(airtime)
+        self.packets_sent += 1
+        self.bytes_sent += len(data)
+        self.airtime_sec += airtime
+        if self._loss_rate and self._rng.random() < self._loss_rate:
+            self.packets_lost += 1
+            return True
+        if self._keep_sent:
+            self.sent.append(bytes(data))
+            del self.sent[:-self._keep_sent]
+        if self._on_send is not None:
+            self._on_send(bytes(data))
+        return True
+
+    def inject(self, data: bytes) -> None:
+        """Queue a packet for the node to receive."""
+        self._inbox.put(bytes(data))
+
+    def receive(self, timeout: float = 5.0) -> bytes | None:
+        self._check()
+        if self._pending is not None:
+            packet, self._pending = self._pending, None
+            return packet
+        try:
+            return self._inbox.get(timeout=timeout) if timeout > 0 else self._inbox.get_nowait()
+        except queue.Empty:
+            return None
+
+    def listen(self) -> None:
+        self._check()
+
+    def rx_done(self) -> bool:
+        if self._pending is None:
+            try:
+                self._pending = self._inbox.get_nowait()
+            except queue.Empty:
+                return False
+        return True
+
+    def get_last_rssi(self) -> int | None:
+        return self._rssi
+
+    def close(self) -> None:
+        if self._initialized:
+            logger.info(
+                f"Simulated radio: {self.packets_sent} packets sent "
+                f"({self.bytes_sent} bytes, {self.airtime_sec:.1f}s on air), "
+                f"{self.packets_lost} lost"
+            )
+        self._initialized = False
+
+    def set_frequency(self, frequency_mhz: float) -> None:
+        self._check()
+        self._frequency_mhz = frequency_mhz
+
+    @property
+    def frequency_mhz(self) -> float:
+        return self._frequency_mhz
+
+    @property
+    def tx_power(self) -> int:
+        return self._tx_power
+
+    @tx_power.setter
+    def tx_power(self, value: int) -> None:
+        self._tx_power = value
+
+    @property
+    def spreading_factor(self) -> int:
+        return self._spreading_factor
+
+    @spreading_factor.setter
+    def spreading_factor(self, value: int) -> None:
+        self._spreading_factor = value
+
+    @property
+    def signal_bandwidth(self) -> int:
+        return self._signal_bandwidth
+
+    @signal_bandwidth.setter
+    def signal_bandwidth(self, value: int) -> None:
+        self._signal_bandwidth = value
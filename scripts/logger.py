@@ -4,7 +4,6 @@
 import argparse
 import atexit
 import csv
-import inspect
 import json
 import signal
 import time
@@ -103,7 +102,7 @@ class DataLogger:
 
 def get_sensor_class(class_name: str) -> type[Sensor] | None:
     """
-    Get a Sensor class by name using reflection.
+    Get a Sensor class by name, importing its driver on first use.
 
     Args:
         class_name: Name of the sensor class (e.g., "BME280TempPressureHumidity")
@@ -111,10 +110,7 @@ def get_sensor_class(class_name: str) -> type[Sensor] | None:
     Returns:
         The sensor class, or None if not found
     """
-    for name, obj in inspect.getmembers(sensors_module, inspect.isclass):
-        if name == class_name and issubclass(obj, Sensor) and obj is not Sensor:
-            return obj
-    return None
+    return sensors_module.load_sensor_class(class_name)
 
 
 def instantiate_sensors(sensor_configs: list[dict]) -> list[Sensor]:
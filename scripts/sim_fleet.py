@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""
+Simulated node fleet for load and soak testing.
+
+Starts N node processes (node.data_log) from one simulated config, each
+with its own node_id, sensor/radio seeds and data directory, runs them for
+a while, stops them with SIGINT and prints each node's radio summary and
+error count. No hardware is touched: the config must use Simulated*
+sensors and "lora": {"simulated": ...}.
+
+Usage:
+    python3 scripts/sim_fleet.py                         # 4 nodes, 60s
+    python3 scripts/sim_fleet.py -n 20 -d 600            # 20 nodes, 10 minutes
+    python3 scripts/sim_fleet.py -c my_sim.json --keep   # Keep logs and data
+"""
+
+import argparse
+import copy
+import json
+import shutil
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+PROJECT_DIR = Path(__file__).resolve().parent.parent
+DEFAULT_CONFIG = PROJECT_DIR / "config" / "node_config_sim.json.example"
+
+
+def node_config(template: dict, index: int, data_dir: Path) -> dict:
+    """Template config for fleet member `index`."""
+    config = copy.deepcopy(template)
+    config["node_id"] = f"{template.get('node_id', 'sim')}-{index:03d}"
+    for n, sensor in enumerate(config.get("sensors", [])):
+        sensor.setdefault("config", {})["seed"] = index * 100 + n
+    lora = config.setdefault("lora", {})
+    simulated = lora.get("simulated")
+    lora["simulated"] = {**(simulated if isinstance(simulated, dict) else {}), "seed": index}
+    for section, key in (("sample_log", "path"), ("uplink", "backlog_path")):
+        if section in config:
+            config[section][key] = str(data_dir / Path(config[section].get(key, section)).name)
+    return config
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a fleet of simulated nodes")
+    parser.add_argument("-c", "--config", type=Path, default=DEFAULT_CONFIG,
+                        help="Simulated node config template")
+    parser.add_argument("-n", "--nodes", type=int, default=4, help="Number of nodes")
+    parser.add_argument("-d", "--duration", type=float, default=60.0, help="Seconds to run")
+    parser.add_argument("--keep", action="store_true", help="Keep the work directory")
+    args = parser.parse_args()
+
+    template = json.loads(args.config.read_text())
+    if not template.get("lora", {}).get("simulated"):
+        sys.exit(f"{args.config}: lora.simulated is not set; refusing to start real radios")
+
+    work = Path(tempfile.mkdtemp(prefix="sim_fleet_"))
+    procs = []
+    for i in range(args.nodes):
+        node_dir = work / f"node{i:03d}"
+        node_dir.mkdir()
+        config_path = node_dir / "config.json"
+        config_path.write_text(json.dumps(node_config(template, i, node_dir), indent=2))
+        log = open(node_dir / "node.log", "w")
+        procs.append((
+            subprocess.Popen(
+                [sys.executable, "-m", "node.data_log", str(config_path)],
+                cwd=PROJECT_DIR, stdout=log, stderr=subprocess.STDOUT,
+            ),
+            node_dir,
+            log,
+        ))
+    print(f"Started {args.nodes} nodes in {work}, running {args.duration:.0f}s")
+
+    try:
+        time.sleep(args.duration)
+    except KeyboardInterrupt:
+        pass
+    for proc, _, _ in procs:
+        proc.send_signal(signal.SIGINT)
+    for proc, node_dir, log in procs:
+        try:
+            proc.wait(timeout=30)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+        log.close()
+        lines = (node_dir / "node.log").read_text().splitlines()
+        errors = sum("[ERROR]" in line for line in lines)
+        summary = next(
+            (line.split("] ", 1)[-1] for line in reversed(lines) if "packets sent" in line),
+            "no radio summary",
+        )
+        print(f"{node_dir.name}: exit {proc.returncode}, {errors} errors, {summary}")
+
+    if args.keep:
+        print(f"Logs and data kept in {work}")
+    else:
+        shutil.rmtree(work)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,10 +5,9 @@ This package provides sensor abstractions and implementations for
 various hardware sensors on Raspberry Pi.
 """
 
+import importlib
+
 from .base import Sensor, c_to_f, transform_value
-from .bme280_sensor import BME280TempPressureHumidity
-from .mma8452_sensor import MMA8452Accelerometer
-from .ads1115_sensor import ADS1115ADC
 
 __all__ = [
     "Sensor",
@@ -17,13 +16,50 @@ __all__ = [
     "BME280TempPressureHumidity",
     "MMA8452Accelerometer",
     "ADS1115ADC",
+    "GPSSensor",
+    "SimulatedBME280",
+    "SimulatedMMA8452",
+    "SimulatedADS1115",
     "SENSOR_CLASS_IDS",
+    "SENSOR_DRIVERS",
     "SENSOR_ID_CLASSES",
     "get_sensor_class_id",
     "get_sensor_class_name",
+    "load_sensor_class",
 ]
 
 
+# Driver module per sensor class. Drivers are imported on first use
+# (load_sensor_class() or attribute access), so a node only pays for the
+# drivers its config names.
+SENSOR_DRIVERS: dict[str, str] = {
+    "BME280TempPressureHumidity": ".bme280_sensor",
+    "MMA8452Accelerometer": ".mma8452_sensor",
+    "ADS1115ADC": ".ads1115_sensor",
+    "GPSSensor": ".gps_sensor",
+    # Hardware-free stand-ins; they report as the real class (no IDs of their own)
+    "SimulatedBME280": ".simulated",
+    "SimulatedMMA8452": ".simulated",
+    "SimulatedADS1115": ".simulated",
+}
+
+
+def load_sensor_class(class_name: str) -> type[Sensor] | None:
+    """Import a sensor driver by class name; None if unknown."""
+    module_name = SENSOR_DRIVERS.get(class_name)
+    if module_name is None:
+        return None
+    module = importlib.import_module(module_name, __name__)
+    return getattr(module, class_name)
+
+
+def __getattr__(name: str):
+    # Lazy driver access: `from sensors import ADS1115ADC` still works
+    if name in SENSOR_DRIVERS:
+        return load_sensor_class(name)
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
 # Manual sensor class ID registry.
 # IDs are permanent — never reassign or reuse an ID.
 # The HTCC AB01 firmware hardcodes these IDs, so changing
@@ -33,6 +69,8 @@ _SENSOR_ID_MAP: dict[str, int] = {
     "BME280TempPressureHumidity": 0,
     "MMA8452Accelerometer": 1,
     "ADS1115ADC": 2,
+    "NodeTelemetry": 3,  # node.telemetry; node self-telemetry readings
+    "GPSSensor": 4,
 }
 
 SENSOR_CLASS_IDS: dict[str, int] = dict(_SENSOR_ID_MAP)
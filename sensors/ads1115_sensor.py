@@ -1,8 +1,72 @@
-"""ADS1115 4-channel 16-bit ADC sensor."""
+"""
+ADS1115 4-channel 16-bit ADC sensor.
 
+By default read() runs one single-shot conversion per active channel at the
+library's default data rate. With "scan": true, the ADC runs in continuous
+mode at "data_rate" and a background thread cycles the active channels,
+taking "samples" conversions per channel each pass. read() then returns the
+latest per-channel averages without touching the bus, or fails once the
+last completed scan is more than SCAN_STALE_PERIODS scans old:
+
+    {"class": "ADS1115ADC", "interval_sec": 60,
+     "config": {"channels": [0, 1], "data_rate": 250, "scan": true,
+                "samples": 16, "reject": 3.0, "scan_interval_sec": 0.5}}
+
+With "reject", conversions more than that many median absolute deviations
+from the channel's median are dropped before averaging (robust_mean), so a
+single glitch on a long soil-moisture lead doesn't move the value.
+
+Functions:
+    robust_mean: Mean after median/MAD outlier rejection
+"""
+
+import logging
+import statistics
+import threading
+import time
 from enum import Enum
 
-from .base import Sensor, transform_value
+from utils.i2c_bus import BusioAdapter, get_bus
+from utils.log_throttle import log_throttled
+
+from .base import Sensor
+from .calibration import as_step_list
+
+logger = logging.getLogger(__name__)
+
+# Supported data rates (samples per second)
+DATA_RATES = (8, 16, 32, 64, 128, 250, 475, 860)
+
+# Scale from MAD to a normal distribution's standard deviation
+MAD_TO_SIGMA = 1.4826
+
+# Scan-mode reads fail once the last scan is this many scan periods old
+# (but at least SCAN_STALE_MIN_SEC, so scheduling jitter doesn't count)
+SCAN_STALE_PERIODS = 3
+SCAN_STALE_MIN_SEC = 1.0
+
+
+def robust_mean(values: list[float], reject: float | None = None) -> float:
+    """
+    Mean of values, optionally without outliers.
+
+    Args:
+        values: Conversions for one channel (non-empty)
+        reject: Drop values more than this many (scaled) MADs from the median;
+            None keeps everything
+
+    Returns:
+        Mean of the kept values (the median if the MAD is zero and outliers exist)
+    """
+    if reject is None or len(values) < 3:
+        return sum(values) / len(values)
+    median = statistics.median(values)
+    mad = statistics.median(abs(v - median) for v in values) * MAD_TO_SIGMA
+    if mad == 0:
+        kept = [v for v in values if v == median]
+    else:
+        kept = [v for v in values if abs(v - median) <= reject * mad]
+    return sum(kept) / len(kept)
 
 
 class ADS1115Gain(float, Enum):
@@ -37,7 +101,30 @@ class ADS1115ADC(Sensor):
         units: tuple[str, ...] | None = None,
         gain: float = ADS1115Gain.GAIN_2_3,  # +/- 6.144V range (safest default)
         transforms: dict[str, dict] | None = None,
+        data_rate: int | None = None,
+        scan: bool = False,
+        samples: int = 1,
+        reject: float | None = None,
+        scan_interval_sec: float = 0.5,
     ):
+        if data_rate is not None and data_rate not in DATA_RATES:
+            raise ValueError(f"Invalid data_rate {data_rate}, must be one of: {DATA_RATES}")
+        if samples < 1:
+            raise ValueError("samples must be >= 1")
+        if reject is not None and reject <= 0:
+            raise ValueError("reject must be positive")
+        self._data_rate = data_rate
+        self._scan = scan
+        self._samples = samples
+        self._reject = reject
+        self._scan_interval = scan_interval_sec
+        self._scan_thread: threading.Thread | None = None
+        self._scan_running = False
+        self._scan_ready = threading.Event()
+        self._latest: tuple | None = None
+        self._scan_at = 0.0
+        self.scans = 0
+        self.scan_errors = 0
         self._smbus = smbus
         self._address = address
 
@@ -120,32 +207,96 @@ class ADS1115ADC(Sensor):
                     "raw_max": raw_max,
                     "invert": t.get("invert", False),
                 }
+        if self._transforms:
+            self.set_calibration({})
 
     def init(self) -> None:
-        import board
-        import busio
         import adafruit_ads1x15.ads1115 as ADS
+        from adafruit_ads1x15.ads1x15 import Mode
         from adafruit_ads1x15.analog_in import AnalogIn
 
-        self._i2c = busio.I2C(board.SCL, board.SDA)
+        # Adafruit's driver over the node's shared bus instead of its own busio.I2C
+        self._i2c = BusioAdapter(get_bus(self._smbus))
         self._ads = ADS.ADS1115(self._i2c, address=self._address)
         self._ads.gain = self._gain
+        if self._data_rate is not None:
+            self._ads.data_rate = self._data_rate
         self._analog_inputs = [
             AnalogIn(self._ads, ch.value) for ch in self._active_channels
         ]
+        if self._scan:
+            # Continuous mode: the library waits one conversion after a mux
+            # change, then reads the conversion register directly
+            self._ads.mode = Mode.CONTINUOUS
+            self._start_scan()
+
+    def _start_scan(self) -> None:
+        self._scan_running = True
+        self._scan_thread = threading.Thread(
+            target=self._scan_loop, daemon=True, name="ADS1115Scan"
+        )
+        self._scan_thread.start()
+
+    def _scan_once(self) -> tuple:
+        """One pass over the active channels: `samples` conversions each."""
+        period = 1.0 / (self._data_rate or 128)
+        values = []
+        for ai in self._analog_inputs:
+            conversions = [ai.voltage]
+            for _ in range(self._samples - 1):
+                time.sleep(period)  # Next conversion, not the same one again
+                conversions.append(ai.voltage)
+            values.append(robust_mean(conversions, self._reject))
+        return tuple(values)
+
+    def _scan_loop(self) -> None:
+        while self._scan_running:
+            try:
+                values = self._scan_once()
+            except Exception as e:
+                self.scan_errors += 1
+                log_throttled(
+                    logger, logging.WARNING, self.scan_errors,
+                    f"ADS1115 scan failed (#{self.scan_errors}): {e}",
+                )
+                time.sleep(1.0)
+                continue
+            self._latest = values
+            self._scan_at = time.monotonic()
+            self.scans += 1
+            self._scan_ready.set()
+            time.sleep(self._scan_interval)
+
+    def _max_scan_age(self) -> float:
+        conversions = len(self._active_channels) * self._samples
+        period = conversions / (self._data_rate or 128) + self._scan_interval
+        return max(SCAN_STALE_PERIODS * period, SCAN_STALE_MIN_SEC)
 
     def read(self) -> tuple:
+        if self._scan:
+            # Latest averages; only the first read after init can wait
+            if not self._scan_ready.wait(timeout=2.0):
+                raise TimeoutError("ADS1115 scan has not completed yet")
+            age = time.monotonic() - self._scan_at
+            if age > self._max_scan_age():
+                raise TimeoutError(f"ADS1115 last scan is {age:.1f}s old")
+            return self._latest
         return tuple(ai.voltage for ai in self._analog_inputs)
 
-    def transform(self, values: tuple) -> tuple:
-        if not self._transforms:
-            return values
-        result = list(values)
-        for i, ch in enumerate(self._active_channels):
-            if ch.value in self._transforms:
-                t = self._transforms[ch.value]
-                result[i] = transform_value(values[i], **t)
-        return tuple(result)
+    def _transform_spec(self) -> dict[str, list[dict]]:
+        """"transforms" as normalize calibration steps, keyed by reading name."""
+        return {
+            self._names[i]: [{"type": "normalize", **self._transforms[ch.value]}]
+            for i, ch in enumerate(self._active_channels)
+            if ch.value in self._transforms
+        }
+
+    def set_calibration(self, config: dict) -> None:
+        # A channel's "transforms" normalize runs before its calibration steps
+        spec = self._transform_spec()
+        for name, steps in config.items():
+            spec[name] = spec.get(name, []) + as_step_list(steps)
+        super().set_calibration(spec)
 
     def get_names(self) -> tuple[str, ...]:
         return self._names
@@ -157,6 +308,10 @@ class ADS1115ADC(Sensor):
         return 4  # 16-bit ADC benefits from extra precision
 
     def close(self) -> None:
+        self._scan_running = False
+        if self._scan_thread is not None:
+            self._scan_thread.join(timeout=2.0)
+            self._scan_thread = None
         if self._i2c:
             self._i2c.deinit()
             self._i2c = None
@@ -2,34 +2,36 @@
 Arducam IMX477 camera capture and 7-segment OCR.
 
 Provides camera capture functionality and OCR for 7-segment displays.
-Can be used as a library (capture_and_ocr function) or CLI tool.
+OCR runs in-process on numpy images (sensors.seven_segment).
+Can be used as a library (capture_and_ocr function) or CLI tool
+(python3 -m sensors.arducam). Pass a CameraSession (sensors.camera_session)
+to keep the camera warm between captures.
 
 Setup Notes:
     # Install binaries (faster than pip)
     sudo apt update
-    sudo apt install python3-picamera2 python3-opencv python3-numpy python3-pil -y
+    sudo apt install python3-picamera2 python3-opencv python3-numpy -y
 
     # Check if camera is detected
     sudo apt install libcamera-apps -y
     rpicam-hello --list-cameras
 
-    # Install ssocr for 7-segment display OCR
-    sudo apt install ssocr -y
-
     # Update firmware config (/boot/firmware/config.txt)
     camera_auto_detect=0
     dtoverlay=imx477
 """
 
 import argparse
-import subprocess
 import time
 from enum import Enum
 from pathlib import Path
 
 import cv2
 import numpy as np
-from PIL import Image
+
+from .camera_session import CameraSession
+from .display_tracker import DisplayTracker
+from .seven_segment import read_seven_segment
 
 
 class CropMode(Enum):
@@ -49,21 +51,34 @@ AVAILABLE_SIZES = {
 DEFAULT_SIZE = "4056x3040"
 
 
-def detect_display(image_path, min_area=5000, max_area_ratio=0.05):
+def _load_image(image) -> np.ndarray | None:
+    """BGR array from an image file, or the array itself."""
+    if isinstance(image, np.ndarray):
+        return image
+    img = cv2.imread(str(image))
+    if img is None:
+        print(f"Error: Could not load image {image}")
+    return img
+
+
+def _to_gray(img: np.ndarray) -> np.ndarray:
+    return img if img.ndim == 2 else cv2.cvtColor(img, cv2.COLOR_BGR2GRAY)
+
+
+def detect_display(image, min_area=5000, max_area_ratio=0.05):
     """
     Auto-detect 7-segment LCD/LED displays in an image using contour detection.
 
     Args:
-        image_path: Path to the image file
+        image: BGR image array, or path to the image file
         min_area: Minimum contour area to consider
         max_area_ratio: Maximum ratio of image area for a display region
 
     Returns:
         List of bounding boxes (x, y, w, h) sorted by score (best first).
     """
-    img = cv2.imread(str(image_path))
+    img = _load_image(image)
     if img is None:
-        print(f"Error: Could not load image {image_path}")
         return []
 
     height, width = img.shape[:2]
@@ -71,7 +86,7 @@ def detect_display(image_path, min_area=5000, max_area_ratio=0.05):
     img_center_x, img_center_y = width // 2, height // 2
 
     # Convert to grayscale
-    gray = cv2.cvtColor(img, cv2.COLOR_BGR2GRAY)
+    gray = _to_gray(img)
 
     # Apply bilateral filter to reduce noise while keeping edges sharp
     filtered = cv2.bilateralFilter(gray, 9, 75, 75)
@@ -141,26 +156,33 @@ def detect_display(image_path, min_area=5000, max_area_ratio=0.05):
 
 
 def run_ocr(
-    image_path,
+    image,
     crop_region: tuple | None = None,
     preprocess: bool = True,
     num_digits: int | None = None,
+    debug_dir: Path | None = None,
 ):
     """
-    Run ssocr on an image, optionally cropping first.
+    Read a 7-segment display in an image, optionally cropping first.
+
+    Decoding runs in memory (sensors.seven_segment); nothing is written to
+    disk unless debug_dir is set.
 
     Args:
-        image_path: Path to the image file
+        image: BGR image array, or path to the image file
         crop_region: Optional (x, y, w, h) tuple for crop region. If None, uses full image.
         preprocess: If True, apply normalization, blur, and Otsu thresholding (posterization).
-                    If False, just use grayscale image directly.
-        num_digits: Expected number of digits. If None, ssocr auto-detects.
+                    If False, threshold the grayscale image at mid-range.
+        num_digits: Expected number of digits. If None, any number is accepted.
+        debug_dir: If set, save the grayscale crop (ocr_gray.png) and the thresholded
+                   image the digits are read from (ocr_crop.png) here.
 
     Returns:
         OCR result string, or None if recognition failed.
     """
-    # Load image
-    img = cv2.imread(str(image_path))
+    img = _load_image(image)
+    if img is None:
+        return None
 
     # Crop if region provided, otherwise use full image
     if crop_region is not None:
@@ -170,21 +192,7 @@ def run_ocr(
         cropped = img
 
     # Convert to grayscale
-    gray = cv2.cvtColor(cropped, cv2.COLOR_BGR2GRAY)
-
-    # Only scale up small images (cropped regions) - ssocr works better with larger images
-    # Skip scaling for large images (full frame) to avoid memory/performance issues
-    if gray.shape[1] < 1000:
-        scale = 3
-        gray = cv2.resize(
-            gray,
-            (gray.shape[1] * scale, gray.shape[0] * scale),
-            interpolation=cv2.INTER_CUBIC,
-        )
-
-    # Save grayscale cropped image
-    gray_path = Path(image_path).parent / "ocr_gray.png"
-    cv2.imwrite(str(gray_path), gray)
+    gray = _to_gray(cropped)
 
     if preprocess:
         # Normalize to use full 0-255 range (stretch contrast)
@@ -193,50 +201,47 @@ def run_ocr(
         # Light blur to reduce noise
         blurred = cv2.GaussianBlur(normalized, (3, 3), 0)
 
-        # Simple Otsu threshold on normalized image
-        _, thresh = cv2.threshold(blurred, 0, 255, cv2.THRESH_BINARY + cv2.THRESH_OTSU)
-
-        # For dark LCD displays, digits are lighter than background
-        # After Otsu, check if we need to invert for ssocr (expects dark on light)
-        if np.mean(thresh) > 127:
-            thresh = cv2.bitwise_not(thresh)
-
-        ocr_image = thresh
+        # Simple Otsu threshold on normalized image; the decoder takes
+        # whichever side is the minority as the digits
+        _, ocr_image = cv2.threshold(blurred, 0, 255, cv2.THRESH_BINARY + cv2.THRESH_OTSU)
     else:
-        # No preprocessing - use grayscale directly
+        # No preprocessing - the decoder thresholds at mid-range
         ocr_image = gray
 
-    # Save preprocessed image
-    crop_path = Path(image_path).parent / "ocr_crop.png"
-    cv2.imwrite(str(crop_path), ocr_image)
+    if debug_dir is not None:
+        cv2.imwrite(str(Path(debug_dir) / "ocr_gray.png"), gray)
+        cv2.imwrite(str(Path(debug_dir) / "ocr_crop.png"), ocr_image)
 
-    # Build ssocr command
-    # -t 50: threshold percentage
-    # -d N: expected number of digits (omit for auto-detect)
-    cmd = ["ssocr", "-t", "50"]
-    if num_digits is not None:
-        cmd.extend(["-d", str(num_digits)])
-    cmd.append(str(crop_path))
+    return read_seven_segment(ocr_image, num_digits=num_digits)
 
-    try:
-        result = subprocess.run(
-            cmd,
-            capture_output=True,
-            text=True,
-            timeout=30,
-        )
-        if result.returncode == 0 and result.stdout.strip():
-            return result.stdout.strip()
-        return None
-    except FileNotFoundError:
-        print("ssocr not found. Install with: sudo apt install ssocr")
-        return None
+
+def make_display_tracker(
+    preprocess: bool = True,
+    num_digits: int | None = None,
+    debug_dir: Path | None = None,
+    **kwargs,
+) -> DisplayTracker:
+    """
+    DisplayTracker using detect_display() and run_ocr().
+
+    The local search around a known display allows it to fill most of the
+    search window. kwargs are passed to DisplayTracker.
+    """
+    return DisplayTracker(
+        detect=detect_display,
+        detect_local=lambda window: detect_display(window, max_area_ratio=0.5),
+        recognize=lambda image, roi: run_ocr(
+            image, roi, preprocess=preprocess, num_digits=num_digits, debug_dir=debug_dir
+        ),
+        **kwargs,
+    )
 
 
 def capture_image(
     output_path: Path | None = None,
     size: str = DEFAULT_SIZE,
     flip: bool = True,
+    session: CameraSession | None = None,
 ) -> Path:
     """
     Capture an image from the Arducam IMX477 camera.
@@ -245,39 +250,45 @@ def capture_image(
         output_path: Path to save the image (default: sensors/timed_capture.jpg)
         size: Image size key from AVAILABLE_SIZES
         flip: Whether to rotate image 180 degrees
+        session: Warm camera session to capture with; size and flip are then the
+            session's. Without one the camera is opened and closed for this capture.
 
     Returns:
         Path to the captured image file.
     """
-    from picamera2 import Picamera2
-
     if output_path is None:
         output_path = Path(__file__).parent / "timed_capture.jpg"
 
-    resolution = AVAILABLE_SIZES[size]
+    if session is not None:
+        return session.capture_file(output_path)
 
-    picam2 = Picamera2()
-    config = picam2.create_still_configuration(main={"size": resolution})
-    picam2.configure(config)
-    picam2.start()
+    with CameraSession(size=AVAILABLE_SIZES[size], flip=flip, idle_timeout_sec=None) as one_shot:
+        return one_shot.capture_file(output_path)
 
-    try:
-        # Wait for auto-exposure to settle
-        time.sleep(2)
 
-        # Capture the image
-        picam2.capture_file(str(output_path))
+def capture_array(
+    size: str = DEFAULT_SIZE,
+    flip: bool = True,
+    session: CameraSession | None = None,
+    roi: tuple | None = None,
+) -> np.ndarray:
+    """
+    Capture an image from the Arducam IMX477 camera into memory.
 
-        # Rotate 180 degrees if flip is enabled
-        if flip:
-            img = Image.open(output_path)
-            img = img.rotate(180)
-            img.save(output_path)
+    Args:
+        size: Image size key from AVAILABLE_SIZES
+        flip: Whether to rotate image 180 degrees
+        session: Warm camera session to capture with (see capture_image)
+        roi: Optional (x, y, w, h); return only this region
 
-        return output_path
-    finally:
-        picam2.stop()
-        picam2.close()
+    Returns:
+        BGR image array.
+    """
+    if session is not None:
+        return session.capture_array(roi=roi)
+
+    with CameraSession(size=AVAILABLE_SIZES[size], flip=flip, idle_timeout_sec=None) as one_shot:
+        return one_shot.capture_array(roi=roi)
 
 
 def capture_and_ocr(
@@ -288,33 +299,37 @@ def capture_and_ocr(
     crop_region: tuple | None = None,
     preprocess: bool = True,
     num_digits: int | None = None,
+    session: CameraSession | None = None,
+    tracker: DisplayTracker | None = None,
 ) -> str | None:
     """
     Capture image and run OCR, returning result or None.
 
     This is the main function for external use. Captures an image,
-    optionally crops based on crop_mode, and runs OCR.
+    optionally crops based on crop_mode, and runs OCR. Everything stays in
+    memory unless output_dir is given.
 
     Args:
-        output_dir: Directory to save captured image (default: sensors/)
+        output_dir: Directory to save the captured image and OCR debug images
+                    (default: none saved)
         size: Image size key from AVAILABLE_SIZES
         flip: Whether to rotate image 180 degrees
         crop_mode: CropMode enum value for cropping behavior
         crop_region: (x, y, w, h) tuple required when crop_mode=CropMode.MANUAL
         preprocess: If True, apply posterization (normalize, blur, threshold).
                     If False, use grayscale image directly.
-        num_digits: Expected number of digits. If None, ssocr auto-detects.
+        num_digits: Expected number of digits. If None, any number is accepted.
+        session: Warm camera session to capture with (see capture_image)
+        tracker: For CropMode.AUTO across repeated calls: keeps the detected
+                 display and skips OCR while it hasn't changed (make_display_tracker)
 
     Returns:
         OCR result string, or None if no result found.
     """
-    if output_dir is None:
-        output_dir = Path(__file__).parent
-
-    output_path = output_dir / "timed_capture.jpg"
-
     # Capture image
-    capture_image(output_path=output_path, size=size, flip=flip)
+    image = capture_array(size=size, flip=flip, session=session)
+    if output_dir is not None:
+        cv2.imwrite(str(Path(output_dir) / "timed_capture.jpg"), image)
 
     # Determine crop region based on mode
     if crop_mode == CropMode.NONE:
@@ -325,15 +340,19 @@ def capture_and_ocr(
         if crop_region is None:
             raise ValueError("crop_region required when crop_mode=CropMode.MANUAL")
     elif crop_mode == CropMode.AUTO:
+        if tracker is not None:
+            return tracker.read(image)
         # Auto-detect display region
-        candidates = detect_display(output_path)
+        candidates = detect_display(image)
         if not candidates:
             return None
         crop_region = candidates[0]
     else:
         raise ValueError(f"Invalid crop_mode: {crop_mode}")
 
-    return run_ocr(output_path, crop_region, preprocess=preprocess, num_digits=num_digits)
+    return run_ocr(
+        image, crop_region, preprocess=preprocess, num_digits=num_digits, debug_dir=output_dir
+    )
 
 
 def _parse_args():
@@ -407,8 +426,6 @@ def _parse_args():
 
 def _main():
     """CLI entry point."""
-    from picamera2 import Picamera2
-
     args = _parse_args()
     size = AVAILABLE_SIZES[args.size]
 
@@ -416,43 +433,40 @@ def _main():
     if args.crop and args.crop_mode == "auto":
         args.crop_mode = "manual"
 
-    # Initialize the camera
-    picam2 = Picamera2()
-    config = picam2.create_still_configuration(main={"size": size})
-    picam2.configure(config)
-    picam2.start()
+    # One warm session for all captures; the flip is done by the ISP
+    session = CameraSession(size=size, flip=args.flip, idle_timeout_sec=None)
     print(f"Using size: {args.size}")
 
+    # Auto mode keeps the display found in the first capture and only
+    # re-runs OCR when it changes
+    output_dir = Path(__file__).parent
+    tracker = make_display_tracker(
+        preprocess=args.preprocess, num_digits=args.digits, debug_dir=output_dir
+    )
+
     try:
-        print("Waiting for auto-exposure to settle...")
-        time.sleep(2)  # Essential for the HQ camera to calibrate light levels
+        print("Opening camera and waiting for auto-exposure to settle...")
+        session.open()
 
         for capture_num in range(args.cnt):
             if args.cnt > 1:
                 print(f"\n=== Capture {capture_num + 1}/{args.cnt} ===")
 
             # Define file path
-            output_path = Path(__file__).parent / "timed_capture.jpg"
+            output_path = output_dir / "timed_capture.jpg"
 
             print("Capturing image...")
 
             # Start the timer
             start_time = time.time()
 
-            # Capture the high-res file
-            picam2.capture_file(str(output_path))
+            # Capture the high-res file (the first one also opens the camera)
+            session.capture_file(output_path)
 
             # Calculate elapsed time
             end_time = time.time()
             duration = end_time - start_time
 
-            # Rotate 180 degrees if --flip is enabled (default)
-            if args.flip:
-                img = Image.open(output_path)
-                img = img.rotate(180)
-                img.save(output_path)
-                print("Image rotated 180 degrees")
-
             print("-" * 30)
             print("Capture Successful!")
             print(f"File saved to: {output_path}")
@@ -463,6 +477,7 @@ def _main():
             if args.ocr:
                 crop_mode = CropMode(args.crop_mode)
                 crop_region = None
+                image = cv2.imread(str(output_path))
 
                 if crop_mode == CropMode.MANUAL:
                     if not args.crop:
@@ -476,9 +491,8 @@ def _main():
 
                 elif crop_mode == CropMode.AUTO:
                     print("Auto-detecting 7-segment display...")
-                    candidates = detect_display(output_path)
-                    if candidates:
-                        crop_region = candidates[0]
+                    crop_region = tracker.locate(image)
+                    if crop_region:
                         print(f"Found display at region {crop_region}")
                     else:
                         print("No 7-segment display detected in image")
@@ -489,7 +503,7 @@ def _main():
 
                 # Save debug image if requested
                 if args.debug_detect and crop_region:
-                    debug_img = cv2.imread(str(output_path))
+                    debug_img = image.copy()
                     x, y, w, h = crop_region
                     cv2.rectangle(
                         debug_img, (x, y), (x + w, y + h), (0, 255, 0), 3
@@ -507,12 +521,16 @@ def _main():
                     cv2.imwrite(str(debug_path), debug_img)
                     print(f"Debug image saved to: {debug_path}")
 
-                ocr_result = run_ocr(
-                    output_path,
-                    crop_region,
-                    preprocess=args.preprocess,
-                    num_digits=args.digits,
-                )
+                if crop_mode == CropMode.AUTO:
+                    ocr_result = tracker.recognize(image)
+                else:
+                    ocr_result = run_ocr(
+                        image,
+                        crop_region,
+                        preprocess=args.preprocess,
+                        num_digits=args.digits,
+                        debug_dir=output_dir,
+                    )
                 if ocr_result:
                     print(f"OCR Result: {ocr_result}")
                 else:
@@ -523,9 +541,15 @@ def _main():
                 print(f"Waiting {args.delay}s before next capture...")
                 time.sleep(args.delay)
 
+        if args.ocr and args.crop_mode == "auto" and args.cnt > 1:
+            stats = tracker.stats
+            print(
+                f"\nDisplay searches: {stats.detections} full, {stats.tracked} tracked; "
+                f"OCR runs: {stats.recognitions}, skipped unchanged: {stats.skipped}"
+            )
+
     finally:
-        picam2.stop()
-        picam2.close()
+        session.close()
 
 
 if __name__ == "__main__":
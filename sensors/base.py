@@ -1,6 +1,12 @@
 """Sensor base class and utilities."""
 
+from __future__ import annotations
+
 from abc import ABC, abstractmethod
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from .calibration import CalibrationPipeline
 
 
 def c_to_f(c: float) -> float:
@@ -29,6 +35,14 @@ def transform_value(
 class Sensor(ABC):
     """Abstract base class for all sensors."""
 
+    # Compiled per-reading calibration (set_calibration); None = none
+    calibration: CalibrationPipeline | None = None
+
+    @property
+    def class_name(self) -> str:
+        """Class name readings are reported under (sensor class ID)."""
+        return type(self).__name__
+
     @abstractmethod
     def init(self) -> None:
         """Initialize the sensor."""
@@ -52,9 +66,23 @@ class Sensor(ABC):
     def transform(self, values: tuple) -> tuple:
         """Transform raw sensor values. Override to apply per-reading transforms.
 
-        Default: identity (returns values unchanged).
+        Default: the calibration pipeline if one is set, else identity.
         """
-        return values
+        if self.calibration is None:
+            return values
+        return self.calibration.apply(values)
+
+    def set_calibration(self, config: dict) -> None:
+        """Compile a {reading name: step(s)} calibration config (sensors.calibration).
+
+        Raises:
+            ValueError: If the config doesn't match this sensor's readings
+        """
+        from .calibration import CalibrationPipeline
+
+        self.calibration = (
+            CalibrationPipeline.compile(config, self.get_names()) if config else None
+        )
 
     def get_precision(self) -> int:
         """Return the number of decimal places for float values. Default is 3."""
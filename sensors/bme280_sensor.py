@@ -1,39 +1,237 @@
-"""BME280 temperature, pressure, and humidity sensor."""
+"""
+BME280 temperature, pressure, and humidity sensor.
 
+Register-level driver over the node's shared I2C bus (utils.i2c_bus). Each read() triggers one forced-mode
+measurement, waits for it to finish, and fetches all three raw values in a
+single 8-byte burst (0xF7-0xFE), compensated with the chip's calibration.
+Between reads the sensor sleeps, so it doesn't self-heat and the read
+latency is the measurement time, not whatever the library defaults were.
+
+Oversampling (per channel: 0 = skipped, 1, 2, 4, 8, 16) and the IIR filter
+coefficient (0 = off, 2, 4, 8, 16) are configurable:
+
+    {"class": "BME280TempPressureHumidity",
+     "config": {"oversampling": {"temperature": 2, "pressure": 4, "humidity": 1},
+                "iir_filter": 4}}
+
+The datasheet's maximum measurement time for the settings is in
+max_measurement_ms; the last measured trigger-to-ready time is in
+measurement_ms (and reported as "Measure Time" with report_timing).
+"""
+
+import logging
+import struct
+import time
 from time import sleep
 
+from utils.i2c_bus import get_bus
+
 from .base import Sensor, c_to_f
 
+logger = logging.getLogger(__name__)
+
 
 class BME280TempPressureHumidity(Sensor):
     """Driver for BME280 temperature, pressure, and humidity sensor."""
 
-    def __init__(self, smbus: int = 1):
+    DEFAULT_ADDRESS = 0x76
+
+    # Register addresses
+    REG_CALIB_TP = 0x88  # dig_T1..dig_P9 (24 bytes), 0xA1 = dig_H1
+    REG_CHIP_ID = 0xD0
+    REG_RESET = 0xE0
+    REG_CALIB_H = 0xE1  # dig_H2..dig_H6 (7 bytes)
+    REG_CTRL_HUM = 0xF2
+    REG_STATUS = 0xF3
+    REG_CTRL_MEAS = 0xF4
+    REG_CONFIG = 0xF5
+    REG_DATA = 0xF7  # press[3], temp[3], hum[2]
+
+    CHIP_ID = 0x60
+    RESET_WORD = 0xB6
+    STATUS_MEASURING = 0x08
+    STATUS_IM_UPDATE = 0x01
+    MODE_FORCED = 0x01
+
+    # Oversampling factor -> osrs register code (0 = measurement skipped)
+    OVERSAMPLING_CODES = {0: 0, 1: 1, 2: 2, 4: 3, 8: 4, 16: 5}
+    # IIR filter coefficient -> filter register code
+    IIR_CODES = {0: 0, 2: 1, 4: 2, 8: 3, 16: 4}
+
+    def __init__(
+        self,
+        smbus: int = 1,
+        address: int = DEFAULT_ADDRESS,
+        oversampling: dict[str, int] | None = None,
+        iir_filter: int = 0,
+        report_timing: bool = False,
+    ):
+        """
+        Args:
+            smbus: I2C bus number
+            address: I2C address (0x76, or 0x77 with SDO high)
+            oversampling: Factors for "temperature", "pressure", "humidity" (default 1)
+            iir_filter: IIR filter coefficient (0 = off)
+            report_timing: Add a "Measure Time" reading (ms)
+        """
+        oversampling = oversampling or {}
+        self._osrs = {}
+        for channel in ("temperature", "pressure", "humidity"):
+            factor = oversampling.get(channel, 1)
+            if factor not in self.OVERSAMPLING_CODES:
+                raise ValueError(
+                    f"Invalid {channel} oversampling {factor}, "
+                    f"must be one of: {sorted(self.OVERSAMPLING_CODES)}"
+                )
+            self._osrs[channel] = factor
+        if self._osrs["temperature"] == 0:
+            raise ValueError("temperature oversampling can't be 0 (needed for compensation)")
+        if iir_filter not in self.IIR_CODES:
+            raise ValueError(
+                f"Invalid iir_filter {iir_filter}, must be one of: {sorted(self.IIR_CODES)}"
+            )
         self._smbus = smbus
-        self._bme = None
+        self._address = address
+        self._iir = iir_filter
+        self._report_timing = report_timing
         self._bus = None
+        self._calib: dict[str, int] = {}
+        self.measurement_ms = 0.0
+        self.max_measurement_ms = self._measurement_time_ms(maximum=True)
+
+    def _measurement_time_ms(self, maximum: bool) -> float:
+        """Datasheet measurement time (section 9.1) for the oversampling settings."""
+        t, p, h = (self._osrs[c] for c in ("temperature", "pressure", "humidity"))
+        if maximum:
+            return (
+                1.25 + 2.3 * t
+                + (2.3 * p + 0.575 if p else 0.0)
+                + (2.3 * h + 0.575 if h else 0.0)
+            )
+        return 1.0 + 2.0 * t + (2.0 * p + 0.5 if p else 0.0) + (2.0 * h + 0.5 if h else 0.0)
+
+    # ─── Setup ──────────────────────────────────────────────────────────────
 
     def init(self) -> None:
-        from bme280 import BME280
-        from smbus2 import SMBus
+        self._bus = get_bus(self._smbus)
+
+        chip_id = self._bus.read_byte_data(self._address, self.REG_CHIP_ID)
+        if chip_id != self.CHIP_ID:
+            raise RuntimeError(
+                f"BME280 not found. Expected 0x{self.CHIP_ID:02X}, got 0x{chip_id:02X}"
+            )
+
+        # Soft reset, then wait for the calibration NVM copy
+        self._bus.write_byte_data(self._address, self.REG_RESET, self.RESET_WORD)
+        sleep(0.002)
+        for _ in range(50):
+            status = self._bus.read_byte_data(self._address, self.REG_STATUS)
+            if not status & self.STATUS_IM_UPDATE:
+                break
+            sleep(0.001)
+
+        self._read_calibration()
+
+        # Filter (standby time is unused in forced mode), written in sleep
+        # mode; ctrl_hum only takes effect after the next ctrl_meas write
+        self._bus.write_registers(self._address, [
+            (self.REG_CONFIG, self.IIR_CODES[self._iir] << 2),
+            (self.REG_CTRL_HUM, self.OVERSAMPLING_CODES[self._osrs["humidity"]]),
+        ])
+        logger.debug(
+            f"BME280 oversampling {self._osrs}, IIR {self._iir}, "
+            f"max measurement {self.max_measurement_ms:.1f}ms"
+        )
+
+    def _read_calibration(self) -> None:
+        tp = bytes(self._bus.read_i2c_block_data(self._address, self.REG_CALIB_TP, 26))
+        h = bytes(self._bus.read_i2c_block_data(self._address, self.REG_CALIB_H, 7))
+        names = ("T1", "T2", "T3", "P1", "P2", "P3", "P4", "P5", "P6", "P7", "P8", "P9")
+        calib = dict(zip(names, struct.unpack("<HhhHhhhhhhhh", tp[:24])))
+        calib["H1"] = tp[25]
+        calib["H2"] = struct.unpack("<h", h[0:2])[0]
+        calib["H3"] = h[2]
+        # H4/H5 are 12-bit signed values sharing register 0xE5
+        calib["H4"] = (struct.unpack("b", h[3:4])[0] << 4) | (h[4] & 0x0F)
+        calib["H5"] = (struct.unpack("b", h[5:6])[0] << 4) | (h[4] >> 4)
+        calib["H6"] = struct.unpack("b", h[6:7])[0]
+        self._calib = calib
+
+    # ─── Measurement ────────────────────────────────────────────────────────
+
+    def read(self) -> tuple:
+        """Return (temperature °F, pressure hPa, humidity %) from one forced measurement."""
+        ctrl_meas = (
+            self.OVERSAMPLING_CODES[self._osrs["temperature"]] << 5
+            | self.OVERSAMPLING_CODES[self._osrs["pressure"]] << 2
+            | self.MODE_FORCED
+        )
+        start = time.monotonic()
+        self._bus.write_byte_data(self._address, self.REG_CTRL_MEAS, ctrl_meas)
+
+        # Sleep through the typical time, then poll the measuring bit
+        sleep(self._measurement_time_ms(maximum=False) / 1000.0)
+        deadline = start + 2 * self.max_measurement_ms / 1000.0
+        while self._bus.read_byte_data(self._address, self.REG_STATUS) & self.STATUS_MEASURING:
+            if time.monotonic() > deadline:
+                raise TimeoutError("BME280 measurement did not finish")
+            sleep(0.0005)
+        self.measurement_ms = (time.monotonic() - start) * 1000.0
+
+        data = self._bus.read_i2c_block_data(self._address, self.REG_DATA, 8)
+        temp_c, pressure, humidity = self._compensate(data)
+        values = (c_to_f(temp_c), pressure, humidity)
+        if self._report_timing:
+            values += (self.measurement_ms,)
+        return values
+
+    def _compensate(self, data) -> tuple[float, float | None, float | None]:
+        """Datasheet floating-point compensation (section 8.1) of one burst."""
+        c = self._calib
+        adc_p = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4)
+        adc_t = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4)
+        adc_h = (data[6] << 8) | data[7]
+
+        var1 = (adc_t / 16384.0 - c["T1"] / 1024.0) * c["T2"]
+        var2 = ((adc_t / 131072.0 - c["T1"] / 8192.0) ** 2) * c["T3"]
+        t_fine = var1 + var2
+        temp_c = t_fine / 5120.0
+
+        pressure = None
+        if self._osrs["pressure"]:
+            var1 = t_fine / 2.0 - 64000.0
+            var2 = var1 * var1 * c["P6"] / 32768.0
+            var2 = var2 + var1 * c["P5"] * 2.0
+            var2 = var2 / 4.0 + c["P4"] * 65536.0
+            var1 = (c["P3"] * var1 * var1 / 524288.0 + c["P2"] * var1) / 524288.0
+            var1 = (1.0 + var1 / 32768.0) * c["P1"]
+            if var1 != 0:
+                p = 1048576.0 - adc_p
+                p = (p - var2 / 4096.0) * 6250.0 / var1
+                var1 = c["P9"] * p * p / 2147483648.0
+                var2 = p * c["P8"] / 32768.0
+                pressure = (p + (var1 + var2 + c["P7"]) / 16.0) / 100.0  # Pa -> hPa
 
-        self._bus = SMBus(self._smbus)
-        self._bme = BME280(i2c_dev=self._bus)
-        # Flush the first junk reading
-        self._bme.get_temperature()
-        sleep(1.0)
+        humidity = None
+        if self._osrs["humidity"]:
+            h = t_fine - 76800.0
+            h = (adc_h - (c["H4"] * 64.0 + c["H5"] / 16384.0 * h)) * (
+                c["H2"] / 65536.0 * (
+                    1.0 + c["H6"] / 67108864.0 * h * (1.0 + c["H3"] / 67108864.0 * h)
+                )
+            )
+            h = h * (1.0 - c["H1"] * h / 524288.0)
+            humidity = min(100.0, max(0.0, h))
 
-    def read(self) -> tuple[float, float, float]:
-        temp = c_to_f(self._bme.get_temperature())
-        pressure = self._bme.get_pressure()
-        humidity = self._bme.get_humidity()
-        return (temp, pressure, humidity)
+        return temp_c, pressure, humidity
 
     def get_names(self) -> tuple[str, ...]:
-        return ("Temperature", "Pressure", "Humidity")
+        names = ("Temperature", "Pressure", "Humidity")
+        return names + ("Measure Time",) if self._report_timing else names
 
     def get_units(self) -> tuple[str, ...]:
-        return ("°F", "hPa", "%")
+        units = ("°F", "hPa", "%")
+        return units + ("ms",) if self._report_timing else units
 
     def close(self) -> None:
         if self._bus:
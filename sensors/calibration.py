@@ -0,0 +1,302 @@
+"""
+Per-reading calibration pipelines.
+
+A sensor entry's "calibration" maps reading names to one step or a list of
+steps, applied in order:
+
+    "calibration": {
+        "Pressure": {"type": "linear", "scale": 1.002, "offset": -0.8},
+        "A0": [
+            {"type": "table", "points": [[0.5, 0], [1.2, 20], [2.9, 100]]},
+            {"type": "temperature", "reading": "A1", "coeff": -0.4, "ref": 25.0}
+        ]
+    }
+
+Step types:
+    linear       x * scale + offset
+    poly         coeffs[0] + coeffs[1]*x + coeffs[2]*x^2 + ... (Horner)
+    table        Piecewise-linear through [raw, value] points (clamped at the ends)
+    normalize    Clip to [raw_min, raw_max] and scale to 0-1 (optional invert)
+    temperature  Compensate against another reading of the same sensor:
+                 "offset" mode adds coeff * (T - ref), "scale" mode multiplies
+                 by 1 + coeff * (T - ref)
+
+The config is validated and compiled once (Sensor.set_calibration) into step
+objects per column. apply() calibrates one reading in plain Python (no numpy
+import on the per-reading path); apply_batch() calibrates a whole window of
+samples column-at-a-time with numpy when it is installed, so a high-rate
+capture costs a few array operations per window rather than a Python loop
+per sample.
+
+A temperature step uses the referenced reading's calibrated value; that
+reading can't itself be temperature-compensated. A None (skipped) value
+stays None, and so does a compensated value whose temperature is None.
+
+Classes:
+    CalibrationPipeline: Compiled steps for a sensor's readings
+
+Functions:
+    compile_step: Validate one step config
+    as_step_list: A reading's config as a list of steps
+"""
+
+from __future__ import annotations
+
+import bisect
+from dataclasses import dataclass
+
+from .base import transform_value
+
+
+def _numpy():
+    """numpy module, or None where it isn't installed."""
+    try:
+        import numpy
+    except ImportError:
+        return None
+    return numpy
+
+
+# ─── Steps ──────────────────────────────────────────────────────────────────
+#
+# Each step's apply() works on a float and, where the arithmetic is the same,
+# on a numpy column; apply_array() is only overridden where it isn't.
+
+
+@dataclass(frozen=True)
+class Linear:
+    scale: float = 1.0
+    offset: float = 0.0
+
+    def apply(self, x, temperature=None):
+        return x * self.scale + self.offset
+
+    def apply_array(self, x, temperature, np):
+        return self.apply(x)
+
+
+@dataclass(frozen=True)
+class Polynomial:
+    coeffs: tuple[float, ...]  # Ascending powers
+
+    def apply(self, x, temperature=None):
+        result = 0.0
+        for c in reversed(self.coeffs):
+            result = result * x + c
+        return result
+
+    def apply_array(self, x, temperature, np):
+        return self.apply(x)
+
+
+@dataclass(frozen=True)
+class Table:
+    raw: tuple[float, ...]
+    values: tuple[float, ...]
+
+    def apply(self, x, temperature=None):
+        raw, values = self.raw, self.values
+        if x <= raw[0]:
+            return values[0]
+        if x >= raw[-1]:
+            return values[-1]
+        i = bisect.bisect_right(raw, x)
+        frac = (x - raw[i - 1]) / (raw[i] - raw[i - 1])
+        return values[i - 1] + frac * (values[i] - values[i - 1])
+
+    def apply_array(self, x, temperature, np):
+        return np.interp(x, self.raw, self.values)
+
+
+@dataclass(frozen=True)
+class Normalize:
+    raw_min: float
+    raw_max: float
+    invert: bool = False
+
+    def apply(self, x, temperature=None):
+        return transform_value(x, self.raw_min, self.raw_max, self.invert)
+
+    def apply_array(self, x, temperature, np):
+        normalized = (np.clip(x, self.raw_min, self.raw_max) - self.raw_min) / (
+            self.raw_max - self.raw_min
+        )
+        return 1.0 - normalized if self.invert else normalized
+
+
+@dataclass(frozen=True)
+class TemperatureComp:
+    reading: str
+    coeff: float
+    ref: float = 25.0
+    scale: bool = False  # Multiplicative instead of additive
+
+    def apply(self, x, temperature=None):
+        if temperature is None:
+            return None
+        delta = self.coeff * (temperature - self.ref)
+        return x * (1.0 + delta) if self.scale else x + delta
+
+    def apply_array(self, x, temperature, np):
+        delta = self.coeff * (temperature - self.ref)
+        return x * (1.0 + delta) if self.scale else x + delta
+
+
+def _number(config: dict, key: str, default: float | None = None) -> float:
+    value = config.get(key, default)
+    if not isinstance(value, (int, float)) or isinstance(value, bool):
+        raise ValueError(f"calibration {config.get('type')!r}: {key} must be a number")
+    return float(value)
+
+
+def compile_step(config: dict):
+    """
+    Validate one step config and build its step object.
+
+    Raises:
+        ValueError: Unknown type or bad parameters
+    """
+    kind = config.get("type")
+    if kind == "linear":
+        return Linear(_number(config, "scale", 1.0), _number(config, "offset", 0.0))
+    if kind == "poly":
+        coeffs = config.get("coeffs")
+        if not coeffs or not all(isinstance(c, (int, float)) for c in coeffs):
+            raise ValueError("calibration 'poly': coeffs must be a non-empty list of numbers")
+        return Polynomial(tuple(float(c) for c in coeffs))
+    if kind == "table":
+        points = config.get("points") or []
+        if len(points) < 2 or any(len(p) != 2 for p in points):
+            raise ValueError("calibration 'table': points needs at least two [raw, value] pairs")
+        raw, values = zip(*sorted((float(r), float(v)) for r, v in points))
+        if any(b <= a for a, b in zip(raw, raw[1:])):
+            raise ValueError("calibration 'table': raw values must be distinct")
+        return Table(raw, values)
+    if kind == "normalize":
+        raw_min = _number(config, "raw_min")
+        raw_max = _number(config, "raw_max")
+        if raw_min >= raw_max:
+            raise ValueError(
+                f"calibration 'normalize': raw_min ({raw_min}) must be less than "
+                f"raw_max ({raw_max})"
+            )
+        return Normalize(raw_min, raw_max, bool(config.get("invert", False)))
+    if kind == "temperature":
+        reading = config.get("reading")
+        if not reading:
+            raise ValueError("calibration 'temperature': reading is required")
+        mode = config.get("mode", "offset")
+        if mode not in ("offset", "scale"):
+            raise ValueError("calibration 'temperature': mode must be 'offset' or 'scale'")
+        return TemperatureComp(
+            reading, _number(config, "coeff"), _number(config, "ref", 25.0), mode == "scale"
+        )
+    raise ValueError(
+        f"Unknown calibration type {kind!r}; valid: linear, poly, table, normalize, temperature"
+    )
+
+
+def as_step_list(spec: dict | list[dict]) -> list[dict]:
+    """A reading's config as a list of step configs."""
+    return list(spec) if isinstance(spec, (list, tuple)) else [spec]
+
+
+# ─── Pipeline ───────────────────────────────────────────────────────────────
+
+
+class CalibrationPipeline:
+    """
+    Compiled calibration for one sensor's readings.
+
+    Built with compile(); columns without steps pass through unchanged.
+    """
+
+    def __init__(self, names: tuple[str, ...], steps: dict[int, list]):
+        self.names = names
+        self._steps = steps
+        # Temperature-compensated columns run after the columns they reference
+        self._refs: dict[int, int] = {}
+        for col, col_steps in steps.items():
+            for step in col_steps:
+                if isinstance(step, TemperatureComp):
+                    self._refs[col] = names.index(step.reading)
+        self._order = sorted(steps, key=lambda col: col in self._refs)
+
+    @classmethod
+    def compile(
+        cls, config: dict[str, dict | list[dict]], names: tuple[str, ...]
+    ) -> CalibrationPipeline:
+        """
+        Validate a {reading name: step(s)} config against the sensor's names.
+
+        Raises:
+            ValueError: Unknown reading or step, bad parameters, or a
+                temperature reference that can't be resolved
+        """
+        names = tuple(names)
+        steps: dict[int, list] = {}
+        for name, spec in config.items():
+            if name not in names:
+                raise ValueError(f"calibration for unknown reading {name!r}; readings: {names}")
+            steps[names.index(name)] = [compile_step(s) for s in as_step_list(spec)]
+
+        compensated = {
+            col for col, col_steps in steps.items()
+            if any(isinstance(s, TemperatureComp) for s in col_steps)
+        }
+        for col in compensated:
+            temp_steps = [s for s in steps[col] if isinstance(s, TemperatureComp)]
+            if len(temp_steps) > 1:
+                raise ValueError(f"{names[col]}: at most one temperature step per reading")
+            for step in temp_steps:
+                if step.reading not in names:
+                    raise ValueError(
+                        f"{names[col]}: temperature reading {step.reading!r} not in {names}"
+                    )
+                if names.index(step.reading) in compensated:
+                    raise ValueError(
+                        f"{names[col]}: temperature reading {step.reading!r} is itself "
+                        f"temperature-compensated"
+                    )
+        return cls(names, steps)
+
+    @property
+    def readings(self) -> tuple[str, ...]:
+        """Names of the calibrated readings."""
+        return tuple(self.names[col] for col in sorted(self._steps))
+
+    def apply(self, values: tuple) -> tuple:
+        """Calibrate one reading's values."""
+        result = list(values)
+        for col in self._order:
+            x = result[col]
+            if x is None:
+                continue
+            temperature = result[self._refs[col]] if col in self._refs else None
+            for step in self._steps[col]:
+                x = step.apply(x, temperature)
+                if x is None:
+                    break
+            result[col] = x
+        return tuple(result)
+
+    def apply_batch(self, samples):
+        """
+        Calibrate a window of samples, shape (n, len(names)).
+
+        Returns a float64 array (None read as NaN) with numpy, or a list of
+        tuples without it.
+        """
+        np = _numpy()
+        if np is None:
+            return [self.apply(tuple(row)) for row in samples]
+        x = np.array(samples, dtype=np.float64)
+        if x.ndim != 2 or x.shape[1] != len(self.names):
+            raise ValueError(f"expected shape (n, {len(self.names)}), got {x.shape}")
+        for col in self._order:
+            column = x[:, col]
+            temperature = x[:, self._refs[col]] if col in self._refs else None
+            for step in self._steps[col]:
+                column = step.apply_array(column, temperature, np)
+            x[:, col] = column
+        return x
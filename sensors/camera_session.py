@@ -0,0 +1,216 @@
+"""
+Long-lived Picamera2 session for fast Arducam captures.
+
+Opening the camera, configuring it and letting auto-exposure settle takes
+over 2 s, which capture_image() used to pay on every shot. A CameraSession
+opens the camera once and keeps it streaming a small preview, so AE/AWB
+stay converged. A still (or an ROI crop of one) is a mode switch and one
+frame, and the 180° flip is done by the ISP transform instead of
+re-encoding the JPEG. The camera is released after idle_timeout_sec
+without a capture and reopened on the next one.
+
+    "arducam": {"enabled": true, "size": "4056x3040", "flip": true,
+                "warm": true, "idle_timeout_sec": 300}
+
+Requires picamera2 (python3-picamera2), imported on first open.
+
+Classes:
+    CameraSession: Warm camera with on-demand stills and ROI crops
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from pathlib import Path
+
+logger = logging.getLogger(__name__)
+
+
+def parse_size(size: str | tuple[int, int]) -> tuple[int, int]:
+    """Parse a "WxH" size string (or a pair) into (width, height)."""
+    if isinstance(size, str):
+        width, _, height = size.partition("x")
+        return (int(width), int(height))
+    return (int(size[0]), int(size[1]))
+
+
+class CameraSession:
+    """
+    Warm Picamera2 session.
+
+    Thread-safe: captures are serialized, and the idle release waits for a
+    capture in progress.
+    """
+
+    def __init__(
+        self,
+        size: str | tuple[int, int] = (4056, 3040),
+        flip: bool = True,
+        preview_size: str | tuple[int, int] = (640, 480),
+        idle_timeout_sec: float | None = 300.0,
+        settle_timeout_sec: float = 2.0,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            size: Still resolution
+            flip: Rotate 180° (ISP transform; applies to stills and ROIs)
+            preview_size: Resolution streamed between captures
+            idle_timeout_sec: Release the camera after this long unused (None/0 = never)
+            settle_timeout_sec: Longest wait for AE/AWB to converge after opening
+            clock: Time source for the idle timeout
+        """
+        self._size = parse_size(size)
+        self._preview_size = parse_size(preview_size)
+        self._flip = flip
+        self._idle_timeout = idle_timeout_sec or None
+        self._settle_timeout = settle_timeout_sec
+        self._clock = clock
+        self._lock = threading.Lock()
+        self._camera = None
+        self._still_config = None
+        self._last_used = 0.0
+        self._watcher: threading.Thread | None = None
+        self._closed = threading.Event()
+        self.opens = 0
+        self.captures = 0
+
+    @classmethod
+    def from_config(cls, config: dict) -> CameraSession:
+        """Session from the node config's "arducam" section."""
+        return cls(
+            size=config.get("size", "4056x3040"),
+            flip=config.get("flip", True),
+            preview_size=config.get("preview_size", "640x480"),
+            idle_timeout_sec=config.get("idle_timeout_sec", 300.0),
+            settle_timeout_sec=config.get("settle_timeout_sec", 2.0),
+        )
+
+    @property
+    def is_open(self) -> bool:
+        return self._camera is not None
+
+    def __enter__(self) -> CameraSession:
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    # ─── Camera Lifecycle ───────────────────────────────────────────────
+
+    def open(self) -> None:
+        """Open the camera now instead of on the first capture."""
+        with self._lock:
+            if self._camera is None:
+                self._open()
+                self._last_used = self._clock()
+
+    def _open(self) -> None:
+        """Open, start the preview stream and wait for AE/AWB (lock held)."""
+        from libcamera import Transform
+        from picamera2 import Picamera2
+
+        start = time.monotonic()
+        transform = Transform(hflip=self._flip, vflip=self._flip)
+        camera = Picamera2()
+        try:
+            preview = camera.create_preview_configuration(
+                main={"size": self._preview_size}, transform=transform, buffer_count=2
+            )
+            # RGB888 arrays are BGR in memory, as OpenCV expects
+            self._still_config = camera.create_still_configuration(
+                main={"size": self._size, "format": "RGB888"},
+                transform=transform,
+                buffer_count=1,
+            )
+            camera.configure(preview)
+            camera.start()
+            self._wait_for_convergence(camera)
+        except Exception:
+            camera.close()
+            raise
+        self._camera = camera
+        self.opens += 1
+        logger.info(
+            f"Camera session open: preview {self._preview_size}, stills {self._size} "
+            f"({time.monotonic() - start:.2f}s)"
+        )
+
+        self._closed.clear()
+        if self._idle_timeout and (self._watcher is None or not self._watcher.is_alive()):
+            self._watcher = threading.Thread(
+                target=self._watch_idle, daemon=True, name="CameraIdle"
+            )
+            self._watcher.start()
+
+    def _wait_for_convergence(self, camera) -> None:
+        deadline = time.monotonic() + self._settle_timeout
+        while time.monotonic() < deadline:
+            metadata = camera.capture_metadata()
+            # Older libcamera reports AeLocked, newer AeState (2 = converged)
+            if metadata.get("AeLocked") or metadata.get("AeState") == 2:
+                return
+        logger.debug("Camera AE not converged within settle timeout; capturing anyway")
+
+    def _release(self) -> None:
+        """Stop and close the camera (lock held)."""
+        if self._camera is None:
+            return
+        try:
+            self._camera.stop()
+        finally:
+            self._camera.close()
+            self._camera = None
+
+    def _watch_idle(self) -> None:
+        while not self._closed.wait(min(self._idle_timeout / 4, 5.0)):
+            with self._lock:
+                if self._camera is None:
+                    return
+                if self._clock() - self._last_used >= self._idle_timeout:
+                    logger.info(f"Camera idle for {self._idle_timeout:.0f}s, releasing")
+                    self._release()
+                    return
+
+    def _ready_camera(self):
+        """Open if needed and mark the session used (lock held)."""
+        if self._camera is None:
+            self._open()
+        self._last_used = self._clock()
+        self.captures += 1
+        return self._camera
+
+    # ─── Captures ───────────────────────────────────────────────────────
+
+    def capture_file(self, output_path: Path | str) -> Path:
+        """Capture a full-resolution still to output_path (JPEG/PNG by suffix)."""
+        output_path = Path(output_path)
+        with self._lock:
+            camera = self._ready_camera()
+            camera.switch_mode_and_capture_file(self._still_config, str(output_path))
+        return output_path
+
+    def capture_array(self, roi: tuple[int, int, int, int] | None = None):
+        """
+        Capture a full-resolution still as an array, or only the (x, y, w, h) ROI of it.
+
+        ROI coordinates are in the (flipped) output frame, like the saved stills.
+        """
+        with self._lock:
+            camera = self._ready_camera()
+            frame = camera.switch_mode_and_capture_array(self._still_config, "main")
+        if roi is None:
+            return frame
+        x, y, w, h = roi
+        # Copy so the full frame isn't kept alive by the view
+        return frame[y:y + h, x:x + w].copy()
+
+    def close(self) -> None:
+        self._closed.set()
+        with self._lock:
+            self._release()
+        if self._watcher is not None:
+            self._watcher.join(timeout=1.0)
+            self._watcher = None
@@ -0,0 +1,188 @@
+"""
+ROI tracking and change gating for repeated display OCR.
+
+A meter read over and over doesn't move, and mostly doesn't change, so
+DisplayTracker avoids the two expensive steps where it can:
+
+    - Detection: the display box found by a full-frame search is kept. On
+      each capture it is only confirmed by searching a window around it
+      (margin x its size on each side); the box found there replaces it if
+      it overlaps the old one (IoU >= min_iou). Only when that fails is the
+      whole frame searched again.
+    - Recognition: the box is reduced to a small thumbnail (block means,
+      contrast-normalized so auto-exposure drift doesn't count). If no cell
+      differs from the last recognized thumbnail by more than
+      change_threshold of the contrast range, the last result is reused
+      without running OCR.
+
+The detector and recognizer are passed in (sensors.arducam wires up
+detect_display and run_ocr), so this module needs only numpy.
+
+Classes:
+    TrackerStats: Counters for each path taken
+    DisplayTracker: Tracked ROI and gated OCR for one display
+
+Functions:
+    iou: Intersection over union of two boxes
+    thumbnail: Contrast-normalized block-mean thumbnail of an image
+"""
+
+from __future__ import annotations
+
+import logging
+from dataclasses import dataclass
+from typing import Callable
+
+import numpy as np
+
+logger = logging.getLogger(__name__)
+
+Box = tuple[int, int, int, int]  # x, y, w, h
+
+
+def iou(a: Box, b: Box) -> float:
+    """Intersection over union of two (x, y, w, h) boxes."""
+    ix = max(0, min(a[0] + a[2], b[0] + b[2]) - max(a[0], b[0]))
+    iy = max(0, min(a[1] + a[3], b[1] + b[3]) - max(a[1], b[1]))
+    inter = ix * iy
+    union = a[2] * a[3] + b[2] * b[3] - inter
+    return inter / union if union else 0.0
+
+
+def thumbnail(image: np.ndarray, columns: int = 32, rows: int | None = None) -> np.ndarray:
+    """
+    Block-mean thumbnail, scaled to 0-1 over its own range.
+
+    Args:
+        image: Gray or color (channels averaged) image
+        columns: Thumbnail width in cells
+        rows: Thumbnail height in cells (default: keeps the image's aspect)
+    """
+    gray = image.mean(axis=2) if image.ndim == 3 else image.astype(np.float64)
+    height, width = gray.shape
+    columns = min(columns, width)
+    if rows is None:
+        rows = max(1, round(columns * height / width))
+    rows = min(rows, height)
+    # Uneven cell edges, so a box a pixel larger still gives the same grid
+    row_edges = np.linspace(0, height, rows + 1).astype(int)
+    col_edges = np.linspace(0, width, columns + 1).astype(int)
+    sums = np.add.reduceat(np.add.reduceat(gray, row_edges[:-1], axis=0), col_edges[:-1], axis=1)
+    blocks = sums / np.outer(np.diff(row_edges), np.diff(col_edges))
+    low, high = blocks.min(), blocks.max()
+    if high - low < 1e-9:
+        return np.zeros_like(blocks)
+    return (blocks - low) / (high - low)
+
+
+@dataclass
+class TrackerStats:
+    """How each read() was served."""
+
+    detections: int = 0  # Full-frame searches
+    tracked: int = 0  # Box confirmed by the local search
+    recognitions: int = 0  # OCR runs
+    skipped: int = 0  # Unchanged display, last result reused
+
+
+class DisplayTracker:
+    """Reads one display from repeated captures, detecting and recognizing only when needed."""
+
+    def __init__(
+        self,
+        detect: Callable[[np.ndarray], list[Box]],
+        recognize: Callable[[np.ndarray, Box], str | None],
+        detect_local: Callable[[np.ndarray], list[Box]] | None = None,
+        margin: float = 0.5,
+        min_iou: float = 0.5,
+        change_threshold: float = 0.2,
+        columns: int = 32,
+    ):
+        """
+        Args:
+            detect: Full-frame display search; candidate boxes, best first
+            recognize: OCR of the display at a box in the image
+            detect_local: Search used in the window around the cached box
+                (default: detect); it sees a window mostly filled by the display
+            margin: Window size around the cached box, as a fraction of its size per side
+            min_iou: Overlap with the cached box for a local match to count
+            change_threshold: Thumbnail cell change (0-1 of contrast) that counts as changed
+            columns: Thumbnail width in cells
+        """
+        self._detect = detect
+        self._detect_local = detect_local or detect
+        self._recognize = recognize
+        self._margin = margin
+        self._min_iou = min_iou
+        self._change_threshold = change_threshold
+        self._columns = columns
+        self.roi: Box | None = None
+        self.result: str | None = None
+        self._thumb: np.ndarray | None = None
+        self.stats = TrackerStats()
+
+    def reset(self) -> None:
+        """Forget the box and last result; the next read searches the whole frame."""
+        self.roi = None
+        self.result = None
+        self._thumb = None
+
+    def read(self, image: np.ndarray) -> str | None:
+        """OCR result for the display in image (None if not found or not recognized)."""
+        if self.locate(image) is None:
+            return None
+        return self.recognize(image)
+
+    def locate(self, image: np.ndarray) -> Box | None:
+        """Confirm or re-detect the display box in image; None (and reset) if not found."""
+        if self.roi is not None:
+            tracked = self._search_near(image, self.roi)
+            if tracked is not None:
+                self.stats.tracked += 1
+                self.roi = tracked
+                return tracked
+            logger.info(f"Display not found near {self.roi}, searching the whole frame")
+
+        self.stats.detections += 1
+        candidates = self._detect(image)
+        if not candidates:
+            self.reset()
+            return None
+        self.roi = tuple(candidates[0])
+        return self.roi
+
+    def recognize(self, image: np.ndarray) -> str | None:
+        """OCR of the located display, or the last result if it hasn't changed."""
+        if self.roi is None:
+            raise RuntimeError("No display located; call locate() first")
+        x, y, w, h = self.roi
+        rows = self._thumb.shape[0] if self._thumb is not None else None
+        thumb = thumbnail(image[y:y + h, x:x + w], self._columns, rows)
+        if (
+            self._thumb is not None
+            and thumb.shape == self._thumb.shape
+            and np.abs(thumb - self._thumb).max() <= self._change_threshold
+        ):
+            self.stats.skipped += 1
+            return self.result
+
+        self.stats.recognitions += 1
+        self.result = self._recognize(image, self.roi)
+        self._thumb = thumb
+        return self.result
+
+    def _search_near(self, image: np.ndarray, roi: Box) -> Box | None:
+        x, y, w, h = roi
+        height, width = image.shape[:2]
+        left = max(0, int(x - w * self._margin))
+        top = max(0, int(y - h * self._margin))
+        right = min(width, int(x + w * (1 + self._margin)))
+        bottom = min(height, int(y + h * (1 + self._margin)))
+
+        best, best_iou = None, self._min_iou
+        for cx, cy, cw, ch in self._detect_local(image[top:bottom, left:right]):
+            box = (cx + left, cy + top, cw, ch)
+            overlap = iou(box, roi)
+            if overlap >= best_iou:
+                best, best_iou = box, overlap
+        return best
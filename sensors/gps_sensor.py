@@ -0,0 +1,270 @@
+"""
+GPS sensor (GT-U7 / u-blox NMEA over UART).
+
+A background thread reads the UART in whatever chunks are waiting and feeds
+them to an incremental NMEA parser; read() only copies the latest fix out
+of a lock-protected snapshot, so it never waits on the serial port:
+
+    {"class": "GPSSensor", "interval_sec": 30,
+     "config": {"port": "/dev/serial0", "baud": 9600, "stale_after_sec": 10}}
+
+Readings are Latitude/Longitude (decimal degrees), Altitude (m above mean
+sea level), Satellites (in use) and Fix Age (seconds since the last valid
+fix). Before the first fix, or once the fix is older than stale_after_sec,
+the position readings are None; Satellites and Fix Age are still reported.
+
+GGA and RMC sentences from any talker (GP, GN, GL, ...) are used; others
+are skipped after the checksum. Lines are split on bytes and fields decoded
+in place, with no regex or per-line string decoding.
+
+Classes:
+    GPSFix: Immutable fix snapshot
+    NMEAParser: Incremental GGA/RMC parser over raw UART bytes
+    GPSReader: UART reader thread
+    GPSSensor: Sensor driver
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from dataclasses import dataclass, replace
+
+from utils.log_throttle import log_throttled
+
+from .base import Sensor
+
+logger = logging.getLogger(__name__)
+
+
+@dataclass(frozen=True)
+class GPSFix:
+    """Latest position; fix_time is the parser clock's time of the last valid fix."""
+
+    latitude: float | None = None
+    longitude: float | None = None
+    altitude: float | None = None
+    satellites: int = 0
+    quality: int = 0
+    fix_time: float | None = None
+
+
+def _nmea_coord(value: bytes, hemisphere: bytes) -> float | None:
+    """(d)ddmm.mmmm plus N/S/E/W -> signed decimal degrees."""
+    if not value:
+        return None
+    raw = float(value)
+    degrees = int(raw // 100)
+    coord = degrees + (raw - degrees * 100) / 60.0
+    return -coord if hemisphere in (b"S", b"W") else coord
+
+
+class NMEAParser:
+    """
+    Incremental NMEA parser.
+
+    feed() takes raw bytes as they arrive; partial sentences are kept until
+    the rest comes in. `fix` is replaced (never mutated) when a sentence
+    changes it.
+    """
+
+    MAX_LINE = 120  # NMEA allows 82; anything longer is line noise
+
+    def __init__(self, clock=time.monotonic):
+        self._clock = clock
+        self._buffer = bytearray()
+        self.fix = GPSFix()
+        self.sentences = 0
+        self.checksum_errors = 0
+
+    def feed(self, data: bytes) -> bool:
+        """Parse whatever complete sentences data completes; True if the fix changed."""
+        buffer = self._buffer
+        buffer += data
+        changed = False
+        start = 0
+        while True:
+            end = buffer.find(b"\n", start)
+            if end < 0:
+                break
+            changed |= self._sentence(bytes(buffer[start:end]).rstrip(b"\r"))
+            start = end + 1
+        del buffer[:start]
+        if len(buffer) > self.MAX_LINE:
+            buffer.clear()
+        return changed
+
+    def _sentence(self, line: bytes) -> bool:
+        dollar = line.find(b"$")
+        star = line.rfind(b"*")
+        if dollar < 0 or star < dollar:
+            return False
+        checksum = 0
+        for byte in line[dollar + 1:star]:
+            checksum ^= byte
+        try:
+            valid = int(line[star + 1:star + 3], 16) == checksum
+        except ValueError:
+            valid = False
+        if not valid:
+            self.checksum_errors += 1
+            return False
+        self.sentences += 1
+
+        fields = line[dollar + 1:star].split(b",")
+        kind = fields[0][-3:]
+        try:
+            if kind == b"GGA" and len(fields) >= 10:
+                return self._gga(fields)
+            if kind == b"RMC" and len(fields) >= 7:
+                return self._rmc(fields)
+        except ValueError:
+            # Checksum passed but a field is garbled; keep the previous fix
+            self.checksum_errors += 1
+        return False
+
+    def _gga(self, f: list[bytes]) -> bool:
+        # $xxGGA,time,lat,N,lon,E,quality,sats,hdop,alt,M,...
+        quality = int(f[6]) if f[6] else 0
+        satellites = int(f[7]) if f[7] else 0
+        if quality == 0:
+            fix = replace(self.fix, quality=0, satellites=satellites)
+        else:
+            fix = GPSFix(
+                latitude=_nmea_coord(f[2], f[3]),
+                longitude=_nmea_coord(f[4], f[5]),
+                altitude=float(f[9]) if f[9] else None,
+                satellites=satellites,
+                quality=quality,
+                fix_time=self._clock(),
+            )
+        if fix == self.fix:
+            return False
+        self.fix = fix
+        return True
+
+    def _rmc(self, f: list[bytes]) -> bool:
+        # $xxRMC,time,status,lat,N,lon,E,...; status A = valid, V = no fix
+        if f[2] != b"A" or not f[3]:
+            return False
+        self.fix = replace(
+            self.fix,
+            latitude=_nmea_coord(f[3], f[4]),
+            longitude=_nmea_coord(f[5], f[6]),
+            fix_time=self._clock(),
+        )
+        return True
+
+
+class GPSReader(threading.Thread):
+    """Reads the UART and publishes each changed fix to on_fix."""
+
+    def __init__(self, serial_port, parser: NMEAParser, on_fix, name: str = "GPSReader"):
+        super().__init__(daemon=True, name=name)
+        self._serial = serial_port
+        self._parser = parser
+        self._on_fix = on_fix
+        self._running = True
+        self.errors = 0
+
+    def run(self) -> None:
+        while self._running:
+            try:
+                # Blocks for at most the port timeout when nothing is waiting
+                data = self._serial.read(self._serial.in_waiting or 1)
+            except (OSError, TypeError) as e:
+                # pyserial raises SerialException (an OSError) or TypeError on a
+                # port closed underneath it
+                if not self._running:
+                    break
+                self.errors += 1
+                log_throttled(
+                    logger, logging.WARNING, self.errors,
+                    f"{self.name}: read failed (#{self.errors}): {e}",
+                )
+                time.sleep(1.0)
+                continue
+            if data and self._parser.feed(data):
+                self._on_fix(self._parser.fix)
+
+    def stop(self) -> None:
+        self._running = False
+
+
+class GPSSensor(Sensor):
+    """Non-blocking driver for a NMEA GPS module on a UART."""
+
+    def __init__(
+        self,
+        port: str = "/dev/serial0",
+        baud: int = 9600,
+        stale_after_sec: float = 10.0,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            port: Serial device
+            baud: Baud rate (GT-U7 default 9600)
+            stale_after_sec: Fix age after which the position reads as None
+            clock: Time source for fix ages
+        """
+        self._port = port
+        self._baud = baud
+        self._stale_after = stale_after_sec
+        self._clock = clock
+        self._serial = None
+        self._reader: GPSReader | None = None
+        self._lock = threading.Lock()
+        self._fix = GPSFix()
+
+    def init(self) -> None:
+        import serial
+
+        # Timeout bounds the reader's blocking read, so close() can join it
+        self._serial = serial.Serial(self._port, self._baud, timeout=0.5)
+        self._reader = GPSReader(self._serial, NMEAParser(self._clock), self._publish)
+        self._reader.start()
+        logger.info(f"GPS reader started on {self._port} at {self._baud} baud")
+
+    def _publish(self, fix: GPSFix) -> None:
+        with self._lock:
+            self._fix = fix
+
+    @property
+    def fix(self) -> GPSFix:
+        """Latest fix snapshot."""
+        with self._lock:
+            return self._fix
+
+    def read(self) -> tuple:
+        """Return (lat, lon, alt, sats, fix age) from the latest fix; never blocks on the UART."""
+        if self._reader is None:
+            raise RuntimeError("GPSSensor not initialized. Call init() first.")
+        with self._lock:
+            fix = self._fix
+        if fix.fix_time is None:
+            return (None, None, None, fix.satellites, None)
+        age = self._clock() - fix.fix_time
+        if age > self._stale_after:
+            return (None, None, None, fix.satellites, age)
+        return (fix.latitude, fix.longitude, fix.altitude, fix.satellites, age)
+
+    def get_names(self) -> tuple[str, ...]:
+        return ("Latitude", "Longitude", "Altitude", "Satellites", "Fix Age")
+
+    def get_units(self) -> tuple[str, ...]:
+        return ("°", "°", "m", "", "s")
+
+    def get_precision(self) -> int:
+        # ~0.1 m at the equator
+        return 6
+
+    def close(self) -> None:
+        if self._reader is not None:
+            self._reader.stop()
+            self._reader.join(timeout=2.0)
+            self._reader = None
+        if self._serial is not None:
+            self._serial.close()
+            self._serial = None
@@ -1,8 +1,36 @@
-"""MMA8452 3-axis accelerometer sensor."""
+"""
+MMA8452 3-axis accelerometer sensor.
 
+By default read() returns one (x, y, z) sample. With capture_hz set, a
+background thread samples continuously at that output data rate and read()
+returns vibration features of the latest window instead (sensors.vibration):
+
+    {"class": "MMA8452Accelerometer", "interval_sec": 60,
+     "config": {"capture_hz": 400, "window_sec": 2.0,
+                "bands_hz": [[1, 10], [10, 50], [50, 100], [100, 200]]}}
+
+The MMA8452Q has no FIFO (that is the MMA8451), so each sample is one
+7-byte burst read of STATUS plus the output registers, polled on the
+data-ready bit. Overruns (samples the poller missed) are counted in
+`overruns` and logged. The capture thread goes through the node's shared
+I2C bus (utils.i2c_bus), whose FIFO lock keeps it from starving other
+devices on the bus.
+
+In capture mode, calibration steps for "Accel X/Y/Z" are applied to each
+window's raw samples in one batch before the features are computed.
+"""
+
+import logging
 from time import sleep
 
+from utils.i2c_bus import get_bus
+from utils.log_throttle import log_throttled
+
 from .base import Sensor
+from .calibration import CalibrationPipeline
+from .vibration import DEFAULT_BANDS_HZ, BurstCapture, feature_names, feature_units
+
+logger = logging.getLogger(__name__)
 
 
 class MMA8452Accelerometer(Sensor):
@@ -18,27 +46,57 @@ class MMA8452Accelerometer(Sensor):
     REG_XYZ_DATA_CFG = 0x0E
     REG_CTRL_REG1 = 0x2A
 
+    # STATUS bits
+    STATUS_ZYXDR = 0x08  # New X/Y/Z sample ready
+    STATUS_ZYXOW = 0x80  # Sample overwritten before it was read
+
+    # CTRL_REG1 output data rate (DR bits 5:3)
+    ODR_BITS = {800: 0, 400: 1, 200: 2, 100: 3, 50: 4, 12.5: 5, 6.25: 6, 1.56: 7}
+
     # Device ID
     DEVICE_ID = 0x2A
 
+    AXIS_NAMES = ("Accel X", "Accel Y", "Accel Z")
+
     # Range settings
     RANGE_2G = 0x00
     RANGE_4G = 0x01
     RANGE_8G = 0x02
 
     def __init__(
-        self, smbus: int = 1, address: int = DEFAULT_ADDRESS, range_g: int = RANGE_2G
+        self,
+        smbus: int = 1,
+        address: int = DEFAULT_ADDRESS,
+        range_g: int = RANGE_2G,
+        capture_hz: float | None = None,
+        window_sec: float = 2.0,
+        bands_hz: list[list[float]] | None = None,
     ):
+        """
+        Args:
+            smbus: I2C bus number
+            address: I2C address
+            range_g: RANGE_2G/4G/8G
+            capture_hz: Output data rate for continuous capture (None = single samples)
+            window_sec: Feature window length in capture mode
+            bands_hz: FFT bands reported in capture mode
+        """
+        if capture_hz is not None and capture_hz not in self.ODR_BITS:
+            raise ValueError(f"capture_hz must be one of {sorted(self.ODR_BITS)}")
         self._smbus_num = smbus
         self._address = address
         self._range = range_g
         self._bus = None
         self._scale = 1.0
+        self._capture_hz = capture_hz
+        self._window_samples = max(16, int(round(window_sec * (capture_hz or 0))))
+        self._bands = tuple(tuple(b) for b in (bands_hz or DEFAULT_BANDS_HZ))
+        self._capture: BurstCapture | None = None
+        self._sample_calibration: CalibrationPipeline | None = None
+        self.overruns = 0
 
     def init(self) -> None:
-        from smbus2 import SMBus
-
-        self._bus = SMBus(self._smbus_num)
+        self._bus = get_bus(self._smbus_num)
 
         # Verify device ID
         device_id = self._bus.read_byte_data(self._address, self.REG_WHO_AM_I)
@@ -47,6 +105,26 @@ class MMA8452Accelerometer(Sensor):
                 f"MMA8452 not found. Expected 0x{self.DEVICE_ID:02X}, got 0x{device_id:02X}"
             )
 
+        with self._bus.transaction():
+            self._configure()
+        sleep(0.1)
+
+        if self._capture_hz:
+            self._capture = BurstCapture(
+                self._read_ready_sample,
+                self._capture_hz,
+                self._window_samples,
+                self._bands,
+                name="MMA8452Capture",
+                calibrate=(
+                    self._sample_calibration.apply_batch
+                    if self._sample_calibration is not None else None
+                ),
+            )
+            self._capture.start()
+
+    def _configure(self) -> None:
+        """Standby, range and data rate, then active (one bus transaction)."""
         # Put into standby mode to configure
         self._set_standby(True)
 
@@ -61,9 +139,14 @@ class MMA8452Accelerometer(Sensor):
         elif self._range == self.RANGE_8G:
             self._scale = 8.0 / 2048.0
 
-        # Activate the sensor (ODR = 800Hz, normal mode)
+        # Output data rate: 800 Hz, or the capture rate
+        odr = self.ODR_BITS[self._capture_hz] if self._capture_hz else 0
+        ctrl = self._bus.read_byte_data(self._address, self.REG_CTRL_REG1)
+        ctrl = (ctrl & ~0x38) | (odr << 3)
+        self._bus.write_byte_data(self._address, self.REG_CTRL_REG1, ctrl)
+
+        # Activate the sensor (normal mode)
         self._set_standby(False)
-        sleep(0.1)
 
     def _set_standby(self, standby: bool) -> None:
         """Put device into standby or active mode."""
@@ -75,10 +158,16 @@ class MMA8452Accelerometer(Sensor):
         self._bus.write_byte_data(self._address, self.REG_CTRL_REG1, ctrl)
 
     def read(self) -> tuple:
-        """Return (x, y, z) acceleration in g's."""
+        """Return (x, y, z) acceleration in g's, or window features in capture mode."""
+        if self._capture is not None:
+            # First window may still be filling right after init
+            return self._capture.latest(timeout=self._window_samples / self._capture_hz * 2)
+
         # Read 6 bytes starting from OUT_X_MSB
         data = self._bus.read_i2c_block_data(self._address, self.REG_OUT_X_MSB, 6)
+        return self._convert_sample(data)
 
+    def _convert_sample(self, data) -> tuple[float, float, float]:
         # Convert to 12-bit signed values (data is left-justified)
         x = self._convert_raw(data[0], data[1])
         y = self._convert_raw(data[2], data[3])
@@ -86,6 +175,20 @@ class MMA8452Accelerometer(Sensor):
 
         return (x * self._scale, y * self._scale, z * self._scale)
 
+    def _read_ready_sample(self) -> tuple[float, float, float] | None:
+        """Capture thread: one burst read of STATUS + XYZ; None if no new sample."""
+        data = self._bus.read_i2c_block_data(self._address, self.REG_STATUS, 7)
+        status = data[0]
+        if not status & self.STATUS_ZYXDR:
+            return None
+        if status & self.STATUS_ZYXOW:
+            self.overruns += 1
+            log_throttled(
+                logger, logging.WARNING, self.overruns,
+                f"MMA8452 capture overruns: {self.overruns}",
+            )
+        return self._convert_sample(data[1:])
+
     def _convert_raw(self, msb: int, lsb: int) -> int:
         """Convert raw 12-bit left-justified data to signed integer."""
         value = (msb << 8) | lsb
@@ -95,13 +198,33 @@ class MMA8452Accelerometer(Sensor):
             value -= 4096
         return value
 
+    def set_calibration(self, config: dict) -> None:
+        if not self._capture_hz:
+            super().set_calibration(config)
+            return
+        # Capture mode: axis steps calibrate each window's raw samples in one
+        # batch; feature names calibrate the features
+        axes = {k: v for k, v in config.items() if k in self.AXIS_NAMES}
+        super().set_calibration({k: v for k, v in config.items() if k not in axes})
+        self._sample_calibration = (
+            CalibrationPipeline.compile(axes, self.AXIS_NAMES) if axes else None
+        )
+
     def get_names(self) -> tuple[str, ...]:
-        return ("Accel X", "Accel Y", "Accel Z")
+        if self._capture_hz:
+            return feature_names(self._bands)
+        return self.AXIS_NAMES
 
     def get_units(self) -> tuple[str, ...]:
+        if self._capture_hz:
+            return feature_units(self._bands)
         return ("g", "g", "g")
 
     def close(self) -> None:
+        if self._capture is not None:
+            self._capture.stop()
+            self._capture.join(timeout=1.0)
+            self._capture = None
         if self._bus:
             self._bus.close()
             self._bus = None
@@ -0,0 +1,198 @@
+"""
+In-process 7-segment display decoder.
+
+Reads digits from a grayscale numpy image of a 7-segment display, in
+memory, in place of writing the crop to disk and running ssocr:
+
+    1. Threshold at the middle of the image's range (ssocr's -t 50) and take
+       the minority pixels as lit segments, so light-on-dark and
+       dark-on-light displays both work.
+    2. Split the columns into digits: runs of lit columns, with the small
+       gaps between a digit's own segments merged back. Short blobs at the
+       baseline are decimal points.
+    3. Sample the seven segment areas of each digit box and look the lit
+       set up in the standard segment masks. A digit much narrower than it
+       is tall is a "1".
+
+Segments are lettered the usual way:
+
+     aaa
+    f   b
+     ggg
+    e   c
+     ddd
+
+Functions:
+    binarize: Grayscale -> lit-segment mask
+    decode_digits: Lit-segment mask -> digit string
+    read_seven_segment: Grayscale -> digit string
+"""
+
+from __future__ import annotations
+
+import numpy as np
+
+SEGMENTS = "abcdefg"
+
+# Lit segments per character, including the common alternate forms of 6, 7 and 9
+_PATTERNS = {
+    "0": ("abcdef",),
+    "1": ("bc",),
+    "2": ("abdeg",),
+    "3": ("abcdg",),
+    "4": ("bcfg",),
+    "5": ("acdfg",),
+    "6": ("acdefg", "cdefg"),
+    "7": ("abc", "abcf"),
+    "8": ("abcdefg",),
+    "9": ("abcdfg", "abcfg"),
+    "-": ("g",),
+}
+
+
+def _mask(segments: str) -> int:
+    return sum(1 << SEGMENTS.index(s) for s in segments)
+
+
+SEGMENT_MASKS: dict[int, str] = {
+    _mask(segments): char for char, forms in _PATTERNS.items() for segments in forms
+}
+
+# Sample area per segment as (top, bottom, left, right) fractions of the digit box
+_SEGMENT_AREAS = {
+    "a": (0.0, 0.2, 0.3, 0.7),
+    "b": (0.2, 0.4, 0.7, 1.0),
+    "c": (0.6, 0.8, 0.7, 1.0),
+    "d": (0.8, 1.0, 0.3, 0.7),
+    "e": (0.6, 0.8, 0.0, 0.3),
+    "f": (0.2, 0.4, 0.0, 0.3),
+    "g": (0.4, 0.6, 0.3, 0.7),
+}
+
+SEGMENT_FILL = 0.25  # Lit fraction of a sample area for the segment to count as on
+ONE_WIDTH = 0.3  # Digits narrower than this fraction of the height are "1"
+DIGIT_GAP = 0.1  # Column gaps below this fraction of the height are within a digit
+POINT_HEIGHT = 0.3  # Blobs shorter than this at the baseline are decimal points
+
+
+def binarize(gray: np.ndarray, threshold: float | None = None) -> np.ndarray:
+    """
+    Lit-segment mask of a grayscale image.
+
+    Args:
+        gray: 2-D image
+        threshold: Gray level; default halfway between the darkest and brightest pixel
+
+    Returns:
+        Boolean mask, True where the (minority) segment pixels are.
+    """
+    if threshold is None:
+        threshold = (float(gray.min()) + float(gray.max())) / 2.0
+    bright = gray > threshold
+    # Segments cover less of a display than its background
+    return bright if bright.mean() <= 0.5 else ~bright
+
+
+def _column_runs(lit: np.ndarray) -> list[tuple[int, int, int, int]]:
+    """(left, right, top, bottom) of each run of columns with lit pixels (end-exclusive)."""
+    columns = np.concatenate(([False], lit.any(axis=0), [False]))
+    edges = np.flatnonzero(columns[1:] != columns[:-1])
+    runs = []
+    for left, right in zip(edges[0::2], edges[1::2]):
+        rows = np.flatnonzero(lit[:, left:right].any(axis=1))
+        runs.append((int(left), int(right), int(rows[0]), int(rows[-1]) + 1))
+    return runs
+
+
+def _segments_lit(box: np.ndarray) -> int:
+    height, width = box.shape
+    mask = 0
+    for bit, segment in enumerate(SEGMENTS):
+        top, bottom, left, right = _SEGMENT_AREAS[segment]
+        area = box[
+            int(top * height):max(int(bottom * height), int(top * height) + 1),
+            int(left * width):max(int(right * width), int(left * width) + 1),
+        ]
+        if area.mean() >= SEGMENT_FILL:
+            mask |= 1 << bit
+    return mask
+
+
+def decode_digits(lit: np.ndarray, num_digits: int | None = None) -> str | None:
+    """
+    Decode a lit-segment mask.
+
+    Args:
+        lit: Boolean mask from binarize()
+        num_digits: Expected digit count (decimal points not counted); None = any
+
+    Returns:
+        The digits read (with "." and "-"), or None if nothing was read, a digit
+        didn't match any segment pattern, or the count differs from num_digits.
+    """
+    runs = _column_runs(lit)
+    if not runs:
+        return None
+    height = max(bottom - top for _, _, top, bottom in runs)
+    # Specks of noise
+    runs = [r for r in runs if lit[r[2]:r[3], r[0]:r[1]].sum() >= max(1, (0.05 * height) ** 2)]
+    if not runs:
+        return None
+    height = max(bottom - top for _, _, top, bottom in runs)
+    baseline = max(bottom for _, _, top, bottom in runs if bottom - top > POINT_HEIGHT * height)
+
+    # Classify runs as points (short, sitting on the baseline) or digit parts,
+    # then merge digit parts separated by less than a segment gap
+    items: list[list] = []  # [kind, left, right, top, bottom]
+    for left, right, run_top, run_bottom in runs:
+        short = run_bottom - run_top <= POINT_HEIGHT * height
+        if short and run_bottom >= baseline - 0.1 * height:
+            items.append(["point", left, right, run_top, run_bottom])
+        elif (items and items[-1][0] == "digit"
+              and left - items[-1][2] < DIGIT_GAP * height):
+            item = items[-1]
+            item[2:] = [right, min(item[3], run_top), max(item[4], run_bottom)]
+        else:
+            items.append(["digit", left, right, run_top, run_bottom])
+
+    # Common digit box rows (a lone "-" has no height of its own)
+    tall = [
+        item for item in items
+        if item[0] == "digit" and item[4] - item[3] > POINT_HEIGHT * height
+    ]
+    if not tall:
+        return None
+    top = min(item[3] for item in tall)
+    bottom = max(item[4] for item in tall)
+    height = bottom - top
+
+    text = []
+    digits = 0
+    for kind, left, right, item_top, item_bottom in items:
+        if kind == "point":
+            text.append(".")
+            continue
+        digits += 1
+        # A lone vertical pair; a short narrow blob is left to the masks ("-")
+        if right - left < ONE_WIDTH * height and item_bottom - item_top > 0.5 * height:
+            text.append("1")
+            continue
+        char = SEGMENT_MASKS.get(_segments_lit(lit[top:bottom, left:right]))
+        if char is None:
+            return None
+        text.append(char)
+
+    if not digits or (num_digits is not None and digits != num_digits):
+        return None
+    return "".join(text)
+
+
+def read_seven_segment(
+    gray: np.ndarray,
+    num_digits: int | None = None,
+    threshold: float | None = None,
+) -> str | None:
+    """Threshold a grayscale display image and decode its digits."""
+    if gray.size == 0 or gray.min() == gray.max():
+        return None
+    return decode_digits(binarize(gray, threshold), num_digits)
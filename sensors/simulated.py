@@ -0,0 +1,394 @@
+"""
+Simulated sensor drivers for hardware-free load and soak testing.
+
+Each driver mirrors a real one: same reading names, units and precision,
+and it reports under the real driver's class name (so the same sensor class
+ID and series on the gateway). No hardware library is imported.
+
+Every reading follows a seeded waveform, sampled on each read():
+
+    base + amplitude * sin(2*pi*t / period_sec + phase)
+         + random walk (walk = step std per read)
+         + step events (step_prob per read, +/- step_size)
+         + noise (std)
+
+clamped to [min, max] when given, and None with probability dropout. t is
+seconds since init() on the sensor's clock. Values depend only on the seed,
+the reading's position and the read sequence, so a run is reproducible.
+
+Fault injection (separate random stream, so faults don't shift values):
+read_latency_sec (+ latency_jitter_sec) per read, fail_rate of reads raising
+OSError as a bus error would, and init_latency_sec / init_fail.
+
+    {"class": "SimulatedBME280", "interval_sec": 10,
+     "config": {"seed": 7, "read_latency_sec": 0.01, "fail_rate": 0.02,
+                "readings": {"Temperature": {"base": 70, "amplitude": 8,
+                                             "period_sec": 600, "noise": 0.1}}}}
+
+"readings" entries replace that reading's default waveform.
+
+SimulatedMMA8452 takes the real driver's capture_hz/window_sec/bands_hz:
+each read then samples the "Accel X/Y/Z" waveforms over one window at
+capture_hz and returns its vibration features (sensors.vibration), with
+the same names as the real driver in capture mode. A vibration tone is an
+axis waveform with period_sec = 1/frequency.
+
+Classes:
+    Waveform: Seeded value generator for one reading
+    SimulatedSensor: Base for simulated drivers
+    SimulatedBME280: Mirrors BME280TempPressureHumidity
+    SimulatedMMA8452: Mirrors MMA8452Accelerometer
+    SimulatedADS1115: Mirrors ADS1115ADC
+"""
+
+from __future__ import annotations
+
+import math
+import random
+import time
+from dataclasses import dataclass, fields
+
+from .base import Sensor, c_to_f
+from .calibration import CalibrationPipeline, as_step_list
+from .vibration import DEFAULT_BANDS_HZ, compute_features, feature_names, feature_units
+
+
+@dataclass
+class Waveform:
+    """Value generator for one reading (see module docstring)."""
+
+    base: float = 0.0
+    amplitude: float = 0.0
+    period_sec: float = 3600.0
+    phase: float = 0.0
+    walk: float = 0.0
+    step_prob: float = 0.0
+    step_size: float = 0.0
+    noise: float = 0.0
+    dropout: float = 0.0
+    min: float | None = None
+    max: float | None = None
+
+    @classmethod
+    def from_config(cls, config: dict) -> Waveform:
+        known = {f.name for f in fields(cls)}
+        unknown = set(config) - known
+        if unknown:
+            raise ValueError(f"Unknown waveform keys {sorted(unknown)}; valid: {sorted(known)}")
+        waveform = cls(**config)
+        if waveform.period_sec <= 0:
+            raise ValueError("period_sec must be positive")
+        if not 0 <= waveform.dropout <= 1 or not 0 <= waveform.step_prob <= 1:
+            raise ValueError("dropout and step_prob must be within 0-1")
+        return waveform
+
+    def __post_init__(self):
+        self._offset = 0.0  # Accumulated walk and steps
+
+    def sample(self, t: float, rng: random.Random) -> float | None:
+        # A dropped value still advances the walk and draws its noise
+        if self.walk:
+            self._offset += rng.gauss(0.0, self.walk)
+        if self.step_prob and rng.random() < self.step_prob:
+            self._offset += self.step_size * rng.choice((-1.0, 1.0))
+        # Keep the walk itself inside the bounds, so it doesn't stick to one
+        if self.min is not None:
+            self._offset = max(self._offset, self.min - self.base)
+        if self.max is not None:
+            self._offset = min(self._offset, self.max - self.base)
+        noise = rng.gauss(0.0, self.noise) if self.noise else 0.0
+        dropped = self.dropout and rng.random() < self.dropout
+
+        value = self.base + self._offset + noise
+        if self.amplitude:
+            value += self.amplitude * math.sin(2 * math.pi * t / self.period_sec + self.phase)
+        if self.min is not None:
+            value = max(value, self.min)
+        if self.max is not None:
+            value = min(value, self.max)
+        return None if dropped else value
+
+
+class SimulatedSensor(Sensor):
+    """
+    Base for simulated drivers.
+
+    Subclasses set MIRRORS (the real class name), NAMES, UNITS and
+    DEFAULT_WAVEFORMS (name -> Waveform config), and PRECISION if the real
+    driver overrides get_precision(). HARDWARE_OPTIONS lists the real
+    driver's options that only concern the hardware; they are accepted and
+    ignored. Drivers whose readings are computed from other signals
+    override waveform_names() and _sample().
+    """
+
+    MIRRORS: str = ""
+    HARDWARE_OPTIONS: frozenset[str] = frozenset({"smbus", "address"})
+    NAMES: tuple[str, ...] = ()
+    UNITS: tuple[str, ...] = ()
+    PRECISION = 3
+    DEFAULT_WAVEFORMS: dict[str, dict] = {}
+
+    def __init__(
+        self,
+        seed: int = 0,
+        readings: dict[str, dict] | None = None,
+        read_latency_sec: float = 0.0,
+        latency_jitter_sec: float = 0.0,
+        fail_rate: float = 0.0,
+        init_latency_sec: float = 0.0,
+        init_fail: bool = False,
+        clock=time.monotonic,
+        sleep=time.sleep,
+        **hardware_options,
+    ):
+        """
+        Args:
+            seed: Seed for values and faults
+            readings: Waveform overrides per reading name
+            read_latency_sec: Time each read() takes
+            latency_jitter_sec: Up to this much extra, uniformly
+            fail_rate: Fraction of reads raising OSError
+            init_latency_sec: Time init() takes
+            init_fail: init() raises, like a missing device
+            clock: Time source for the waveforms
+            sleep: Latency sleep (tests pass a no-op)
+            **hardware_options: The real driver's HARDWARE_OPTIONS, accepted and
+                ignored so a config can switch class only
+
+        Raises:
+            TypeError: For any other option, which the simulator can't honour
+        """
+        unsupported = set(hardware_options) - self.HARDWARE_OPTIONS
+        if unsupported:
+            raise TypeError(
+                f"{type(self).__name__} can't simulate options {sorted(unsupported)}"
+            )
+        if not 0 <= fail_rate <= 1:
+            raise ValueError("fail_rate must be within 0-1")
+        waveform_names = self.waveform_names()
+        unknown = set(readings or {}) - set(waveform_names)
+        if unknown:
+            raise ValueError(f"Unknown readings {sorted(unknown)}; readings: {waveform_names}")
+        self._waveforms = [
+            Waveform.from_config((readings or {}).get(name, self.DEFAULT_WAVEFORMS.get(name, {})))
+            for name in waveform_names
+        ]
+        self._rng = random.Random(seed)
+        self._fault_rng = random.Random(f"faults-{seed}")
+        self._read_latency = read_latency_sec
+        self._latency_jitter = latency_jitter_sec
+        self._fail_rate = fail_rate
+        self._init_latency = init_latency_sec
+        self._init_fail = init_fail
+        self._clock = clock
+        self._sleep = sleep
+        self._t0: float | None = None
+        self.reads = 0
+        self.failures = 0
+
+    @property
+    def class_name(self) -> str:
+        return self.MIRRORS
+
+    def init(self) -> None:
+        if self._init_latency:
+            self._sleep(self._init_latency)
+        if self._init_fail:
+            raise RuntimeError(f"{type(self).__name__}: simulated device not found")
+        self._t0 = self._clock()
+
+    def read(self) -> tuple:
+        if self._t0 is None:
+            raise RuntimeError(f"{type(self).__name__} not initialized. Call init() first.")
+        latency = self._read_latency
+        if self._latency_jitter:
+            latency += self._fault_rng.uniform(0.0, self._latency_jitter)
+        if latency:
+            self._sleep(latency)
+        self.reads += 1
+        if self._fail_rate and self._fault_rng.random() < self._fail_rate:
+            self.failures += 1
+            raise OSError(121, "Remote I/O error (simulated)")
+        return self._sample(self._clock() - self._t0)
+
+    def _sample(self, t: float) -> tuple:
+        """Values for one read at t seconds since init()."""
+        return tuple(w.sample(t, self._rng) for w in self._waveforms)
+
+    def waveform_names(self) -> tuple[str, ...]:
+        """Signals with a waveform ("readings" keys); the readings by default."""
+        return self.get_names()
+
+    def get_names(self) -> tuple[str, ...]:
+        return self.NAMES
+
+    def get_units(self) -> tuple[str, ...]:
+        return self.UNITS
+
+    def get_precision(self) -> int:
+        return self.PRECISION
+
+
+class SimulatedBME280(SimulatedSensor):
+    """Indoor-ish climate: daily temperature/humidity swing, drifting pressure."""
+
+    MIRRORS = "BME280TempPressureHumidity"
+    HARDWARE_OPTIONS = SimulatedSensor.HARDWARE_OPTIONS | {"oversampling", "iir_filter"}
+    NAMES = ("Temperature", "Pressure", "Humidity")
+    UNITS = ("°F", "hPa", "%")
+    DEFAULT_WAVEFORMS = {
+        "Temperature": {"base": c_to_f(20.0), "amplitude": 9.0, "period_sec": 86400,
+                        "noise": 0.05},
+        "Pressure": {"base": 1013.0, "walk": 0.02, "noise": 0.01, "min": 950, "max": 1060},
+        "Humidity": {"base": 55.0, "amplitude": 15.0, "period_sec": 86400,
+                     "phase": math.pi, "noise": 0.3, "min": 0, "max": 100},
+        "Measure Time": {"base": 8.0, "noise": 0.05, "min": 0},
+    }
+
+    def __init__(self, report_timing: bool = False, **kwargs):
+        """
+        Args:
+            report_timing: Add a "Measure Time" reading (ms), as the real driver
+            **kwargs: SimulatedSensor options
+        """
+        self._report_timing = report_timing
+        super().__init__(**kwargs)
+
+    def get_names(self) -> tuple[str, ...]:
+        return self.NAMES + ("Measure Time",) if self._report_timing else self.NAMES
+
+    def get_units(self) -> tuple[str, ...]:
+        return self.UNITS + ("ms",) if self._report_timing else self.UNITS
+
+
+class SimulatedMMA8452(SimulatedSensor):
+    """At rest, Z up, with sensor noise and an occasional knock; capture mode as MMA8452Accelerometer."""
+
+    MIRRORS = "MMA8452Accelerometer"
+    HARDWARE_OPTIONS = SimulatedSensor.HARDWARE_OPTIONS | {"range_g"}
+    NAMES = ("Accel X", "Accel Y", "Accel Z")
+    UNITS = ("g", "g", "g")
+    DEFAULT_WAVEFORMS = {
+        "Accel X": {"noise": 0.004},
+        "Accel Y": {"noise": 0.004},
+        "Accel Z": {"base": 1.0, "noise": 0.004, "step_prob": 0.001, "step_size": 0.02},
+    }
+
+    def __init__(
+        self,
+        capture_hz: float | None = None,
+        window_sec: float = 2.0,
+        bands_hz: list[list[float]] | None = None,
+        **kwargs,
+    ):
+        """
+        Args:
+            capture_hz: Sample rate of each simulated window (None = single samples)
+            window_sec: Feature window length in capture mode
+            bands_hz: FFT bands reported in capture mode
+            **kwargs: SimulatedSensor options
+        """
+        from .mma8452_sensor import MMA8452Accelerometer
+
+        if capture_hz is not None and capture_hz not in MMA8452Accelerometer.ODR_BITS:
+            raise ValueError(f"capture_hz must be one of {sorted(MMA8452Accelerometer.ODR_BITS)}")
+        self._capture_hz = capture_hz
+        self._window_samples = max(16, int(round(window_sec * (capture_hz or 0))))
+        self._bands = tuple(tuple(b) for b in (bands_hz or DEFAULT_BANDS_HZ))
+        self._sample_calibration: CalibrationPipeline | None = None
+        super().__init__(**kwargs)
+
+    def _sample(self, t: float) -> tuple:
+        if not self._capture_hz:
+            return super()._sample(t)
+        # The window ending now; a dropped sample reads as the axis base
+        n, rate = self._window_samples, self._capture_hz
+        window = [
+            tuple(
+                w.base if (v := w.sample(t - (n - 1 - i) / rate, self._rng)) is None else v
+                for w in self._waveforms
+            )
+            for i in range(n)
+        ]
+        if self._sample_calibration is not None:
+            window = self._sample_calibration.apply_batch(window)
+        return compute_features(window, rate, self._bands)
+
+    def set_calibration(self, config: dict) -> None:
+        if not self._capture_hz:
+            super().set_calibration(config)
+            return
+        # As the real driver: axis steps calibrate the samples, the rest the features
+        axes = {k: v for k, v in config.items() if k in self.NAMES}
+        super().set_calibration({k: v for k, v in config.items() if k not in axes})
+        self._sample_calibration = (
+            CalibrationPipeline.compile(axes, self.NAMES) if axes else None
+        )
+
+    def waveform_names(self) -> tuple[str, ...]:
+        return self.NAMES
+
+    def get_names(self) -> tuple[str, ...]:
+        if self._capture_hz:
+            return feature_names(self._bands)
+        return self.NAMES
+
+    def get_units(self) -> tuple[str, ...]:
+        if self._capture_hz:
+            return feature_units(self._bands)
+        return self.UNITS
+
+
+class SimulatedADS1115(SimulatedSensor):
+    """Slowly wandering voltages in the ADC's range; same channel options as ADS1115ADC."""
+
+    MIRRORS = "ADS1115ADC"
+    HARDWARE_OPTIONS = SimulatedSensor.HARDWARE_OPTIONS | {
+        "gain", "data_rate", "scan", "samples", "reject", "scan_interval_sec",
+    }
+    PRECISION = 4
+    DEFAULT_WAVEFORMS = {
+        name: {"base": 1.65, "walk": 0.002, "noise": 0.001, "min": 0.0, "max": 3.3}
+        for name in ("A0", "A1", "A2", "A3")
+    }
+
+    def __init__(
+        self,
+        channels: list[int] | None = None,
+        names: tuple[str, ...] | None = None,
+        units: tuple[str, ...] | None = None,
+        **kwargs,
+    ):
+        channels = list(range(4)) if channels is None else list(channels)
+        if any(ch not in range(4) for ch in channels):
+            raise ValueError(f"Invalid channels {channels}, must be within 0-3")
+        self._names = tuple(names) if names is not None else tuple(f"A{ch}" for ch in channels)
+        self._units = tuple(units) if units is not None else ("amplitude",) * len(channels)
+        if len(self._names) != len(channels) or len(self._units) != len(channels):
+            raise ValueError("names and units must match the active channels")
+        # Default waveforms follow the channel, whatever it's named
+        self.DEFAULT_WAVEFORMS = {
+            name: SimulatedADS1115.DEFAULT_WAVEFORMS[f"A{ch}"]
+            for name, ch in zip(self._names, channels)
+        }
+        transforms = kwargs.pop("transforms", None) or {}
+        super().__init__(**kwargs)
+        # "transforms" as the real driver applies them: normalize steps first
+        self._transform_spec = {
+            self._names[channels.index(int(ch))]: [{"type": "normalize", **t}]
+            for ch, t in transforms.items()
+        }
+        if self._transform_spec:
+            self.set_calibration({})
+
+    def set_calibration(self, config: dict) -> None:
+        spec = {name: list(steps) for name, steps in self._transform_spec.items()}
+        for name, steps in config.items():
+            spec[name] = spec.get(name, []) + as_step_list(steps)
+        super().set_calibration(spec)
+
+    def get_names(self) -> tuple[str, ...]:
+        return self._names
+
+    def get_units(self) -> tuple[str, ...]:
+        return self._units
@@ -0,0 +1,103 @@
+"""
+Threshold state machine with hysteresis.
+
+Pure logic behind the gateway's threshold rules (gateway.alerts), which
+turn a stream of values into discrete alert transitions. A crossing fires once; the value must move back
+past the threshold by `hysteresis` before the state returns to NORMAL, so a
+reading hovering at the boundary doesn't spam notifications.
+
+State transitions:
+    NORMAL     -> ALERT_HIGH:  value >= high
+    NORMAL     -> ALERT_LOW:   value <= low
+    ALERT_HIGH -> NORMAL:      value <= high - hysteresis
+    ALERT_LOW  -> NORMAL:      value >= low + hysteresis
+    ALERT_HIGH -> ALERT_LOW:   value <= low   (direct crossover)
+    ALERT_LOW  -> ALERT_HIGH:  value >= high  (direct crossover)
+
+Classes:
+    AlertState: Alert state of a series
+    ThresholdConfig: Low/high limits with hysteresis
+    ThresholdAlert: A state transition for one series
+
+Functions:
+    next_state: One step of the hysteresis state machine
+    crossed_limit: The limit behind a transition
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+from enum import Enum
+
+
+class AlertState(Enum):
+    """Alert state of a monitored series."""
+
+    NORMAL = "normal"
+    ALERT_LOW = "alert_low"
+    ALERT_HIGH = "alert_high"
+    RATE_HIGH = "rate_high"  # Rate of change above limit
+    STALE = "stale"  # No data within the allowed age
+
+
+@dataclass
+class ThresholdConfig:
+    """Low/high limits for one series. Either limit may be None (unused)."""
+
+    low: float | None = None
+    high: float | None = None
+    hysteresis: float = 0.0
+
+    def __post_init__(self):
+        if self.low is None and self.high is None:
+            raise ValueError("ThresholdConfig needs at least one of low/high")
+        if self.hysteresis < 0:
+            raise ValueError("hysteresis must be >= 0")
+        if self.low is not None and self.high is not None and self.low >= self.high:
+            raise ValueError(f"low ({self.low}) must be less than high ({self.high})")
+
+
+@dataclass
+class ThresholdAlert:
+    """A state transition for one series."""
+
+    sensor_id: str
+    new_state: AlertState
+    old_state: AlertState
+    value: float | None
+    threshold_value: float | None
+    units: str
+    timestamp: float
+    rule: str = ""  # Rule that fired; cooldown is per rule
+
+    @property
+    def is_recovery(self) -> bool:
+        return self.new_state is AlertState.NORMAL
+
+
+def next_state(current: AlertState, value: float, config: ThresholdConfig) -> AlertState:
+    """Pure hysteresis state machine (see module docstring)."""
+    low, high, hyst = config.low, config.high, config.hysteresis
+
+    if high is not None and value >= high:
+        return AlertState.ALERT_HIGH
+    if low is not None and value <= low:
+        return AlertState.ALERT_LOW
+
+    if current is AlertState.ALERT_HIGH and value > high - hyst:
+        return AlertState.ALERT_HIGH
+    if current is AlertState.ALERT_LOW and value < low + hyst:
+        return AlertState.ALERT_LOW
+
+    return AlertState.NORMAL
+
+
+def crossed_limit(new: AlertState, old: AlertState, config: ThresholdConfig) -> float | None:
+    """The limit that was crossed (the alert limit for recoveries)."""
+    state = old if new is AlertState.NORMAL else new
+    if state is AlertState.ALERT_HIGH:
+        return config.high
+    if state is AlertState.ALERT_LOW:
+        return config.low
+    return None
+
@@ -0,0 +1,198 @@
+"""
+Vibration features from high-rate accelerometer windows.
+
+A background BurstCapture thread polls a sample source at the sensor's
+output data rate and fills fixed-length windows; each full window is reduced
+to a handful of features (numpy, vectorized over all samples and axes),
+and only those are broadcast:
+
+    Vib RMS X/Y/Z  g   RMS of each axis after removing its mean (gravity)
+    Vib Peak       g   Largest magnitude of the AC acceleration vector
+    Vib Crest          Peak / overall RMS (impacts, bearing defects)
+    Vib <lo>-<hi>Hz g  RMS within each frequency band (Hann-windowed FFT)
+
+Band RMS comes from the one-sided power spectrum summed over the axes, so
+a sine of amplitude A inside a band reads A/sqrt(2) in that band.
+
+numpy is imported when the first window is reduced; single-sample sensors
+never need it.
+
+Classes:
+    BurstCapture: Background thread turning a sample source into feature windows
+
+Functions:
+    feature_names: Reading names for a band list
+    compute_features: Features of one (n, 3) window
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from typing import Callable
+
+from utils.log_throttle import log_throttled
+
+logger = logging.getLogger(__name__)
+
+# Default bands for 400 Hz capture (Nyquist 200 Hz)
+DEFAULT_BANDS_HZ: tuple[tuple[float, float], ...] = (
+    (1, 10), (10, 50), (50, 100), (100, 200),
+)
+
+AXES = ("X", "Y", "Z")
+
+
+def feature_names(bands_hz) -> tuple[str, ...]:
+    """Reading names, in compute_features() order."""
+    return (
+        tuple(f"Vib RMS {axis}" for axis in AXES)
+        + ("Vib Peak", "Vib Crest")
+        + tuple(f"Vib {lo:g}-{hi:g}Hz" for lo, hi in bands_hz)
+    )
+
+
+def feature_units(bands_hz) -> tuple[str, ...]:
+    return ("g", "g", "g", "g", "") + ("g",) * len(bands_hz)
+
+
+def compute_features(samples, rate_hz: float, bands_hz) -> tuple[float, ...]:
+    """
+    Reduce one window to features.
+
+    Args:
+        samples: Array-like of shape (n, 3), acceleration in g
+        rate_hz: Sample rate of the window
+        bands_hz: (low, high) band edges; low inclusive, high exclusive
+
+    Returns:
+        Values in feature_names() order
+    """
+    import numpy as np
+
+    x = np.asarray(samples, dtype=np.float64)
+    n = x.shape[0]
+    ac = x - x.mean(axis=0)
+
+    rms_axes = np.sqrt(np.mean(ac * ac, axis=0))
+    magnitude = np.sqrt(np.sum(ac * ac, axis=1))
+    rms_total = float(np.sqrt(np.mean(magnitude * magnitude)))
+    peak = float(magnitude.max()) if n else 0.0
+    crest = peak / rms_total if rms_total > 0 else 0.0
+
+    # One-sided power spectrum, Hann window corrected back to signal power
+    window = np.hanning(n)
+    spectrum = np.fft.rfft(ac * window[:, None], axis=0)
+    power = np.sum(np.abs(spectrum) ** 2, axis=1) / (n * n * np.mean(window * window))
+    power[1:] *= 2.0
+    if n % 2 == 0:
+        power[-1] /= 2.0  # Nyquist bin has no mirror
+    freqs = np.fft.rfftfreq(n, d=1.0 / rate_hz)
+    bands = [
+        float(np.sqrt(power[(freqs >= lo) & (freqs < hi)].sum()))
+        for lo, hi in bands_hz
+    ]
+
+    return (*(float(v) for v in rms_axes), peak, crest, *bands)
+
+
+class BurstCapture(threading.Thread):
+    """
+    Polls a sample source at a fixed rate and keeps the latest window's features.
+
+    read_sample() returns (x, y, z) in g when a new sample is ready, or None;
+    it is called roughly twice per sample period. Features older than
+    max_age_sec (the source stalled or keeps failing) are not served.
+    """
+
+    def __init__(
+        self,
+        read_sample: Callable[[], tuple[float, float, float] | None],
+        rate_hz: float,
+        window_samples: int,
+        bands_hz=DEFAULT_BANDS_HZ,
+        name: str = "BurstCapture",
+        calibrate: Callable | None = None,
+        max_age_sec: float | None = None,
+        clock=time.monotonic,
+    ):
+        """
+        Args:
+            read_sample: Burst read of one sample (None if not ready yet)
+            rate_hz: Sensor output data rate
+            window_samples: Samples per feature window
+            bands_hz: FFT bands reported
+            name: Thread name
+            calibrate: Applied to each full (n, 3) window before the features
+                (CalibrationPipeline.apply_batch)
+            max_age_sec: Oldest window latest() returns (default: two window lengths)
+            clock: Monotonic time source (injectable for tests)
+        """
+        super().__init__(daemon=True, name=name)
+        self._read_sample = read_sample
+        self.rate_hz = rate_hz
+        self._window = window_samples
+        self.bands_hz = tuple(tuple(b) for b in bands_hz)
+        self._calibrate = calibrate
+        self._max_age = max_age_sec if max_age_sec is not None else 2.0 * window_samples / rate_hz
+        self._clock = clock
+        self._poll_sec = 0.5 / rate_hz
+        self._lock = threading.Lock()
+        self._ready = threading.Event()
+        self._running = True
+        self._features: tuple[float, ...] | None = None
+        self._completed_at = 0.0
+        self.windows = 0
+        self.errors = 0
+
+    def latest(self, timeout: float | None = None) -> tuple[float, ...]:
+        """
+        Features of the most recent complete window.
+
+        Waits up to timeout for the first window.
+
+        Raises:
+            TimeoutError: If no window has completed yet, or the last one
+                completed more than max_age_sec ago
+        """
+        if not self._ready.wait(timeout):
+            raise TimeoutError("no vibration window captured yet")
+        with self._lock:
+            age = self._clock() - self._completed_at
+            if age > self._max_age:
+                raise TimeoutError(f"last vibration window is {age:.1f}s old")
+            return self._features
+
+    def run(self) -> None:
+        buffer: list[tuple[float, float, float]] = []
+        while self._running:
+            try:
+                sample = self._read_sample()
+                if sample is None:
+                    time.sleep(self._poll_sec)
+                    continue
+                buffer.append(sample)
+                if len(buffer) < self._window:
+                    continue
+                window = buffer if self._calibrate is None else self._calibrate(buffer)
+                features = compute_features(window, self.rate_hz, self.bands_hz)
+            except Exception as e:
+                # Transient I2C error or a bad window: drop it, keep going
+                self.errors += 1
+                log_throttled(
+                    logger, logging.WARNING, self.errors,
+                    f"{self.name}: capture failed (#{self.errors}): {e}",
+                )
+                buffer = []
+                time.sleep(0.1)
+                continue
+            buffer = []
+            with self._lock:
+                self._features = features
+                self._completed_at = self._clock()
+                self.windows += 1
+            self._ready.set()
+
+    def stop(self) -> None:
+        self._running = False
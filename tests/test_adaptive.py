@@ -0,0 +1,143 @@
+"""Tests for variance-driven adaptive sensor intervals."""
+
+from unittest.mock import MagicMock
+
+import pytest
+
+from node.adaptive import AdaptiveConfig, AdaptiveInterval
+from node.command import commands_init
+from node.data_log import instantiate_sensors
+from node.scheduler import SensorScheduler
+from node.sensor_reader import SensorEntry
+from utils.command_registry import CommandRegistry
+from utils.node_state import NodeState
+from utils.protocol import SensorReading
+from utils.radio_state import RadioState
+
+
+def reading(value, ts, name="Temperature"):
+    return SensorReading(name, "C", value, "BME280TempPressureHumidity", ts)
+
+
+def make(interval=60, **kwargs):
+    config = AdaptiveConfig(
+        min_interval_sec=kwargs.pop("min_interval_sec", 5),
+        max_interval_sec=kwargs.pop("max_interval_sec", 60),
+        **kwargs,
+    )
+    return AdaptiveInterval(config, interval)
+
+
+class TestAdaptiveConfig:
+    """Tests for config parsing and validation."""
+
+    def test_defaults_from_interval(self):
+        config = AdaptiveConfig.from_config({"std": 0.5}, 120)
+        assert (config.min_interval_sec, config.max_interval_sec) == (12, 120)
+        assert AdaptiveConfig.from_config(None, 60) is None
+
+    @pytest.mark.parametrize("bad", [
+        {"window": 8},
+        {"std": 1, "min_interval_sec": 0},
+        {"std": 1, "min_interval_sec": 90},
+        {"std": 1, "shrink": 1.0},
+        {"rate": 1, "relax": 0.9},
+    ])
+    def test_invalid(self, bad):
+        with pytest.raises(ValueError):
+            AdaptiveConfig.from_config({"max_interval_sec": 60, **bad}, 60)
+
+    def test_watched_names_checked_against_sensor(self):
+        aggregated = {"class": "SimulatedBME280", "aggregate": {"sample_interval_sec": 1},
+                      "adaptive": {"std": 0.1, "readings": ["Temperature mean"]}}
+        typo = {"class": "SimulatedBME280",
+                "adaptive": {"std": 0.1, "readings": ["Temperature mean"]}}
+        entries = instantiate_sensors([aggregated, typo], 60)
+        try:
+            # Summaries are named after the stat; the plain sensor has no "mean"
+            assert len(entries) == 1
+            assert entries[0].sensor.get_names()[2] == "Temperature mean"
+        finally:
+            for entry in entries:
+                entry.sensor.close()
+
+
+class TestAdaptiveInterval:
+    """Tests for the interval controller."""
+
+    def test_rate_shrinks_to_min(self):
+        adaptive = make(rate=0.1)
+        adaptive.update([reading(20.0, 0)])
+        intervals = [adaptive.update([reading(20.0 + 10 * k, 60 * k)]) for k in range(1, 6)]
+        assert intervals == [30, 15, 7.5, 5, 5]
+
+    def test_quiet_relaxes_to_max(self):
+        adaptive = make(interval=5, std=0.5, quiet_samples=2)
+        intervals = [adaptive.update([reading(20.0, k)]) for k in range(14)]
+        assert intervals[:4] == [5, 7.5, 7.5, 11.25]
+        assert intervals[-1] == 60
+
+    def test_spread_holds_fast_until_spike_leaves_window(self):
+        adaptive = make(interval=5, std=1.0, window=4, quiet_samples=1)
+        values = [20, 20, 20, 25, 20, 20, 20, 20]
+        intervals = [adaptive.update([reading(v, k)]) for k, v in enumerate(values)]
+        # Spike at read 3 stays in the 4-read window for reads 3-6
+        assert intervals == [7.5, 11.25, 16.875, 8.4375, 5, 5, 5, 7.5]
+
+    def test_unwatched_and_missing_ignored(self):
+        adaptive = make(rate=0.1, readings=["Temperature"])
+        adaptive.update([reading(20.0, 0)])
+        assert adaptive.update([reading(None, 1), reading(99.0, 1, "Pressure")]) == 60
+        assert adaptive.update([reading(30.0, 2)]) == 30
+
+    def test_start_clamped(self):
+        assert make(interval=600, std=1).interval_sec == 60
+
+
+class TestSchedulerSetInterval:
+    """Tests for changing an interval between fires."""
+
+    def test_shorter_interval_keeps_phase(self, clock):
+        entry = SensorEntry(sensor=MagicMock(), interval_sec=60)
+        scheduler = SensorScheduler([entry], clock=clock)
+        scheduler.pop_due()
+        clock.t += 2
+        scheduler.set_interval(entry, 10)
+        assert entry.interval_sec == 10
+        assert scheduler.time_until_next() == pytest.approx(8)
+        clock.t += 8
+        assert scheduler.pop_due() == [entry]
+        assert scheduler.time_until_next() == pytest.approx(10)
+
+    def test_due_never_in_past(self, clock):
+        entry = SensorEntry(sensor=MagicMock(), interval_sec=60)
+        scheduler = SensorScheduler([entry], clock=clock)
+        scheduler.pop_due()
+        clock.t += 30
+        scheduler.set_interval(entry, 5)
+        assert scheduler.time_until_next() == 0
+        assert scheduler.pop_due() == [entry]
+        assert scheduler.stats()["MagicMock"].skipped == 0
+
+
+class TestIntervalParams:
+    """Tests for the read-only ivl params."""
+
+    def test_params_track_entries(self):
+        entries = [
+            SensorEntry(sensor=MagicMock(), interval_sec=60),
+            SensorEntry(sensor=MagicMock(), interval_sec=1),
+        ]
+        state = NodeState(
+            node_id="patio",
+            radio_state=RadioState(radio=MagicMock(), n2g_freq=915.0, g2n_freq=915.5),
+            config_path="",
+            sensor_entries=entries,
+        )
+        registry = CommandRegistry("patio")
+        commands_init(registry, state)
+        getparam = registry.lookup("getparam", "patio").callback
+        entries[0].interval_sec = 7.5
+        assert getparam("getparam", ["ivl0"]) == {"ivl0": 7.5}
+        assert getparam("getparam", ["ivl1"]) == {"ivl1": 1}
+
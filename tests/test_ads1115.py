@@ -0,0 +1,111 @@
+"""Tests for ADS1115 scan mode and robust averaging."""
+
+import time
+
+import pytest
+
+from sensors.ads1115_sensor import ADS1115ADC, robust_mean
+
+
+class FakeInput:
+    """AnalogIn stand-in returning a scripted sequence of voltages."""
+
+    def __init__(self, values):
+        self._values = list(values)
+        self.reads = 0
+
+    @property
+    def voltage(self):
+        value = self._values[self.reads % len(self._values)]
+        self.reads += 1
+        return value
+
+
+def scanning_adc(inputs, **kwargs):
+    adc = ADS1115ADC(channels=list(range(len(inputs))), scan=True, data_rate=860, **kwargs)
+    adc._analog_inputs = inputs
+    return adc
+
+
+class TestRobustMean:
+    """Tests for outlier-rejecting averaging."""
+
+    def test_plain_mean(self):
+        assert robust_mean([1.0, 2.0, 3.0, 10.0]) == pytest.approx(4.0)
+
+    def test_glitch_rejected(self):
+        values = [1.00, 1.01, 0.99, 1.02, 0.98, 3.3]
+        assert robust_mean(values, reject=3.0) == pytest.approx(1.0, abs=0.005)
+
+    def test_flat_with_outlier(self):
+        assert robust_mean([2.0, 2.0, 2.0, 5.0], reject=3.0) == 2.0
+
+    def test_too_few_to_judge(self):
+        assert robust_mean([1.0, 3.0], reject=1.0) == 2.0
+
+
+class TestScanMode:
+    """Tests for the background channel scan."""
+
+    def test_scan_once_averages_each_channel(self):
+        a0 = FakeInput([1.0, 1.0, 1.0, 2.5])
+        a1 = FakeInput([0.5])
+        adc = scanning_adc([a0, a1], samples=4, reject=3.0)
+        assert adc._scan_once() == (1.0, 0.5)
+        assert (a0.reads, a1.reads) == (4, 4)
+
+    def test_read_returns_latest_without_bus_access(self):
+        a0 = FakeInput([1.2])
+        adc = scanning_adc([a0], samples=2, scan_interval_sec=0.01)
+        adc._start_scan()
+        try:
+            assert adc.read() == (1.2,)
+            start = time.monotonic()
+            adc.read()
+            assert time.monotonic() - start < 0.01
+            assert adc.scans >= 1
+        finally:
+            adc.close()
+        assert adc._scan_thread is None
+
+    def test_stale_scan_fails_read(self):
+        adc = scanning_adc([FakeInput([1.2])], samples=2, scan_interval_sec=0.01)
+        adc._start_scan()
+        try:
+            assert adc.read() == (1.2,)
+        finally:
+            adc.close()
+        # Scan thread stuck or failing: the cached values go stale
+        adc._scan_at -= 10.0
+        with pytest.raises(TimeoutError, match="old"):
+            adc.read()
+
+    def test_unexpected_scan_error_keeps_thread_alive(self):
+        class FlakyInput(FakeInput):
+            @property
+            def voltage(self):
+                self.reads += 1
+                if self.reads == 1:
+                    raise ValueError("bad conversion")
+                return 0.7
+
+        adc = scanning_adc([FlakyInput([])], scan_interval_sec=0.01)
+        adc._start_scan()
+        try:
+            assert adc.read() == (0.7,)
+            assert adc.scan_errors == 1
+            assert adc._scan_thread.is_alive()
+        finally:
+            adc.close()
+
+    def test_single_shot_unchanged(self):
+        adc = ADS1115ADC(channels=[0, 1])
+        adc._analog_inputs = [FakeInput([1.0]), FakeInput([2.0])]
+        assert adc.read() == (1.0, 2.0)
+
+    @pytest.mark.parametrize("kwargs", [
+        {"data_rate": 100}, {"samples": 0}, {"reject": 0},
+    ])
+    def test_invalid_config(self, kwargs):
+        with pytest.raises(ValueError):
+            ADS1115ADC(**kwargs)
@@ -0,0 +1,110 @@
+"""Tests for on-node windowed statistics."""
+
+import statistics
+import time
+
+import pytest
+
+from node.aggregation import AggregatingSensor, RunningStats
+from node.sensor_reader import SensorEntry, read_entry
+from sensors import Sensor
+
+
+class SequenceSensor(Sensor):
+    """Returns successive (x, y) values from a list."""
+
+    def __init__(self, values):
+        self._values = iter(values)
+        self.closed = False
+
+    def init(self):
+        pass
+
+    def read(self):
+        return next(self._values)
+
+    def get_names(self):
+        return ("Accel X", "Accel Y")
+
+    def get_units(self):
+        return ("g", "g")
+
+    def close(self):
+        self.closed = True
+
+
+class TestRunningStats:
+    """Tests for the streaming accumulator."""
+
+    def test_matches_batch_stats(self):
+        data = [0.5, -1.25, 3.0, 2.0, 0.0, 7.5]
+        acc = RunningStats(keep_samples=True)
+        for v in data:
+            acc.add(v)
+        assert acc.count == 6
+        assert acc.mean == pytest.approx(statistics.fmean(data))
+        assert acc.std == pytest.approx(statistics.pstdev(data))
+        assert (acc.min, acc.max) == (-1.25, 7.5)
+        assert acc.percentile(50) == pytest.approx(statistics.median(data))
+
+    def test_reservoir_bounded(self):
+        acc = RunningStats(keep_samples=True, max_samples=10)
+        for v in range(1000):
+            acc.add(float(v))
+        assert len(acc.samples) == 10
+        assert acc.count == 1000
+
+
+class TestAggregatingSensor:
+    """Tests for the sensor wrapper."""
+
+    def make(self, values, **kwargs):
+        return AggregatingSensor(SequenceSensor(values), 0.01, **kwargs)
+
+    def test_names_and_units(self):
+        sensor = self.make([], stats=["max", "count"], percentiles=[95])
+        assert sensor.get_names() == (
+            "Accel X max", "Accel X count", "Accel X p95",
+            "Accel Y max", "Accel Y count", "Accel Y p95",
+        )
+        assert sensor.get_units() == ("g", "", "g", "g", "", "g")
+
+    def test_window_summary_and_reset(self):
+        sensor = self.make([(1.0, 0.0), (3.0, 0.0), (2.0, 0.0)], stats=["min", "max", "mean"])
+        for _ in range(3):
+            sensor.sample_once()
+        assert sensor.read() == (1.0, 3.0, 2.0, 0.0, 0.0, 0.0)
+        # New window is empty
+        assert sensor.read() == (None,) * 6
+
+    def test_empty_window_count_is_zero(self):
+        sensor = self.make([], stats=["count", "std"])
+        assert sensor.read() == (0, None, 0, None)
+
+    def test_invalid_stat(self):
+        with pytest.raises(ValueError):
+            self.make([], stats=["median"])
+
+    def test_entry_uses_inner_class(self):
+        sensor = self.make([(1.0, 2.0)], stats=["mean"])
+        sensor.sample_once()
+        entry = SensorEntry(sensor=sensor, interval_sec=60)
+        assert entry.class_name == "SequenceSensor"
+        readings = read_entry(entry, timestamp=0.0)
+        assert [(r.name, r.value, r.sensor_class) for r in readings] == [
+            ("Accel X mean", 1.0, "SequenceSensor"),
+            ("Accel Y mean", 2.0, "SequenceSensor"),
+        ]
+
+    def test_background_sampling(self):
+        inner = SequenceSensor((float(i), 0.0) for i in range(10_000))
+        sensor = AggregatingSensor(inner, 0.001, stats=["count"])
+        sensor.init()
+        try:
+            time.sleep(0.05)
+            count = sensor.read()[0]
+        finally:
+            sensor.close()
+        assert count > 0
+        assert inner.closed
+        assert sensor.sample_errors == 0
@@ -0,0 +1,132 @@
+"""Tests for the gateway alert rule engine and dispatcher."""
+
+from gateway.alerts import (
+    AlertDispatcher,
+    RateRule,
+    RuleEngine,
+    StaleRule,
+    ThresholdRule,
+    build_alert_manager,
+    format_alert,
+)
+from sensors.thresholds import AlertState, ThresholdConfig
+from utils.notifications import Notifier
+
+SOIL_ID = "patio_ads1115adc_a0"
+
+
+class RecordingNotifier(Notifier):
+    name = "recording"
+
+    def __init__(self, fail: bool = False):
+        self.sent = []
+        self.fail = fail
+
+    def send(self, subject, body):
+        if self.fail:
+            raise RuntimeError("boom")
+        self.sent.append((subject, body))
+        return True
+
+
+class TestRules:
+    """Tests for compiled rules."""
+
+    def test_engine_indexes_by_sensor_id(self):
+        engine = RuleEngine({SOIL_ID: [ThresholdRule(SOIL_ID, ThresholdConfig(low=1.5))]})
+        assert engine.check("other", 0.0, "V", 0.0) is None
+        (alert,) = engine.check(SOIL_ID, 1.0, "V", 0.0)
+        assert alert.new_state is AlertState.ALERT_LOW
+        assert engine.check(SOIL_ID, 1.0, "V", 1.0) is None
+
+    def test_rate_rule(self):
+        rule = RateRule(SOIL_ID, max_per_sec=0.5, hysteresis=0.1)
+        assert rule.check(1.0, "V", 0.0) is None  # First sample has no rate
+        alert = rule.check(2.0, "V", 1.0)
+        assert alert.new_state is AlertState.RATE_HIGH
+        assert alert.units == "V/s"
+        assert rule.check(2.45, "V", 2.0) is None  # 0.45/s, inside hysteresis
+        assert rule.check(2.5, "V", 3.0).is_recovery
+
+    def test_stale_rule(self):
+        rule = StaleRule(SOIL_ID, max_age_sec=60, now=1000.0)
+        assert rule.sweep(1059.0) is None
+        assert rule.sweep(1060.0).new_state is AlertState.STALE
+        assert rule.sweep(2000.0) is None  # Fires once
+        assert rule.check(1.0, "V", 2000.0).is_recovery
+
+    def test_engine_sweeps_stale_rules(self):
+        engine = RuleEngine({SOIL_ID: [StaleRule(SOIL_ID, 10, now=0.0)]})
+        assert len(engine.sweep_stale(now=11.0)) == 1
+        # Recovery comes through check(), alongside the other rules
+        engine.add_rules(SOIL_ID, [ThresholdRule(SOIL_ID, ThresholdConfig(low=1.5))])
+        alerts = engine.check(SOIL_ID, 1.0, "V", 12.0)
+        assert [a.new_state for a in alerts] == [AlertState.ALERT_LOW, AlertState.NORMAL]
+        assert engine.rule_count == 2
+
+
+class TestDispatcher:
+    """Tests for delivery and cooldown."""
+
+    def _alert(self):
+        rule = ThresholdRule(SOIL_ID, ThresholdConfig(low=1.5))
+        return rule.check(1.0, "V", 1700000000.0)
+
+    def test_cooldown(self):
+        notifier = RecordingNotifier()
+        dispatcher = AlertDispatcher([notifier], cooldown_sec=60)
+        alert = self._alert()
+        assert dispatcher.deliver(alert, now=0.0)
+        assert not dispatcher.deliver(alert, now=30.0)
+        assert dispatcher.deliver(alert, now=61.0)
+        assert len(notifier.sent) == 2
+
+    def test_cooldown_is_per_rule(self):
+        notifier = RecordingNotifier()
+        dispatcher = AlertDispatcher([notifier], cooldown_sec=60)
+        low = ThresholdRule(SOIL_ID, ThresholdConfig(low=1.5))
+        high = ThresholdRule(SOIL_ID, ThresholdConfig(high=3.0))
+        low.check(1.0, "V", 0.0)
+        high.check(3.5, "V", 0.0)
+        # Both recover: one rule's recovery doesn't hold back the other's
+        assert dispatcher.deliver(low.check(2.0, "V", 1.0), now=0.0)
+        assert dispatcher.deliver(high.check(2.0, "V", 1.0), now=1.0)
+        assert len(notifier.sent) == 2
+
+    def test_failing_notifier_is_isolated(self):
+        good = RecordingNotifier()
+        dispatcher = AlertDispatcher([RecordingNotifier(fail=True), good])
+        dispatcher.deliver(self._alert(), now=0.0)
+        assert len(good.sent) == 1
+
+    def test_format(self):
+        subject, body = format_alert(self._alert())
+        assert subject == f"[data_log] LOW ALERT: {SOIL_ID}"
+        assert "Value: 1.000 V" in body
+        assert "Limit: 1.5" in body
+
+
+class TestBuild:
+    """Tests for building from config."""
+
+    def test_disabled(self):
+        assert build_alert_manager({"thresholds": {SOIL_ID: {"low": 1.5}}}) is None
+
+    def test_invalid_rules_skipped(self):
+        config = {"enabled": True, "rules": {SOIL_ID: [{"type": "bogus"}]}}
+        assert build_alert_manager(config) is None
+
+    def test_thresholds_and_rules(self):
+        config = {
+            "enabled": True,
+            "thresholds": {SOIL_ID: {"low": 1.5, "hysteresis": 0.3}},
+            "rules": {SOIL_ID: [{"type": "stale", "max_age_sec": 900}]},
+        }
+        manager = build_alert_manager(config)
+        assert manager.engine.rule_count == 2
+
+    def test_check_queues_alerts(self):
+        config = {"enabled": True, "thresholds": {SOIL_ID: {"low": 1.5}}}
+        manager = build_alert_manager(config)
+        manager.check(SOIL_ID, 1.0, "V", 0.0)
+        assert manager._dispatcher._queue.qsize() == 1
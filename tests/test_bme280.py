@@ -0,0 +1,131 @@
+"""Tests for the register-level BME280 forced-mode driver."""
+
+import struct
+import sys
+import types
+
+import pytest
+
+from sensors.bme280_sensor import BME280TempPressureHumidity as BME280
+
+# Bosch datasheet compensation example (BMP280 section 3.12, same T/P formulas)
+CALIB_TP = (27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000)
+ADC_T = 519888
+ADC_P = 415148
+# Typical humidity calibration from a real part
+CALIB_H = {"H1": 75, "H2": 362, "H3": 0, "H4": 313, "H5": 50, "H6": 30}
+
+
+def calib_bytes():
+    tp = struct.pack("<HhhHhhhhhhhh", *CALIB_TP) + bytes([0, CALIB_H["H1"]])
+    h4, h5 = CALIB_H["H4"], CALIB_H["H5"]
+    h = struct.pack("<hB", CALIB_H["H2"], CALIB_H["H3"]) + bytes([
+        (h4 >> 4) & 0xFF, (h4 & 0x0F) | ((h5 & 0x0F) << 4), (h5 >> 4) & 0xFF,
+        CALIB_H["H6"] & 0xFF,
+    ])
+    return tp, h
+
+
+class FakeBus:
+    """BME280 register model; busy for one status poll after each trigger."""
+
+    def __init__(self, _num):
+        self.writes = []
+        self.block_reads = []
+        self.busy_polls = 0
+        self.adc_h = 30000
+
+    def read_byte_data(self, _addr, reg):
+        if reg == BME280.REG_CHIP_ID:
+            return BME280.CHIP_ID
+        if reg == BME280.REG_STATUS:
+            if self.busy_polls:
+                self.busy_polls -= 1
+                return BME280.STATUS_MEASURING
+            return 0
+        return 0
+
+    def write_byte_data(self, _addr, reg, value):
+        self.writes.append((reg, value))
+        if reg == BME280.REG_CTRL_MEAS and value & 0x03:
+            self.busy_polls = 1
+
+    def read_i2c_block_data(self, _addr, reg, length):
+        self.block_reads.append((reg, length))
+        tp, h = calib_bytes()
+        if reg == BME280.REG_CALIB_TP:
+            return list(tp[:length])
+        if reg == BME280.REG_CALIB_H:
+            return list(h[:length])
+        assert (reg, length) == (BME280.REG_DATA, 8)
+        return [
+            ADC_P >> 12, (ADC_P >> 4) & 0xFF, (ADC_P & 0xF) << 4,
+            ADC_T >> 12, (ADC_T >> 4) & 0xFF, (ADC_T & 0xF) << 4,
+            self.adc_h >> 8, self.adc_h & 0xFF,
+        ]
+
+    def close(self):
+        pass
+
+
+@pytest.fixture
+def fake_smbus(monkeypatch):
+    monkeypatch.setitem(sys.modules, "smbus2", types.SimpleNamespace(SMBus=FakeBus))
+    monkeypatch.setattr("sensors.bme280_sensor.sleep", lambda s: None)
+
+
+class TestBME280:
+    """Tests for calibration, compensation and the forced-mode sequence."""
+
+    def test_calibration_decoded(self, fake_smbus):
+        sensor = BME280()
+        sensor.init()
+        assert sensor._calib["T1"] == 27504 and sensor._calib["P9"] == 6000
+        assert {k: sensor._calib[k] for k in CALIB_H} == CALIB_H
+
+    def test_datasheet_example(self, fake_smbus):
+        sensor = BME280()
+        sensor.init()
+        temp_f, pressure, humidity = sensor.read()
+        assert (temp_f - 32) * 5 / 9 == pytest.approx(25.08, abs=0.01)
+        assert pressure == pytest.approx(1006.5327, abs=0.01)
+        assert 0.0 <= humidity <= 100.0
+        sensor._bus.raw.adc_h = 35000
+        assert sensor.read()[2] > humidity
+
+    def test_one_trigger_one_burst_per_read(self, fake_smbus):
+        sensor = BME280(oversampling={"temperature": 2, "pressure": 16, "humidity": 1},
+                        iir_filter=4)
+        sensor.init()
+        bus = sensor._bus.raw
+        assert (BME280.REG_CONFIG, 2 << 2) in bus.writes
+        assert (BME280.REG_CTRL_HUM, 1) in bus.writes
+        bus.writes.clear()
+        bus.block_reads.clear()
+
+        sensor.read()
+        assert bus.writes == [(BME280.REG_CTRL_MEAS, (2 << 5) | (5 << 2) | 0x01)]
+        assert bus.block_reads == [(BME280.REG_DATA, 8)]
+
+    def test_measurement_time(self, fake_smbus):
+        sensor = BME280(oversampling={"temperature": 1, "pressure": 1, "humidity": 1},
+                        report_timing=True)
+        assert sensor.max_measurement_ms == pytest.approx(9.3)
+        sensor.init()
+        values = sensor.read()
+        assert sensor.get_names()[-1] == "Measure Time"
+        assert values[-1] == sensor.measurement_ms >= 0
+
+    def test_skipped_channel_is_none(self, fake_smbus):
+        sensor = BME280(oversampling={"humidity": 0})
+        sensor.init()
+        assert sensor.read()[2] is None
+
+    @pytest.mark.parametrize("kwargs", [
+        {"oversampling": {"pressure": 3}},
+        {"oversampling": {"temperature": 0}},
+        {"iir_filter": 5},
+    ])
+    def test_invalid_config(self, kwargs):
+        with pytest.raises(ValueError):
+            BME280(**kwargs)
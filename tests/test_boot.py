@@ -0,0 +1,196 @@
+"""Tests for node cold start: lazy drivers, concurrent init, boot timing."""
+
+import subprocess
+import sys
+import time
+
+import pytest
+
+import sensors
+from node.boot import (
+    PHASE_RADIO_INIT,
+    PHASE_SENSOR_INIT,
+    BootTimer,
+    InitRetry,
+    SensorInitPending,
+    init_concurrently,
+)
+from node.data_log import instantiate_sensors
+from node.sensor_reader import SensorEntry, read_entry
+from sensors import Sensor
+from utils.gateway_state import GatewayState
+from utils.protocol import build_lora_packets, parse_sensor_frame
+
+
+class SlowSensor(Sensor):
+    """Sensor whose init() blocks like a hardware settle delay."""
+
+    def __init__(self, delay=0.2, fail=False):
+        self.delay = delay
+        self.fail = fail
+        self.initialized = False
+
+    def init(self):
+        time.sleep(self.delay)
+        if self.fail:
+            raise OSError("no ACK on I2C")
+        self.initialized = True
+
+    def read(self):
+        return (1.0,)
+
+    def get_names(self):
+        return ("Value",)
+
+    def get_units(self):
+        return ("",)
+
+
+class TestLazyDrivers:
+    """Tests for by-name driver loading."""
+
+    def test_package_import_loads_no_drivers(self):
+        code = (
+            "import sys, sensors; "
+            "print(any(m.startswith('sensors.') and m != 'sensors.base' "
+            "for m in sys.modules))"
+        )
+        out = subprocess.run(
+            [sys.executable, "-c", code], capture_output=True, text=True, check=True
+        )
+        assert out.stdout.strip() == "False"
+
+    def test_load_by_name(self):
+        cls = sensors.load_sensor_class("ADS1115ADC")
+        assert cls.__name__ == "ADS1115ADC"
+        assert issubclass(cls, Sensor)
+        assert sensors.load_sensor_class("NoSuchSensor") is None
+
+    def test_attribute_access_still_works(self):
+        from sensors import MMA8452Accelerometer
+
+        assert MMA8452Accelerometer is sensors.load_sensor_class("MMA8452Accelerometer")
+        with pytest.raises(AttributeError):
+            sensors.NoSuchSensor
+
+
+class TestInitConcurrently:
+    """Tests for parallel sensor init()."""
+
+    def test_inits_overlap(self):
+        slow = [SlowSensor(0.2) for _ in range(4)]
+        start = time.monotonic()
+        results = init_concurrently(slow)
+        assert time.monotonic() - start < 0.6
+        assert all(s.initialized for s in slow)
+        assert all(r.error is None and r.elapsed_sec >= 0.2 for r in results)
+
+    def test_failure_isolated_and_order_kept(self):
+        slow = [SlowSensor(0.05), SlowSensor(0.01, fail=True), SlowSensor(0.0)]
+        results = init_concurrently(slow)
+        assert [r.error is None for r in results] == [True, False, True]
+        assert isinstance(results[1].error, OSError)
+
+    def test_sequential(self):
+        slow = [SlowSensor(0.05) for _ in range(3)]
+        start = time.monotonic()
+        init_concurrently(slow, max_workers=0)
+        assert time.monotonic() - start >= 0.15
+
+
+class TestInitRetry:
+    """Tests for retrying sensors that failed init() at start-up."""
+
+    def test_failed_sensor_kept_for_retry(self):
+        entries = instantiate_sensors(
+            [{"class": "SimulatedBME280", "config": {"init_fail": True}},
+             {"class": "SimulatedADS1115"}],
+            60,
+        )
+        assert [e.init_retry is not None for e in entries] == [True, False]
+        with pytest.raises(SensorInitPending):
+            read_entry(entries[0], 0.0)
+
+    def test_retried_with_backoff_until_ready(self, clock):
+        sensor = SlowSensor(0.0, fail=True)
+        entry = SensorEntry(sensor, 10, init_retry=InitRetry(OSError("boot"), 5, 20, clock=clock))
+        with pytest.raises(SensorInitPending):
+            read_entry(entry, 0.0)
+
+        clock.t = 5.0
+        with pytest.raises(OSError):
+            read_entry(entry, 0.0)
+        # Wait doubled after the failed retry
+        clock.t = 14.0
+        with pytest.raises(SensorInitPending):
+            read_entry(entry, 0.0)
+
+        sensor.fail = False
+        clock.t = 15.0
+        assert [r.value for r in read_entry(entry, 0.0)] == [1.0]
+        assert entry.init_retry is None and sensor.initialized
+
+
+class TestBootTimer:
+    """Tests for the boot-to-first-packet breakdown."""
+
+    def test_readings(self, clock):
+        boot = BootTimer(clock=clock)
+        boot.imports_sec = 1.5
+        boot.since_kernel_sec = None
+        with boot.phase(PHASE_SENSOR_INIT):
+            clock.t += 1.2
+        with boot.phase(PHASE_RADIO_INIT):
+            clock.t += 0.3
+        assert boot.first_packet_sec is None
+        clock.t += 0.5
+        boot.mark_first_packet()
+        clock.t += 10
+        boot.mark_first_packet()  # Ignored: only the first counts
+
+        values = {r.name: r.value for r in boot.readings()}
+        assert values == {
+            "Boot Imports": 1.5,
+            "Boot Sensor Init": 1.2,
+            "Boot Radio Init": 0.3,
+            "Boot First Packet": 3.5,
+        }
+        assert all(r.sensor_class == "NodeTelemetry" and r.units == "s"
+                   for r in boot.readings())
+
+    def test_process_start_measured(self):
+        boot = BootTimer()
+        if sys.platform.startswith("linux"):
+            assert 0.0 <= boot.imports_sec < 3600
+
+    def test_report_round_trips(self, clock):
+        boot = BootTimer(clock=clock)
+        boot.since_kernel_sec = 12.0
+        for phase in (PHASE_SENSOR_INIT, PHASE_RADIO_INIT):
+            with boot.phase(phase):
+                clock.t += 1.0
+        boot.mark_first_packet()
+
+        packets = build_lora_packets("patio", boot.readings())
+        received = [r for p in packets for r in parse_sensor_frame(p).readings]
+        assert {r.name for r in received} == {
+            "Boot Since Kernel", "Boot Imports", "Boot Sensor Init",
+            "Boot Radio Init", "Boot First Packet",
+        }
+
+
+class TestGatewayBootTracking:
+    """Tests for the per-node boot record on the gateway."""
+
+    def test_latest_report_per_node(self):
+        state = GatewayState()
+        state.update_node_boot("patio", {"First Packet": 20.1})
+        state.update_node_boot("patio", {"First Packet": 3.2})
+        state.update_node_boot("shed", {"First Packet": 4.0})
+
+        boots = state.get_node_boots()
+        assert boots["patio"].timings == {"First Packet": 3.2}
+        assert set(boots) == {"patio", "shed"}
+        # Copies: callers can't mutate shared state
+        boots["patio"].timings["First Packet"] = 0
+        assert state.get_node_boots()["patio"].timings["First Packet"] == 3.2
@@ -0,0 +1,114 @@
+"""Tests for compiled calibration pipelines."""
+
+import math
+import sys
+
+import numpy as np
+import pytest
+
+from sensors.ads1115_sensor import ADS1115ADC
+from sensors.base import Sensor
+from sensors.calibration import CalibrationPipeline
+
+NAMES = ("Raw", "Temp", "Cond")
+
+
+class TwoReadingSensor(Sensor):
+    def init(self): pass
+    def read(self): return (2.0, 30.0)
+    def get_names(self): return ("Level", "Temperature")
+    def get_units(self): return ("cm", "C")
+
+
+class TestSteps:
+    """Tests for each step type, scalar and batch paths agreeing."""
+
+    @pytest.mark.parametrize("spec, raw, expected", [
+        ({"type": "linear", "scale": 2.0, "offset": -1.0}, 3.0, 5.0),
+        ({"type": "poly", "coeffs": [1.0, 0.0, 2.0]}, 3.0, 19.0),
+        ({"type": "table", "points": [[0, 0], [1, 10], [3, 50]]}, 2.0, 30.0),
+        ({"type": "table", "points": [[1, 10], [0, 0]]}, 5.0, 10.0),  # Sorted, clamped
+        ({"type": "normalize", "raw_min": 1.0, "raw_max": 3.0, "invert": True}, 1.5, 0.75),
+    ])
+    def test_scalar_and_batch(self, spec, raw, expected):
+        pipeline = CalibrationPipeline.compile({"Raw": spec}, NAMES)
+        assert pipeline.apply((raw, 20.0, 1.0)) == pytest.approx((expected, 20.0, 1.0))
+        batch = pipeline.apply_batch([(raw, 20.0, 1.0)] * 3)
+        assert batch[:, 0] == pytest.approx([expected] * 3)
+
+    def test_steps_chain_in_order(self):
+        pipeline = CalibrationPipeline.compile({"Raw": [
+            {"type": "linear", "scale": 10.0},
+            {"type": "table", "points": [[0, 0], [100, 1]]},
+        ]}, NAMES)
+        assert pipeline.apply((5.0, 0, 0))[0] == pytest.approx(0.5)
+
+    def test_temperature_uses_calibrated_reference(self):
+        pipeline = CalibrationPipeline.compile({
+            "Cond": {"type": "temperature", "reading": "Temp", "coeff": 0.02, "mode": "scale"},
+            "Temp": {"type": "linear", "offset": 5.0},
+        }, NAMES)
+        # Temp 30 -> 35 after its own calibration; 1 + 0.02 * (35 - 25) = 1.2
+        assert pipeline.apply((0.0, 30.0, 100.0)) == pytest.approx((0.0, 35.0, 120.0))
+        assert pipeline.apply_batch([(0.0, 30.0, 100.0)])[0, 2] == pytest.approx(120.0)
+
+    def test_none_passes_through(self):
+        pipeline = CalibrationPipeline.compile({
+            "Raw": {"type": "linear", "scale": 2.0},
+            "Cond": {"type": "temperature", "reading": "Temp", "coeff": 1.0},
+        }, NAMES)
+        assert pipeline.apply((None, None, 5.0)) == (None, None, None)
+        assert math.isnan(pipeline.apply_batch([(None, 20.0, 1.0)])[0, 0])
+
+    @pytest.mark.parametrize("config", [
+        {"Nope": {"type": "linear"}},
+        {"Raw": {"type": "cubic"}},
+        {"Raw": {"type": "poly", "coeffs": []}},
+        {"Raw": {"type": "table", "points": [[1, 2]]}},
+        {"Raw": {"type": "table", "points": [[1, 2], [1, 3]]}},
+        {"Raw": {"type": "normalize", "raw_min": 3, "raw_max": 1}},
+        {"Raw": {"type": "temperature", "reading": "Missing", "coeff": 1}},
+        {"Raw": {"type": "temperature", "reading": "Temp", "coeff": 1},
+         "Temp": {"type": "temperature", "reading": "Cond", "coeff": 1}},
+    ])
+    def test_invalid_config(self, config):
+        with pytest.raises(ValueError):
+            CalibrationPipeline.compile(config, NAMES)
+
+
+class TestBatch:
+    """Tests for the window path."""
+
+    def test_matches_scalar_on_window(self):
+        config = {
+            "Raw": [{"type": "poly", "coeffs": [0.1, 1.5, -0.02]},
+                    {"type": "table", "points": [[0, 0], [5, 40], [20, 100]]}],
+            "Cond": {"type": "temperature", "reading": "Temp", "coeff": -0.3},
+        }
+        pipeline = CalibrationPipeline.compile(config, NAMES)
+        rng = np.random.default_rng(1)
+        window = np.column_stack([rng.uniform(0, 15, 500), rng.uniform(0, 40, 500),
+                                  rng.uniform(0, 3, 500)])
+        expected = np.array([pipeline.apply(tuple(row)) for row in window])
+        assert pipeline.apply_batch(window) == pytest.approx(expected)
+
+    def test_without_numpy(self, monkeypatch):
+        monkeypatch.setitem(sys.modules, "numpy", None)
+        pipeline = CalibrationPipeline.compile({"Raw": {"type": "linear", "scale": 2}}, NAMES)
+        assert pipeline.apply_batch([(1.0, 0, 0), (2.0, 0, 0)]) == [(2.0, 0, 0), (4.0, 0, 0)]
+
+
+class TestSensorIntegration:
+    """Tests for set_calibration() and transform()."""
+
+    def test_any_sensor_calibrates_through_transform(self):
+        sensor = TwoReadingSensor()
+        assert sensor.transform((2.0, 30.0)) == (2.0, 30.0)
+        sensor.set_calibration({"Level": {"type": "linear", "scale": 100.0}})
+        assert sensor.transform(sensor.read()) == (200.0, 30.0)
+
+    def test_ads1115_transforms_run_before_calibration(self):
+        adc = ADS1115ADC(channels=[0], names=["Moisture"],
+                         transforms={"0": {"raw_min": 1.0, "raw_max": 3.0}})
+        adc.set_calibration({"Moisture": {"type": "linear", "scale": 100.0}})
+        assert adc.transform((2.0,)) == pytest.approx((50.0,))
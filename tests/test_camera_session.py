@@ -0,0 +1,130 @@
+"""Tests for the warm Arducam camera session."""
+
+import sys
+import types
+
+import numpy as np
+import pytest
+
+from sensors.camera_session import CameraSession, parse_size
+
+
+class FakeTransform:
+    def __init__(self, hflip=False, vflip=False):
+        self.hflip = hflip
+        self.vflip = vflip
+
+
+class FakePicamera2:
+    """Records the calls the session makes; AE converges on the third frame."""
+
+    instances = []
+
+    def __init__(self):
+        self.calls = []
+        self.frames = 0
+        self.started = False
+        self.closed = False
+        FakePicamera2.instances.append(self)
+
+    def create_preview_configuration(self, main, transform, buffer_count):
+        return {"mode": "preview", "size": main["size"], "transform": transform}
+
+    def create_still_configuration(self, main, transform, buffer_count):
+        return {"mode": "still", "size": main["size"], "transform": transform}
+
+    def configure(self, config):
+        self.calls.append(("configure", config["mode"]))
+
+    def start(self):
+        self.started = True
+
+    def stop(self):
+        self.started = False
+
+    def close(self):
+        self.closed = True
+
+    def capture_metadata(self):
+        self.frames += 1
+        return {"AeLocked": self.frames >= 3}
+
+    def switch_mode_and_capture_file(self, config, path):
+        self.calls.append(("still_file", config["size"], path))
+
+    def switch_mode_and_capture_array(self, config, name):
+        self.calls.append(("still_array", config["size"]))
+        width, height = config["size"]
+        return np.arange(width * height).reshape(height, width)
+
+
+@pytest.fixture(autouse=True)
+def fake_camera(monkeypatch):
+    FakePicamera2.instances = []
+    monkeypatch.setitem(sys.modules, "picamera2", types.SimpleNamespace(Picamera2=FakePicamera2))
+    monkeypatch.setitem(sys.modules, "libcamera", types.SimpleNamespace(Transform=FakeTransform))
+
+
+class TestCameraSession:
+    """Tests for open-once captures, ROI crops and the idle release."""
+
+    def test_parse_size(self):
+        assert parse_size("4056x3040") == (4056, 3040)
+        assert parse_size([640, 480]) == (640, 480)
+
+    def test_opens_once_and_streams_preview(self, tmp_path):
+        with CameraSession(size=(40, 30), idle_timeout_sec=None) as session:
+            session.capture_file(tmp_path / "a.jpg")
+            session.capture_file(tmp_path / "b.jpg")
+            assert session.is_open
+        assert len(FakePicamera2.instances) == 1
+        camera = FakePicamera2.instances[0]
+        assert camera.calls[0] == ("configure", "preview")
+        assert camera.calls[1:] == [
+            ("still_file", (40, 30), str(tmp_path / "a.jpg")),
+            ("still_file", (40, 30), str(tmp_path / "b.jpg")),
+        ]
+        # Waited for AE before the first still only
+        assert camera.frames == 3
+        assert camera.closed and not session.is_open
+
+    def test_flip_in_isp_transform(self):
+        session = CameraSession(size=(40, 30), flip=True, idle_timeout_sec=None)
+        session.open()
+        transform = session._still_config["transform"]
+        assert transform.hflip and transform.vflip
+        session.close()
+
+    def test_roi_crop(self):
+        session = CameraSession(size=(40, 30), idle_timeout_sec=None)
+        roi = session.capture_array(roi=(10, 5, 4, 2))
+        assert roi.shape == (2, 4)
+        assert roi[0, 0] == 5 * 40 + 10
+        assert session.capture_array().shape == (30, 40)
+        session.close()
+
+    def test_idle_release_and_reopen(self, tmp_path, clock):
+        session = CameraSession(size=(40, 30), idle_timeout_sec=0.02, clock=clock)
+        session.capture_file(tmp_path / "a.jpg")
+        clock.t = 1.0
+        session._watcher.join(timeout=2.0)
+        assert not session.is_open and FakePicamera2.instances[0].closed
+        session.capture_file(tmp_path / "b.jpg")
+        assert session.opens == 2 and session.is_open
+        session.close()
+
+    def test_failed_open_closes_camera(self, monkeypatch):
+        def boom(self, config):
+            raise RuntimeError("camera busy")
+        monkeypatch.setattr(FakePicamera2, "configure", boom)
+        session = CameraSession(idle_timeout_sec=None)
+        with pytest.raises(RuntimeError):
+            session.open()
+        assert FakePicamera2.instances[0].closed and not session.is_open
+
+    def test_from_config(self):
+        session = CameraSession.from_config(
+            {"size": "2028x1520", "flip": False, "idle_timeout_sec": 0}
+        )
+        assert session._size == (2028, 1520)
+        assert session._idle_timeout is None
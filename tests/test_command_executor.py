@@ -0,0 +1,136 @@
+"""Tests for off-radio command handler execution."""
+
+import threading
+
+import pytest
+
+from node.command_executor import DISPATCHED, DUPLICATE, IN_FLIGHT, CommandExecutor
+from utils.command_registry import CommandRegistry, CommandScope
+from utils.protocol import build_command_packet, parse_ack_packet, parse_command_packet
+
+
+class AckRecorder:
+    """Collects sent ACKs; wait_for() blocks until enough have arrived."""
+
+    def __init__(self):
+        self.acks = []
+        self._cond = threading.Condition()
+
+    def __call__(self, packet, add_jitter=False):
+        with self._cond:
+            self.acks.append(parse_ack_packet(packet))
+            self._cond.notify_all()
+        return True
+
+    def wait_for(self, count, timeout=2.0):
+        with self._cond:
+            assert self._cond.wait_for(lambda: len(self.acks) >= count, timeout)
+
+
+def command(name, *args, node_id="patio"):
+    packet, _ = build_command_packet(name, list(args), node_id)
+    return parse_command_packet(packet)
+
+
+@pytest.fixture
+def gate():
+    return threading.Event()
+
+
+@pytest.fixture
+def registry(gate):
+    registry = CommandRegistry("patio")
+
+    def slow(_cmd, _args):
+        gate.wait(2.0)
+        return {"r": "done"}
+
+    registry.register("slow", slow, CommandScope.ANY, early_ack=False)
+    registry.register("blocking", lambda c, a: gate.wait(2.0), CommandScope.ANY)
+    registry.register("fast", lambda c, a: {"r": 1}, CommandScope.ANY, early_ack=False)
+    registry.register(
+        "radio", lambda c, a: {"r": threading.current_thread().name},
+        CommandScope.ANY, early_ack=False, inline=True,
+    )
+    return registry
+
+
+@pytest.fixture
+def acks():
+    return AckRecorder()
+
+
+@pytest.fixture
+def executor(registry, acks, gate):
+    executor = CommandExecutor(registry, "patio", acks, max_workers=2)
+    yield executor
+    gate.set()
+    executor.close()
+
+
+class TestCommandExecutor:
+    """Tests for ACK timing, dedup and the handler pool."""
+
+    def test_late_ack_sent_when_handler_finishes(self, executor, acks, gate):
+        cmd = command("slow")
+        assert executor.submit(cmd) == DISPATCHED
+        # submit() returned while the handler is still blocked
+        assert acks.acks == []
+        assert executor.in_flight_count == 1
+
+        gate.set()
+        acks.wait_for(1)
+        assert acks.acks[0].command_id == cmd.get_command_id()
+        assert acks.acks[0].payload == {"r": "done"}
+        assert executor.in_flight_count == 0
+
+    def test_retry_while_running_not_started_twice(self, executor, acks, gate):
+        calls = []
+        executor._registry.register(
+            "count", lambda c, a: calls.append(1) or gate.wait(2.0),
+            CommandScope.ANY, early_ack=False,
+        )
+        cmd = command("count")
+        executor.submit(cmd)
+        assert executor.submit(cmd) == IN_FLIGHT
+
+        gate.set()
+        acks.wait_for(1)
+        assert len(calls) == 1
+
+    def test_retry_after_finish_gets_cached_ack(self, executor, acks, gate):
+        gate.set()
+        cmd = command("slow")
+        executor.submit(cmd)
+        acks.wait_for(1)
+
+        assert executor.submit(cmd) == DUPLICATE
+        acks.wait_for(2)
+        assert acks.acks[1] == acks.acks[0]
+
+    def test_early_ack_before_blocking_handler(self, executor, acks):
+        cmd = command("blocking")
+        executor.submit(cmd)
+        assert len(acks.acks) == 1
+        assert acks.acks[0].payload is None
+        # Other commands still get through while it runs
+        executor.submit(command("fast"))
+        acks.wait_for(2)
+        assert acks.acks[1].payload == {"r": 1}
+
+    def test_inline_handler_runs_on_caller_thread(self, executor, acks):
+        executor.submit(command("radio"))
+        assert acks.acks[0].payload == {"r": threading.current_thread().name}
+
+    def test_unknown_command_acked(self, executor, acks):
+        executor.submit(command("nope"))
+        assert len(acks.acks) == 1
+
+    def test_ack_cache_bounded(self, registry, acks):
+        executor = CommandExecutor(registry, "patio", acks, max_workers=0, ack_cache_size=2)
+        first = command("fast")
+        executor.submit(first)
+        for i in range(2):
+            executor.submit(command("fast", str(i)))
+        # Evicted from the cache: runs again
+        assert executor.submit(first) == DISPATCHED
@@ -0,0 +1,97 @@
+"""Tests for report-by-exception (deadband) transmission."""
+
+import pytest
+
+from gateway.alerts import StaleRule
+from gateway.series_registry import SeriesRegistry
+from node.deadband import DeadbandConfig, DeadbandFilter
+from utils.protocol import SensorReading, build_lora_packets, parse_lora_packet
+
+
+def soil(value):
+    return SensorReading(
+        name="A0", units="V", value=value, sensor_class="ADS1115ADC", timestamp=1.0
+    )
+
+
+@pytest.fixture
+def deadband(clock):
+    config = DeadbandConfig(abs=0.05, rel=0.01, heartbeat_sec=900)
+    return DeadbandFilter({0: config}, clock=clock)
+
+
+class TestDeadbandFilter:
+    """Tests for the node-side filter."""
+
+    def test_first_reading_sent(self, deadband):
+        (sent,) = deadband.filter(0, [soil(2.0)])
+        assert sent.heartbeat_sec == 900
+
+    def test_small_changes_suppressed(self, deadband):
+        deadband.filter(0, [soil(2.0)])
+        assert deadband.filter(0, [soil(2.04)]) == []
+        assert deadband.filter(0, [soil(1.96)]) == []
+        assert deadband.suppressed == 2
+
+    def test_drift_measured_from_last_sent(self, deadband):
+        deadband.filter(0, [soil(2.0)])
+        for v in (2.03, 2.04):
+            assert deadband.filter(0, [soil(v)]) == []
+        assert len(deadband.filter(0, [soil(2.06)])) == 1
+
+    def test_relative_band(self, clock):
+        f = DeadbandFilter({0: DeadbandConfig(rel=0.1)}, clock=clock)
+        f.filter(0, [soil(100.0)])
+        assert f.filter(0, [soil(109.0)]) == []
+        assert len(f.filter(0, [soil(111.0)])) == 1
+
+    def test_heartbeat(self, deadband, clock):
+        deadband.filter(0, [soil(2.0)])
+        clock.t = 899.0
+        assert deadband.filter(0, [soil(2.0)]) == []
+        clock.t = 900.0
+        assert len(deadband.filter(0, [soil(2.0)])) == 1
+
+    def test_other_sensors_pass_through(self, deadband):
+        other = SensorReading("Temperature", "C", 20.0, "BME280TempPressureHumidity", 1.0)
+        assert deadband.filter(1, [other, other]) == [other, other]
+
+    def test_same_class_entries_kept_apart(self, clock):
+        # Two ADS1115s: only the first has a band; the second always sends
+        f = DeadbandFilter({0: DeadbandConfig(abs=0.5)}, clock=clock)
+        f.filter(0, [soil(2.0)])
+        assert f.filter(1, [soil(2.1)]) == [soil(2.1)]
+        # The second ADC's value isn't the first one's reference
+        assert f.filter(0, [soil(2.1)]) == []
+
+    def test_config_validation(self):
+        assert DeadbandConfig.from_config(None) is None
+        with pytest.raises(ValueError):
+            DeadbandConfig.from_config({"heartbeat_sec": 60})
+
+
+class TestHeartbeatOnGateway:
+    """Tests for heartbeat transport and gateway series status."""
+
+    def test_heartbeat_round_trip(self, deadband):
+        packets = build_lora_packets("patio", deadband.filter(0, [soil(2.0)]))
+        _, (reading,) = parse_lora_packet(packets[0])
+        assert reading.heartbeat_sec == 900
+
+    def test_plain_readings_have_no_heartbeat(self):
+        (packet,) = build_lora_packets("patio", [soil(2.0)])
+        assert b'"h"' not in packet
+
+    def test_series_status(self):
+        series = SeriesRegistry().get("patio", "ADS1115ADC", "A0", "V")
+        assert series.status(now=0.0) == "reporting"
+        series.heartbeat_sec = 900
+        series.last_seen = 1000.0
+        assert series.status(now=2000.0) == "unchanged"
+        assert series.status(now=2400.0) == "missing"
+
+    def test_stale_rule_allows_heartbeat(self):
+        rule = StaleRule("patio_ads1115adc_a0", max_age_sec=300, now=0.0)
+        rule.heartbeat_sec = 900
+        assert rule.sweep(1000.0) is None
+        assert rule.sweep(1350.0) is not None
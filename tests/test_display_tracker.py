@@ -0,0 +1,118 @@
+"""Tests for display ROI tracking and OCR change gating."""
+
+import numpy as np
+import pytest
+
+from sensors.display_tracker import DisplayTracker, iou, thumbnail
+
+
+def frame(x=200, y=150, digits=(1, 0, 1), brightness=1.0, shape=(480, 640)):
+    """Light background with a dark display panel; each digit is a lit bar pattern."""
+    image = np.full(shape, 200.0)
+    image[y:y + 60, x:x + 120] = 30.0
+    for n, lit in enumerate(digits):
+        if lit:
+            image[y + 10:y + 50, x + 10 + n * 35:x + 30 + n * 35] = 240.0
+    return (image * brightness).clip(0, 255).astype(np.uint8)
+
+
+def find_panel(image):
+    """Stand-in for detect_display: bounding box of the dark pixels."""
+    ys, xs = np.nonzero(image < 100)
+    if len(xs) == 0:
+        return []
+    x, y = int(xs.min()), int(ys.min())
+    return [(x, y, int(xs.max()) - x + 1, int(ys.max()) - y + 1)]
+
+
+class Recognizer:
+    def __init__(self):
+        self.calls = 0
+
+    def __call__(self, image, roi):
+        self.calls += 1
+        x, y, w, h = roi
+        patch = image[y:y + h, x:x + w]
+        return "".join(
+            "1" if patch[30, 20 + n * 35] > patch[5, 5] * 2 else "0" for n in range(3)
+        )
+
+
+@pytest.fixture
+def tracker():
+    detections = []
+
+    def detect(image):
+        detections.append(image.shape)
+        return find_panel(image)
+
+    recognize = Recognizer()
+    t = DisplayTracker(detect=detect, recognize=recognize)
+    t.full_searches = lambda: sum(1 for s in detections if s == (480, 640))
+    t.recognizer = recognize
+    return t
+
+
+class TestDisplayTracker:
+    """Tests for detect-once, local verification and skipped OCR."""
+
+    def test_unchanged_display_skips_ocr(self, tracker):
+        assert tracker.read(frame()) == "101"
+        assert tracker.read(frame()) == "101"
+        assert tracker.recognizer.calls == 1
+        assert tracker.full_searches() == 1
+        assert tracker.stats.tracked == 1 and tracker.stats.skipped == 1
+
+    def test_changed_digits_recognized(self, tracker):
+        tracker.read(frame(digits=(1, 0, 1)))
+        assert tracker.read(frame(digits=(1, 1, 1))) == "111"
+        assert tracker.recognizer.calls == 2
+
+    def test_exposure_drift_is_not_a_change(self, tracker):
+        tracker.read(frame())
+        tracker.read(frame(brightness=0.85))
+        assert tracker.recognizer.calls == 1
+
+    def test_small_move_tracked_locally(self, tracker):
+        tracker.read(frame())
+        assert tracker.read(frame(x=206, y=147)) == "101"
+        assert tracker.roi == (206, 147, 120, 60)
+        assert tracker.full_searches() == 1
+        assert tracker.recognizer.calls == 1
+
+    def test_large_move_redetects(self, tracker):
+        tracker.read(frame())
+        assert tracker.read(frame(x=450, y=350)) == "101"
+        assert tracker.roi[:2] == (450, 350)
+        assert tracker.full_searches() == 2
+
+    def test_display_lost(self, tracker):
+        tracker.read(frame())
+        assert tracker.read(np.full((480, 640), 200, dtype=np.uint8)) is None
+        assert tracker.roi is None and tracker.result is None
+        assert tracker.read(frame()) == "101"
+        assert tracker.recognizer.calls == 2
+
+    def test_recognize_requires_locate(self, tracker):
+        with pytest.raises(RuntimeError):
+            tracker.recognize(frame())
+
+
+class TestHelpers:
+    """Tests for box overlap and thumbnails."""
+
+    def test_iou(self):
+        assert iou((0, 0, 10, 10), (0, 0, 10, 10)) == 1.0
+        assert iou((0, 0, 10, 10), (5, 0, 10, 10)) == pytest.approx(50 / 150)
+        assert iou((0, 0, 10, 10), (20, 20, 5, 5)) == 0.0
+
+    def test_thumbnail_grid_is_stable(self):
+        image = frame()
+        a = thumbnail(image[150:210, 200:320], columns=16)
+        b = thumbnail(image[150:211, 200:321], columns=16, rows=a.shape[0])
+        assert a.shape == b.shape == (8, 16)
+        assert np.abs(a - b).max() < 0.2
+        assert a.min() == 0.0 and a.max() == 1.0
+
+    def test_flat_thumbnail(self):
+        assert not thumbnail(np.full((20, 40, 3), 90, dtype=np.uint8)).any()
@@ -0,0 +1,156 @@
+"""Tests for low-power RX duty cycling and radio energy accounting."""
+
+import math
+
+import pytest
+
+from node.duty_cycle import DutyCycle
+from node.telemetry import NodeTelemetry
+from utils.energy import (
+    STATE_RX,
+    STATE_SLEEP,
+    EnergyMeter,
+    EnergyModel,
+    time_on_air,
+    tx_current_ma,
+)
+
+
+class TestTimeOnAir:
+    """Tests for the Semtech airtime formula."""
+
+    def test_sf7_reference(self):
+        # 20-byte payload + 4-byte header, SF7/125 kHz/4-5: 61.7 ms
+        assert time_on_air(20) == pytest.approx(0.06170, abs=1e-4)
+
+    def test_sf12_uses_low_data_rate_optimization(self):
+        # 51-byte payload at SF12/125 kHz (LDRO on), no driver header: 2.466 s
+        assert time_on_air(51, spreading_factor=12, header_bytes=0) == pytest.approx(
+            2.466, abs=1e-3
+        )
+
+    def test_grows_with_payload_and_sf(self):
+        assert time_on_air(200) > time_on_air(20)
+        assert time_on_air(20, spreading_factor=9) > time_on_air(20)
+
+    def test_tx_current_interpolates(self):
+        assert tx_current_ma(20) == 120.0
+        assert tx_current_ma(23) == 120.0
+        assert 29.0 < tx_current_ma(15) < 87.0
+
+
+class TestDutyCycle:
+    """Tests for the RX window schedule."""
+
+    def test_periodic_windows(self, clock):
+        duty = DutyCycle(rx_window_sec=2, rx_period_sec=30, clock=clock)
+        assert duty.rx_remaining() == 2
+        clock.t = 1.5
+        assert duty.rx_remaining() == pytest.approx(0.5)
+        clock.t = 2.0
+        assert duty.rx_remaining() == 0
+        assert duty.time_until_rx() == pytest.approx(28)
+        clock.t = 31
+        assert duty.rx_remaining() == pytest.approx(1)
+
+    def test_post_tx_window(self, clock):
+        duty = DutyCycle(rx_window_sec=2, rx_period_sec=30, post_tx_window_sec=3, clock=clock)
+        clock.t = 10
+        assert duty.time_until_rx() == pytest.approx(20)
+        duty.open_window()
+        assert duty.time_until_rx() == 0
+        assert duty.rx_remaining() == pytest.approx(3)
+
+    def test_no_periodic_windows(self, clock):
+        duty = DutyCycle(rx_window_sec=2, rx_period_sec=0, clock=clock)
+        assert duty.time_until_rx() == math.inf
+        duty.open_window()
+        assert duty.rx_remaining() == pytest.approx(2)
+
+    def test_window_longer_than_period_rejected(self):
+        with pytest.raises(ValueError):
+            DutyCycle(rx_window_sec=5, rx_period_sec=2)
+
+    def test_open_window_wakes_waiter(self, clock):
+        duty = DutyCycle(clock=clock)
+        duty.open_window()
+        duty.wait(5.0)  # Returns at once: event already set
+
+
+class TestSimulatedNode:
+    """Receiver and broadcast schedule on a simulated clock."""
+
+    def run(self, clock, duty, meter, duration, broadcast_every, packet_len=60):
+        """Mimic CommandReceiver.run() and broadcast_loop() event by event."""
+        next_broadcast = broadcast_every
+        listened = []
+        while clock.t < duration:
+            if clock.t >= next_broadcast:
+                meter.add_tx(packet_len)
+                duty.open_window()
+                next_broadcast += broadcast_every
+            wait = duty.time_until_rx()
+            if wait > 0:
+                meter.set_state(STATE_SLEEP)
+                clock.t = min(clock.t + wait, next_broadcast, duration)
+                continue
+            meter.set_state(STATE_RX)
+            start = clock.t
+            clock.t = min(clock.t + duty.rx_remaining(), next_broadcast, duration)
+            listened.append((start, clock.t))
+        return listened
+
+    def test_schedule_and_energy(self, clock):
+        duty = DutyCycle(rx_window_sec=2, rx_period_sec=30, post_tx_window_sec=2, clock=clock)
+        meter = EnergyMeter(EnergyModel(), clock=clock)
+        listened = self.run(clock, duty, meter, duration=3600, broadcast_every=60)
+
+        report = meter.take_window()
+        assert report.elapsed_sec == pytest.approx(3600)
+        # Every periodic window start is covered
+        starts = {round(a) for a, _ in listened}
+        assert all(k * 30 in starts for k in range(120) if k * 30 % 60)
+        # Broadcasts at 30 s multiples land in periodic windows: RX ~ 2 s / 30 s
+        assert report.duty(STATE_RX) == pytest.approx(2 / 30, rel=0.05)
+        assert report.duty(STATE_SLEEP) == pytest.approx(1 - 2 / 30, rel=0.01)
+        assert report.tx_sec == pytest.approx(59 * time_on_air(60))
+
+        # Versus always listening: an order of magnitude less charge
+        always_on = 11.5
+        assert report.mah_per_hour < always_on / 10
+        assert report.mah_per_hour == pytest.approx(
+            11.5 * 2 / 30 + report.tx_sec * 120 / 3600, rel=0.05
+        )
+
+    def test_window_resets(self, clock):
+        meter = EnergyMeter(EnergyModel(), initial_state=STATE_RX, clock=clock)
+        clock.t = 100
+        assert meter.take_window().mah_per_hour == pytest.approx(11.5)
+        meter.set_state(STATE_SLEEP)
+        clock.t = 200
+        report = meter.take_window()
+        assert report.elapsed_sec == pytest.approx(100)
+        assert report.duty(STATE_SLEEP) == pytest.approx(1.0)
+
+    def test_host_baseline(self, clock):
+        meter = EnergyMeter(EnergyModel(host_ma=100.0), initial_state=STATE_SLEEP, clock=clock)
+        clock.t = 3600
+        assert meter.take_window().mah == pytest.approx(100.0, rel=1e-3)
+
+
+class TestNodeTelemetry:
+    """Tests for the telemetry sensor."""
+
+    def test_reports_energy_window(self, clock):
+        meter = EnergyMeter(EnergyModel(), initial_state=STATE_RX, clock=clock)
+        sensor = NodeTelemetry(meter)
+        sensor.init()
+        clock.t = 50
+        meter.set_state(STATE_SLEEP)
+        clock.t = 100
+        energy, tx, rx, sleep = sensor.read()[:4]
+        assert len(sensor.get_names()) == len(sensor.get_units()) == len(sensor.read())
+        assert sensor.get_names()[:4] == ("Radio Energy", "TX Duty", "RX Duty", "Sleep Duty")
+        assert rx == pytest.approx(50.0) and sleep == pytest.approx(50.0)
+        assert energy == pytest.approx(11.5 / 2, rel=1e-3)
+        assert tx == 0.0
@@ -0,0 +1,166 @@
+"""Tests for the GPS sensor's NMEA parser and background reader."""
+
+import sys
+import threading
+import time
+import types
+
+import pytest
+
+from sensors import get_sensor_class_id, load_sensor_class
+from sensors.gps_sensor import GPSFix, GPSSensor, NMEAParser
+
+
+def sentence(body: str) -> bytes:
+    checksum = 0
+    for byte in body.encode():
+        checksum ^= byte
+    return f"${body}*{checksum:02X}\r\n".encode()
+
+
+GGA = sentence("GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,")
+GGA_NO_FIX = sentence("GPGGA,123520,,,,,0,03,,,M,,M,,")
+RMC = sentence("GNRMC,123521,A,3345.000,S,15112.500,W,022.4,084.4,230394,003.1,W")
+RMC_VOID = sentence("GPRMC,123522,V,,,,,,,230394,,")
+
+
+class TestNMEAParser:
+    """Tests for incremental GGA/RMC parsing."""
+
+    def test_gga(self, clock):
+        clock.t = 100.0
+        parser = NMEAParser(clock=clock)
+        assert parser.feed(GGA)
+        fix = parser.fix
+        assert fix.latitude == pytest.approx(48.1173)
+        assert fix.longitude == pytest.approx(11.516667)
+        assert fix.altitude == 545.4
+        assert fix.satellites == 8 and fix.quality == 1
+        assert fix.fix_time == 100.0
+
+    def test_rmc_any_talker_and_hemispheres(self, clock):
+        parser = NMEAParser(clock=clock)
+        assert parser.feed(RMC)
+        assert parser.fix.latitude == pytest.approx(-33.75)
+        assert parser.fix.longitude == pytest.approx(-151.208333)
+
+    def test_split_across_chunks(self):
+        parser = NMEAParser()
+        data = b"noise" + GGA + RMC_VOID
+        changed = [parser.feed(data[i:i + 7]) for i in range(0, len(data), 7)]
+        assert sum(changed) == 1
+        assert parser.fix.satellites == 8
+        assert parser.sentences == 2
+
+    def test_bad_checksum_ignored(self):
+        parser = NMEAParser()
+        corrupt = GGA.replace(b"4807", b"4808")
+        assert not parser.feed(corrupt)
+        assert parser.fix == GPSFix()
+        assert parser.checksum_errors == 1
+
+    def test_lost_fix_keeps_position_and_time(self, clock):
+        clock.t = 100.0
+        parser = NMEAParser(clock=clock)
+        parser.feed(GGA)
+        clock.t = 105.0
+        assert parser.feed(GGA_NO_FIX)
+        assert parser.fix.quality == 0 and parser.fix.satellites == 3
+        assert parser.fix.latitude == pytest.approx(48.1173)
+        assert parser.fix.fix_time == 100.0
+        assert not parser.feed(RMC_VOID)
+
+    def test_runaway_line_discarded(self):
+        parser = NMEAParser()
+        parser.feed(b"x" * 500)
+        assert parser.feed(GGA)
+
+
+class FakeSerial:
+    """pyserial stand-in fed by the test."""
+
+    def __init__(self, port, baud, timeout=None):
+        self.chunks = []
+        self.cond = threading.Condition()
+        self.timeout = timeout
+        self.closed = False
+        FakeSerial.last = self
+
+    @property
+    def in_waiting(self):
+        with self.cond:
+            return len(self.chunks[0]) if self.chunks else 0
+
+    def read(self, _size):
+        with self.cond:
+            if not self.chunks:
+                self.cond.wait(self.timeout)
+            return self.chunks.pop(0) if self.chunks else b""
+
+    def push(self, data):
+        with self.cond:
+            self.chunks.append(data)
+            self.cond.notify()
+
+    def close(self):
+        self.closed = True
+
+
+@pytest.fixture
+def gps(monkeypatch, clock):
+    monkeypatch.setitem(sys.modules, "serial", types.SimpleNamespace(Serial=FakeSerial))
+    clock.t = 100.0
+    sensor = GPSSensor(stale_after_sec=10.0, clock=clock)
+    sensor.init()
+    yield sensor, FakeSerial.last, clock
+    sensor.close()
+
+
+def wait_for(predicate, timeout=2.0):
+    deadline = time.monotonic() + timeout
+    while not predicate():
+        assert time.monotonic() < deadline, "timed out"
+        time.sleep(0.005)
+
+
+class TestGPSSensor:
+    """Tests for the non-blocking driver."""
+
+    def test_registered(self):
+        assert load_sensor_class("GPSSensor") is GPSSensor
+        assert get_sensor_class_id("GPSSensor") == 4
+
+    def test_no_fix_yet(self, gps):
+        sensor, _, _ = gps
+        assert sensor.read() == (None, None, None, 0, None)
+        assert len(sensor.read()) == len(sensor.get_names()) == len(sensor.get_units())
+
+    def test_fix_from_reader_thread(self, gps):
+        sensor, port, clock = gps
+        port.push(GGA[:20])
+        port.push(GGA[20:])
+        wait_for(lambda: sensor.fix.quality == 1)
+        clock.t += 2.5
+        lat, lon, alt, sats, age = sensor.read()
+        assert lat == pytest.approx(48.1173) and alt == 545.4 and sats == 8
+        assert age == pytest.approx(2.5)
+
+    def test_stale_fix(self, gps):
+        sensor, port, clock = gps
+        port.push(GGA)
+        wait_for(lambda: sensor.fix.quality == 1)
+        clock.t += 11.0
+        assert sensor.read() == (None, None, None, 8, pytest.approx(11.0))
+
+    def test_read_does_not_wait_on_uart(self, gps):
+        sensor, _, _ = gps
+        start = time.perf_counter()
+        for _ in range(1000):
+            sensor.read()
+        assert time.perf_counter() - start < 0.1
+
+    def test_close_stops_reader(self, gps):
+        sensor, port, _ = gps
+        reader = sensor._reader
+        sensor.close()
+        assert not reader.is_alive() and port.closed
@@ -0,0 +1,179 @@
+"""Tests for the shared I2C bus manager."""
+
+import sys
+import threading
+import time
+import types
+
+import pytest
+
+from utils.i2c_bus import BusioAdapter, FairLock, bus_stats, get_bus
+
+
+class FakeSMBus:
+    """Register file per address; logs every call in order."""
+
+    def __init__(self, num):
+        self.num = num
+        self.regs: dict[tuple[int, int], int] = {}
+        self.calls: list[tuple] = []
+        self.closed = False
+        self.fail = False
+
+    def read_byte_data(self, addr, reg):
+        self.calls.append(("r", addr, reg))
+        if self.fail:
+            raise OSError(121, "Remote I/O error")
+        return self.regs.get((addr, reg), 0)
+
+    def write_byte_data(self, addr, reg, value):
+        self.calls.append(("w", addr, reg))
+        self.regs[(addr, reg)] = value
+
+    def read_i2c_block_data(self, addr, reg, length):
+        self.calls.append(("rb", addr, reg))
+        return [self.regs.get((addr, reg + i), 0) for i in range(length)]
+
+    def i2c_rdwr(self, *msgs):
+        self.calls.append(("rdwr", msgs[0].addr, len(msgs)))
+        for msg in msgs:
+            if msg.read:
+                msg.data = bytes(range(1, msg.len + 1))
+
+    def close(self):
+        self.closed = True
+
+
+class FakeMsg:
+    """smbus2.i2c_msg stand-in: iterating yields the data bytes."""
+
+    def __init__(self, addr, data, read, length):
+        self.addr, self.data, self.read, self.len = addr, data, read, length
+
+    def __iter__(self):
+        return iter(self.data)
+
+    @staticmethod
+    def write(addr, data):
+        return FakeMsg(addr, bytes(data), False, len(data))
+
+    @staticmethod
+    def read(addr, length):
+        return FakeMsg(addr, b"", True, length)
+
+
+@pytest.fixture(autouse=True)
+def fake_smbus(monkeypatch):
+    monkeypatch.setitem(
+        sys.modules, "smbus2", types.SimpleNamespace(SMBus=FakeSMBus, i2c_msg=FakeMsg)
+    )
+
+
+class TestFairLock:
+    """Tests for FIFO ordering and reentrancy."""
+
+    def test_granted_in_arrival_order(self):
+        lock = FairLock()
+        order = []
+        lock.acquire()
+        threads = []
+        for i in range(5):
+            t = threading.Thread(target=lambda i=i: (lock.acquire(), order.append(i), lock.release()))
+            t.start()
+            threads.append(t)
+            # Let each waiter take its ticket before the next starts
+            time.sleep(0.02)
+        lock.release()
+        for t in threads:
+            t.join(1.0)
+        assert order == [0, 1, 2, 3, 4]
+
+    def test_reentrant(self):
+        lock = FairLock()
+        with lock:
+            with lock:
+                assert lock.held()
+            assert lock.held()
+        assert not lock.held()
+
+    def test_release_by_other_thread_rejected(self):
+        lock = FairLock()
+        with pytest.raises(RuntimeError):
+            lock.release()
+
+
+class TestSharedI2CBus:
+    """Tests for the registry, transactions and stats."""
+
+    def test_one_handle_per_bus_refcounted(self):
+        a = get_bus(1)
+        b = get_bus(1)
+        assert a is b and get_bus(3) is not a
+        raw = a.raw
+        a.close()
+        assert not raw.closed
+        b.close()
+        assert raw.closed
+        assert get_bus(1) is not a
+
+    def test_transaction_is_not_interleaved(self):
+        bus = get_bus(1)
+        in_transaction = threading.Event()
+
+        def other():
+            in_transaction.wait(1.0)
+            bus.write_byte_data(0x3C, 0x00, 0xAE)
+
+        t = threading.Thread(target=other)
+        t.start()
+        with bus.transaction():
+            ctrl = bus.read_byte_data(0x1D, 0x2A)
+            in_transaction.set()
+            time.sleep(0.05)
+            bus.write_byte_data(0x1D, 0x2A, ctrl | 0x01)
+        t.join(1.0)
+        assert [c[1] for c in bus.raw.calls] == [0x1D, 0x1D, 0x3C]
+
+    def test_write_registers_in_order(self):
+        bus = get_bus(1)
+        bus.write_registers(0x76, [(0xF5, 0x08), (0xF2, 0x01)])
+        assert bus.raw.calls == [("w", 0x76, 0xF5), ("w", 0x76, 0xF2)]
+        assert bus.raw.regs[(0x76, 0xF5)] == 0x08
+
+    def test_stats_per_device_and_errors(self):
+        bus = get_bus(1)
+        bus.read_byte_data(0x76, 0xD0)
+        bus.read_i2c_block_data(0x76, 0xF7, 8)
+        bus.write_byte_data(0x1D, 0x2A, 1)
+        bus.raw.fail = True
+        with pytest.raises(OSError):
+            bus.read_byte_data(0x1D, 0x00)
+
+        stats = bus.stats()
+        assert stats.transactions == 4
+        assert stats.errors == 1 and "0x1D" in stats.last_error
+        assert stats.devices[0x76].transactions == 2
+        assert stats.devices[0x1D].errors == 1
+        assert stats.lock_waits == 4
+        assert [s.bus for s in bus_stats()] == [1]
+
+
+class TestBusioAdapter:
+    """Tests for the busio.I2C view used by Adafruit drivers."""
+
+    def test_write_then_read_is_one_transfer(self):
+        bus = get_bus(1)
+        i2c = BusioAdapter(bus)
+        assert i2c.try_lock()
+        buf = bytearray(2)
+        i2c.writeto_then_readfrom(0x48, bytes([0x00]), buf)
+        i2c.unlock()
+        assert buf == bytearray([1, 2])
+        assert bus.raw.calls == [("rdwr", 0x48, 2)]
+        assert bus.stats().devices[0x48].transactions == 1
+
+    def test_readfrom_into_slice(self):
+        i2c = BusioAdapter(get_bus(1))
+        buf = bytearray(4)
+        i2c.readfrom_into(0x48, buf, start=1, end=3)
+        assert buf == bytearray([0, 1, 2, 0])
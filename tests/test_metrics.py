@@ -0,0 +1,118 @@
+"""Tests for node self-telemetry: timing samples, metered lock, telemetry readings."""
+
+import threading
+import time
+from unittest.mock import MagicMock
+
+import pytest
+
+from node.command_executor import CommandExecutor
+from node.metrics import MeteredLock, NodeMetrics, percentile
+from node.scheduler import SensorScheduler
+from node.sensor_reader import SensorEntry, read_entry
+from node.telemetry import NodeTelemetry, read_cpu_temp_c
+from utils.command_registry import CommandRegistry, CommandScope
+from utils.protocol import CommandPacket, build_lora_packets, parse_sensor_frame
+
+
+class TestNodeMetrics:
+    """Tests for the sample collector."""
+
+    def test_percentile(self):
+        samples = [float(i) for i in range(1, 101)]
+        assert percentile(samples, 50) == 50
+        assert percentile(samples, 95) == 95
+        assert percentile([3.0], 95) == 3.0
+        assert percentile([], 95) is None
+
+    def test_window_resets(self):
+        metrics = NodeMetrics()
+        metrics.add_lateness(0.01)
+        metrics.add_lock_wait(0.002)
+        metrics.add_dropped(3)
+        metrics.add_dropped(0)
+        window = metrics.take_window()
+        assert window.lateness == [0.01] and window.lock_wait == [0.002]
+        assert window.dropped_readings == 3
+        empty = metrics.take_window()
+        assert empty.lateness == [] and empty.dropped_readings == 0
+
+    def test_metered_lock_records_contended_wait(self):
+        metrics = NodeMetrics()
+        lock = MeteredLock(metrics)
+        holder_has_lock = threading.Event()
+
+        def hold():
+            with lock:
+                holder_has_lock.set()
+                time.sleep(0.05)
+
+        holder = threading.Thread(target=hold)
+        holder.start()
+        holder_has_lock.wait()
+        with lock:
+            pass
+        holder.join()
+        waits = metrics.take_window().lock_wait
+        assert len(waits) == 2
+        assert max(waits) >= 0.03
+        assert not lock.locked()
+
+
+class TestSources:
+    """Tests for the scheduler and executor feeding metrics."""
+
+    def test_scheduler_reports_lateness(self, clock):
+        metrics = NodeMetrics()
+        scheduler = SensorScheduler(
+            [SensorEntry(sensor=MagicMock(), interval_sec=10)], clock=clock, metrics=metrics
+        )
+        clock.t += 0.25
+        scheduler.pop_due()
+        assert metrics.take_window().lateness == [pytest.approx(0.25)]
+
+    def test_executor_reports_handler_latency(self):
+        metrics = NodeMetrics()
+        registry = CommandRegistry("patio")
+        registry.register("slow", lambda cmd, args: time.sleep(0.02), CommandScope.ANY,
+                          early_ack=True)
+        executor = CommandExecutor(registry, "patio", lambda p, j: True, max_workers=0,
+                                   metrics=metrics)
+        executor.submit(CommandPacket("slow", [], "patio", timestamp=1, crc="abcd"))
+        [latency] = metrics.take_window().handler_latency
+        assert latency >= 0.02
+
+
+class TestNodeTelemetryReadings:
+    """Tests for the extended telemetry sensor."""
+
+    def test_readings_and_round_trip(self):
+        metrics = NodeMetrics()
+        sensor = NodeTelemetry(None, metrics)
+        sensor.init()
+        for ms in (1, 2, 3, 40):
+            metrics.add_lock_wait(ms / 1000)
+        metrics.add_lateness(0.005)
+        metrics.add_dropped(2)
+
+        values = dict(zip(sensor.get_names(), sensor.read()))
+        assert len(sensor.get_names()) == len(sensor.get_units()) == len(values)
+        assert values["Lock Wait p50"] == pytest.approx(2.0)
+        assert values["Lock Wait Max"] == pytest.approx(40.0)
+        assert values["Late Max"] == pytest.approx(5.0)
+        assert values["Handler p95"] is None
+        assert values["Dropped"] == 2
+
+        # Goes out through the normal uplink path, empty windows as null values
+        entry = SensorEntry(sensor=sensor, interval_sec=300)
+        metrics.add_lock_wait(0.001)
+        packets = build_lora_packets("patio", read_entry(entry, 1000.0))
+        received = {r.name: r.value for p in packets for r in parse_sensor_frame(p).readings}
+        assert set(received) == set(sensor.get_names())
+        assert received["Late p95"] is None
+
+    def test_cpu_temp(self, tmp_path):
+        path = tmp_path / "temp"
+        path.write_text("48312\n")
+        assert read_cpu_temp_c(str(path)) == pytest.approx(48.312)
+        assert read_cpu_temp_c(str(tmp_path / "missing")) is None
@@ -363,6 +363,8 @@ class TestSensorRegistry:
         assert SENSOR_CLASS_IDS["BME280TempPressureHumidity"] == 0
         assert SENSOR_CLASS_IDS["MMA8452Accelerometer"] == 1
         assert SENSOR_CLASS_IDS["ADS1115ADC"] == 2
+        assert SENSOR_CLASS_IDS["NodeTelemetry"] == 3
+        assert SENSOR_CLASS_IDS["GPSSensor"] == 4
 
     def test_ids_are_unique(self):
         """No two sensor classes should share the same ID."""
@@ -0,0 +1,169 @@
+"""Tests for gateway streaming rollups."""
+
+import math
+import threading
+import time
+
+import pytest
+
+from gateway.rollups import (
+    MODE_BOTH,
+    RollupEngine,
+    RollupRule,
+    build_rollup_engine,
+)
+from gateway.sensor_collection import SensorDataCollector
+from utils.protocol import SensorReading
+
+ACCEL_ID = "patio_mma8452accelerometer_accel_x"
+TEMP_ID = "patio_bme280temppressurehumidity_temperature"
+BASE = {"name": "patio Accel X", "units": "g", "category": "Remote Sensors",
+        "tags": ["patio", "mma8452accelerometer", "lora"]}
+
+
+@pytest.fixture
+def engine():
+    rules = [RollupRule(match="*_mma8452accelerometer_*", window_sec=60, rms=True)]
+    return RollupEngine(rules, allowed_lateness_sec=5)
+
+
+def add(engine, ts, value, sensor_id=ACCEL_ID):
+    rule = engine.resolve(sensor_id)
+    return engine.add(sensor_id, rule, ts, value, BASE)
+
+
+class TestResolve:
+    """Tests for rule matching."""
+
+    def test_pattern_match(self, engine):
+        assert engine.resolve(ACCEL_ID) is not None
+        assert engine.resolve(TEMP_ID) is None
+
+    def test_exact_beats_pattern(self):
+        rules = [
+            RollupRule(match="patio_*", window_sec=60),
+            RollupRule(match=TEMP_ID, window_sec=300, mode=MODE_BOTH),
+        ]
+        engine = RollupEngine(rules)
+        assert engine.resolve(TEMP_ID).window_sec == 300
+
+    def test_raw_mode_opts_out(self):
+        rules = [
+            RollupRule(match=TEMP_ID, window_sec=60, mode="raw"),
+            RollupRule(match="patio_*", window_sec=60),
+        ]
+        assert RollupEngine(rules).resolve(TEMP_ID) is None
+
+    def test_invalid_mode(self):
+        with pytest.raises(ValueError):
+            RollupRule(match="x", window_sec=60, mode="median")
+
+
+class TestWindows:
+    """Tests for window aggregation and closing."""
+
+    def test_window_stays_open_until_lateness_passes(self, engine):
+        for i in range(3):
+            assert add(engine, 60.0 + i, float(i)) == []
+        # Past window end but inside lateness allowance
+        assert add(engine, 122.0, 0.0) == []
+        closed = add(engine, 125.0, 0.0)
+        assert len(closed) == 1
+        values = closed[0].values()
+        assert closed[0].window_start == 60.0
+        assert values["count"] == 3
+        assert values["min"] == 0.0
+        assert values["max"] == 2.0
+        assert values["mean"] == pytest.approx(1.0)
+        assert values["last"] == 2.0
+        assert values["rms"] == pytest.approx(math.sqrt(5 / 3))
+
+    def test_out_of_order_within_lateness(self, engine):
+        add(engine, 70.0, 1.0)
+        add(engine, 121.0, 9.0)  # Next window, first window still open
+        add(engine, 65.0, 3.0)  # Late, but allowed
+        closed = engine.flush(now=1000.0)
+        first = next(w for w in closed if w.window_start == 60.0)
+        assert first.values()["count"] == 2
+        # "last" follows timestamps, not arrival order
+        assert first.values()["last"] == 1.0
+
+    def test_late_after_close_is_dropped(self, engine):
+        add(engine, 70.0, 1.0)
+        add(engine, 200.0, 1.0)  # Closes the 60s window
+        assert add(engine, 61.0, 5.0) == []
+        assert engine.late_dropped == 1
+
+    def test_flush_closes_idle_series(self, engine):
+        add(engine, 70.0, 1.0)
+        assert engine.flush(now=124.0) == []
+        assert len(engine.flush(now=126.0)) == 1
+
+    def test_force_flush(self, engine):
+        add(engine, 70.0, 1.0)
+        assert len(engine.flush(now=0.0, force=True)) == 1
+        assert engine.flush(force=True) == []
+
+    def test_datapoints(self, engine):
+        add(engine, 70.0, 2.0)
+        (window,) = engine.flush(force=True)
+        points = {dp["id"]: dp for dp in window.to_datapoints()}
+        assert set(points) == {
+            f"{ACCEL_ID}_{s}" for s in ("count", "min", "max", "mean", "last", "rms")
+        }
+        assert points[f"{ACCEL_ID}_max"]["name"] == "patio Accel X max"
+        assert points[f"{ACCEL_ID}_max"]["units"] == "g"
+        assert points[f"{ACCEL_ID}_count"]["units"] == ""
+        assert "rollup" in points[f"{ACCEL_ID}_max"]["tags"]
+        assert "rollup" not in BASE["tags"]
+
+
+class TestBuild:
+    """Tests for building from config."""
+
+    def test_no_rules(self):
+        assert build_rollup_engine({}) is None
+
+    def test_disabled(self):
+        config = {"enabled": False, "rules": [{"match": "*", "window_sec": 60}]}
+        assert build_rollup_engine(config) is None
+
+    def test_from_config(self):
+        config = {"rules": [{"match": "*_x", "window_sec": 30, "mode": "both"}]}
+        engine = build_rollup_engine(config)
+        assert engine.resolve("a_b_x").posts_raw
+
+
+class TestCollectorShutdown:
+    """Tests for rollups flushed by the collector on stop()."""
+
+    def test_forced_flush_reaches_dashboard(self):
+        release = threading.Event()
+        posted = []
+
+        class SlowClient:
+            def post_readings(self, datapoints):
+                # First post is still in flight when stop() is called
+                release.wait(timeout=5.0)
+                posted.append(datapoints)
+                return True
+
+        rules = [RollupRule(match="*_mma8452accelerometer_*", window_sec=60, mode=MODE_BOTH)]
+        collector = SensorDataCollector(
+            "gw", SlowClient(), rollup_engine=RollupEngine(rules, allowed_lateness_sec=5)
+        )
+        collector.start()
+        reading = SensorReading("Accel X", "g", 1.0, "MMA8452Accelerometer", time.time())
+        collector.add_readings("patio", [reading])
+
+        stopper = threading.Thread(target=collector.stop)
+        stopper.start()
+        deadline = time.monotonic() + 5.0
+        # Rollup windows and the sentinel queued behind the in-flight post
+        while collector._post_queue.qsize() < 2 and time.monotonic() < deadline:
+            time.sleep(0.01)
+        release.set()
+        stopper.join(timeout=5.0)
+
+        assert len(posted) == 2
+        assert {dp["id"] for dp in posted[1]} >= {f"{ACCEL_ID}_mean", f"{ACCEL_ID}_count"}
@@ -0,0 +1,236 @@
+"""Tests for the full-resolution sample log and fetchlog transfers."""
+
+import os
+import threading
+from types import SimpleNamespace
+
+import pytest
+
+from gateway.log_transfers import STATUS_COMPLETE, STATUS_FAILED, LogTransferManager
+from node.command import _handle_fetchlog, _handle_logresend
+from node.log_transfer import LogSender
+from node.sample_log import HEADER, RECORD, SampleLog
+from utils.protocol import (
+    LORA_MAX_PAYLOAD,
+    SensorReading,
+    build_log_chunk_packets,
+    decode_log_records,
+    encode_log_records,
+    parse_log_chunk_packet,
+    parse_ranges,
+)
+
+BME = "BME280TempPressureHumidity"
+ACCEL = "MMA8452Accelerometer"
+
+
+def open_log(tmp_path, slots=100, **kwargs):
+    log = SampleLog(tmp_path / "samples.bin", slots=slots, flush_records=1000, **kwargs)
+    log.register(BME, ["Temperature", "Pressure"], ["C", "hPa"])
+    log.register(ACCEL, ["Accel X"], ["g"])
+    return log
+
+
+def fill(log, count, start=1000.0, step=1.0):
+    for i in range(count):
+        log.append_values(BME, ["Temperature", "Pressure"], [20.0 + i, 1000.0], start + i * step)
+
+
+class TestSampleLog:
+    """Tests for the on-disk ring."""
+
+    def test_query_range_in_order(self, tmp_path):
+        log = open_log(tmp_path)
+        fill(log, 10)
+        records = log.query(1003, 1005)
+        # Two readings per sample, buffered records flushed by the query
+        assert [r[0] for r in records] == [1003, 1003, 1004, 1004, 1005, 1005]
+        assert records[0][3] == pytest.approx(23.0)
+        assert len(log.query(1003, 1005, limit=3)) == 3
+
+    def test_out_of_order_timestamps_found(self, tmp_path):
+        log = open_log(tmp_path)
+        fill(log, 5, start=1000.0)
+        # A cycle stamped at its start lands after a sampler's later sample
+        log.append_values(ACCEL, ["Accel X"], [0.5], 1010.0)
+        log.append_values(BME, ["Temperature", "Pressure"], [30.0, 990.0], 1002.5)
+        fill(log, 5, start=1011.0)
+        assert [r[0] for r in log.query(1002.5, 1002.5)] == [1002.5, 1002.5]
+        # Past the out-of-order record, the scan doesn't stop at 1010
+        assert len(log.query(1002.0, 1003.0)) == 6
+
+    def test_old_window_does_not_read_to_head(self, tmp_path, monkeypatch):
+        log = open_log(tmp_path, slots=20_000)
+        fill(log, 8000)  # 16000 records, one second apart
+        log.flush()
+        read = []
+        real_pread = os.pread
+
+        def pread(fd, size, offset):
+            read.append(size)
+            return real_pread(fd, size, offset)
+
+        monkeypatch.setattr(os, "pread", pread)
+        assert len(log.query(1100, 1110)) == 22
+        # Scan ends QUERY_SLACK_SEC past t_to, not at record 16000
+        assert sum(read) < 6000 * RECORD.size
+
+    def test_unregistered_and_none_skipped(self, tmp_path):
+        log = open_log(tmp_path)
+        log.append_readings([
+            SensorReading("Accel X max", "g", 1.0, ACCEL, 1000.0),
+            SensorReading("Accel X", "g", None, ACCEL, 1000.0),
+            SensorReading("Accel X", "g", 0.5, ACCEL, 1001.0),
+        ])
+        assert [(r[0], r[3]) for r in log.query(0, 2000)] == [(1001.0, 0.5)]
+
+    def test_ring_keeps_newest(self, tmp_path):
+        log = open_log(tmp_path, slots=10)
+        fill(log, 8)  # 16 records into 10 slots
+        records = log.query(0, 5000)
+        assert len(records) == 10
+        assert records[0][0] == 1003 and records[-1][0] == 1007
+
+    def test_reopen_recovers_head_past_hint(self, tmp_path):
+        log = open_log(tmp_path)
+        fill(log, 5)
+        log.flush()
+        # Simulate a crash after records were written but before the header
+        os.pwrite(log._fd, HEADER.pack(b"DLSL", 1, RECORD.size, 100, 4, 0), 0)
+        os.close(log._fd)
+        log._fd = -1
+
+        reopened = open_log(tmp_path)
+        assert reopened.next_number == 10
+        fill(reopened, 1, start=2000.0)
+        assert len(reopened.query(0, 5000)) == 12
+
+    def test_torn_record_ends_log(self, tmp_path):
+        log = open_log(tmp_path)
+        fill(log, 5)
+        log.flush()
+        # Corrupt the last record's value bytes (CRC no longer matches)
+        os.pwrite(log._fd, b"\xff\xff", log._offset(9) + 12)
+        os.pwrite(log._fd, HEADER.pack(b"DLSL", 1, RECORD.size, 100, 0, 0), 0)
+        os.close(log._fd)
+        log._fd = -1
+
+        reopened = open_log(tmp_path)
+        assert reopened.next_number == 9
+
+    def test_names_stable_across_restart(self, tmp_path):
+        log = open_log(tmp_path)
+        log.close()
+        reopened = SampleLog(tmp_path / "samples.bin", slots=100)
+        reopened.register(BME, ["Humidity", "Temperature"], ["%", "C"])
+        names = reopened.names()
+        assert names["0"] == [["Temperature", "C"], ["Pressure", "hPa"], ["Humidity", "%"]]
+
+
+class TestLogEncoding:
+    """Tests for the transfer blob and chunk packets."""
+
+    def test_round_trip(self):
+        names = {"0": [["Temperature", "C"]], "1": [["Accel X", "g"]]}
+        records = [(1000.0, 0, 0, 21.5), (1000.05, 1, 0, -0.25)]
+        readings = decode_log_records(encode_log_records(names, records))
+        assert [(r.sensor_class, r.name, r.units) for r in readings] == [
+            (BME, "Temperature", "C"), (ACCEL, "Accel X", "g"),
+        ]
+        assert readings[1].timestamp == pytest.approx(1000.05)
+        assert readings[1].value == pytest.approx(-0.25)
+
+    def test_chunks_fit_and_reassemble(self):
+        blob = os.urandom(3000)
+        packets = build_log_chunk_packets("a-long-node-name", 255, blob)
+        assert all(len(p) <= LORA_MAX_PAYLOAD for p in packets)
+        chunks = [parse_log_chunk_packet(p) for p in packets]
+        assert b"".join(c.data for c in chunks) == blob
+        assert {c.total for c in chunks} == {len(packets)}
+
+    def test_corrupt_chunk_rejected(self):
+        packet = build_log_chunk_packets("patio", 1, b"abc")[0]
+        assert parse_log_chunk_packet(packet.replace(b'"i":0', b'"i":1')) is None
+
+    def test_ranges(self):
+        assert parse_ranges("3-5,9") == [(3, 5), (9, 9)]
+        with pytest.raises(ValueError):
+            parse_ranges("5-3")
+
+
+class LossyLink:
+    """Delivers node packets to the gateway manager, dropping chosen indexes once."""
+
+    def __init__(self, manager, drop):
+        self.manager = manager
+        self.drop = set(drop)
+        self.sent = 0
+        self.done = threading.Event()
+
+    def __call__(self, packet):
+        chunk = parse_log_chunk_packet(packet)
+        self.sent += 1
+        if chunk.index in self.drop:
+            self.drop.discard(chunk.index)
+            return True
+        if self.manager.add_chunk(chunk) is not None:
+            self.done.set()
+        return True
+
+
+class TestFetchlogTransfer:
+    """End-to-end fetchlog over a lossy link with selective resend."""
+
+    def test_missing_chunks_resent(self, tmp_path, clock):
+        log = open_log(tmp_path, slots=5000)
+        fill(log, 2000, step=0.05)
+        manager = LogTransferManager(output_dir=tmp_path / "logs", clock=clock)
+        link = LossyLink(manager, drop={1, 2, 5})
+        sender = LogSender("patio", link, chunk_gap_sec=0, start_delay_sec=0)
+        state = SimpleNamespace(sample_log=log, log_sender=sender)
+        sender.start()
+        try:
+            ack = _handle_fetchlog(state, "fetchlog", ["1000", "1100"])
+            assert ack["r"] == 4000
+            manager.expect("patio", ack["x"], ack["m"])
+
+            # Stream finishes with three chunks missing
+            for _ in range(200):
+                if link.sent >= ack["m"] and sender.queued_count == 0:
+                    break
+                threading.Event().wait(0.01)
+            assert not link.done.is_set()
+
+            clock.t += 10
+            [(node_id, transfer_id, ranges)] = manager.due_resends()
+            assert (node_id, transfer_id, ranges) == ("patio", ack["x"], "1-2,5")
+            assert _handle_logresend(state, "logresend", [str(transfer_id), ranges]) == {"r": 3}
+            assert link.done.wait(2.0)
+        finally:
+            sender.stop()
+
+        transfer = manager.get("patio", ack["x"])
+        assert transfer.status == STATUS_COMPLETE
+        assert len(transfer.readings) == 4000
+        assert transfer.readings[0].timestamp == pytest.approx(1000.0)
+        assert len(list((tmp_path / "logs").iterdir())) == 1
+        # Compressed well below the 14 bytes per record of the raw stream
+        assert ack["b"] < 4000 * 10
+
+    def test_empty_range_and_bad_args(self, tmp_path):
+        sender = LogSender("patio", lambda p: True)
+        state = SimpleNamespace(sample_log=open_log(tmp_path), log_sender=sender)
+        assert _handle_fetchlog(state, "fetchlog", ["1", "2"]) == {"r": 0}
+        assert "e" in _handle_fetchlog(state, "fetchlog", ["1"])
+        assert "e" in _handle_fetchlog(state, "fetchlog", ["1", "x"])
+        assert _handle_logresend(state, "logresend", ["9", "0-1"]) == {"e": "unknown transfer"}
+
+    def test_transfer_fails_after_max_resends(self, clock):
+        manager = LogTransferManager(resend_after_sec=5, max_resends=2, clock=clock)
+        manager.expect("patio", 7, 4)
+        for _ in range(2):
+            clock.t += 5
+            assert len(manager.due_resends()) == 1
+        clock.t += 5
+        assert manager.due_resends() == []
+        assert manager.get("patio", 7).status == STATUS_FAILED
@@ -0,0 +1,86 @@
+"""Tests for the monotonic sensor scheduler."""
+
+import pytest
+
+from node.scheduler import SensorScheduler
+from node.sensor_reader import SensorEntry
+
+
+class NamedSensor:
+    """Stand-in sensor; SensorScheduler only needs class_name via SensorEntry."""
+
+
+def entries(*intervals):
+    return [SensorEntry(sensor=NamedSensor(), interval_sec=i) for i in intervals]
+
+
+def run(scheduler, clock, until):
+    """Advance the fake clock wakeup by wakeup, returning (time, fired intervals)."""
+    fires = []
+    while True:
+        clock.t += scheduler.time_until_next()
+        if clock.t > until:
+            return fires
+        due = scheduler.pop_due()
+        fires.append((round(clock.t, 6), [e.interval_sec for e in due]))
+
+
+class TestSensorScheduler:
+    """Tests for SensorScheduler."""
+
+    def test_all_due_at_start(self, clock):
+        scheduler = SensorScheduler(entries(60, 25), clock=clock)
+        assert [e.interval_sec for e in scheduler.pop_due()] == [60, 25]
+        assert scheduler.time_until_next() == 25
+
+    def test_phase_aligned_no_drift(self, clock):
+        scheduler = SensorScheduler(entries(10), clock=clock)
+        scheduler.pop_due()
+        # Wake up late every time; the schedule must not slip
+        for k in range(1, 6):
+            clock.t = 10 * k + 0.3
+            assert scheduler.pop_due()
+        assert scheduler.time_until_next() == pytest.approx(9.7)
+        stats = scheduler.stats()["NamedSensor"]
+        assert stats.max_lateness == pytest.approx(0.3)
+
+    def test_stall_skips_missed_intervals(self, clock):
+        scheduler = SensorScheduler(entries(10), clock=clock)
+        scheduler.pop_due()
+        clock.t += 35.0
+        assert len(scheduler.pop_due()) == 1  # One read, not a burst of three
+        assert scheduler.stats()["NamedSensor"].skipped == 2
+        assert scheduler.time_until_next() == pytest.approx(5.0)
+
+    def test_coalescing_reduces_broadcasts(self, clock):
+        plain = run(SensorScheduler(entries(60, 29), clock=clock), clock, 3600)
+        clock.t = 0.0
+        coalesced = run(SensorScheduler(entries(60, 29), 2.0, clock=clock), clock, 3600)
+        assert len(coalesced) < len(plain)
+        # Same number of samples per sensor, each within the tolerance of its slot
+        for interval in (60, 29):
+            plain_times = [t for t, fired in plain if interval in fired]
+            times = [t for t, fired in coalesced if interval in fired]
+            assert len(times) == len(plain_times)
+            assert all(0 <= p - t <= 2.0 for p, t in zip(plain_times, times))
+
+    def test_interval_within_tolerance_fires_once_per_call(self, clock):
+        a, b = entries(1.0, 5.0)
+        scheduler = SensorScheduler([a, b], 1.0, clock=clock)
+        assert scheduler.pop_due() == [a, b]
+        clock.t += 1.0
+        assert scheduler.pop_due() == [a]
+        fires = run(scheduler, clock, 10.0)
+        assert sum(fired.count(1.0) for _, fired in fires) <= 10
+        assert all(fired.count(1.0) <= 1 for _, fired in fires)
+
+    def test_coalesced_read_keeps_phase(self, clock):
+        scheduler = SensorScheduler(entries(10, 11), 1.5, clock=clock)
+        scheduler.pop_due()
+        clock.t += 10.0
+        assert len(scheduler.pop_due()) == 2  # 11s sensor pulled in 1s early
+        clock.t += 11.0  # t=21 relative: 10s sensor due at 20, 11s sensor at 22
+        assert len(scheduler.pop_due()) == 2
+        stats = scheduler.stats()
+        assert stats["NamedSensor#1"].coalesced == 2  # At 10 (due 11) and 21 (due 22)
+        assert stats["NamedSensor#1"].mean_lateness < 0
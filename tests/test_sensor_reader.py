@@ -0,0 +1,123 @@
+"""Tests for concurrent sensor reads with deadlines."""
+
+import threading
+import time
+from unittest.mock import MagicMock
+
+import pytest
+
+from node.sensor_reader import SensorEntry, SensorReadPool
+from sensors import Sensor
+from utils.node_state import NodeState
+from utils.radio_state import RadioState
+
+
+class FakeSensor(Sensor):
+    def __init__(self, name, delay=0.0, fail=False, gate=None):
+        self._name = name
+        self._delay = delay
+        self._fail = fail
+        self._gate = gate
+
+    def init(self):
+        pass
+
+    def read(self):
+        if self._gate is not None:
+            self._gate.wait()
+        time.sleep(self._delay)
+        if self._fail:
+            raise OSError("I2C error")
+        return (1.0,)
+
+    def get_names(self):
+        return [self._name]
+
+    def get_units(self):
+        return ["V"]
+
+
+@pytest.fixture
+def node_state():
+    return NodeState(node_id="patio", radio_state=RadioState(radio=MagicMock(), n2g_freq=915.0, g2n_freq=915.5), config_path="")
+
+
+@pytest.fixture
+def pool(node_state):
+    p = SensorReadPool(max_workers=4, node_state=node_state)
+    yield p
+    p.close()
+
+
+class TestSensorReadPool:
+    """Tests for SensorReadPool."""
+
+    def test_reads_run_concurrently(self, pool):
+        entries = [SensorEntry(FakeSensor(f"s{i}", delay=0.2), 1) for i in range(3)]
+        t0 = time.monotonic()
+        result = pool.read(entries)
+        assert time.monotonic() - t0 < 0.5
+        assert [r.name for r in result.readings] == ["s0", "s1", "s2"]
+        assert len({r.timestamp for r in result.readings}) == 1
+
+    def test_hung_sensor_skipped(self, pool, node_state):
+        gate = threading.Event()
+        hung = SensorEntry(FakeSensor("hung", gate=gate), 1, read_timeout_sec=0.1)
+        ok = SensorEntry(FakeSensor("ok"), 1)
+
+        result = pool.read([hung, ok])
+        assert [r.name for r in result.readings] == ["ok"]
+        assert result.timed_out == [hung]
+        assert [(e, [r.name for r in rs]) for e, rs in result.by_entry] == [(ok, ["ok"])]
+
+        # Still hung: not resubmitted
+        result = pool.read([hung, ok])
+        assert result.busy == [hung]
+        assert hung.in_flight is not None
+
+        gate.set()
+        hung.in_flight.result(timeout=1.0)
+        result = pool.read([hung])
+        assert [r.name for r in result.readings] == ["hung"]
+
+        stats = node_state.get_sensor_read_stats()["FakeSensor"]
+        assert stats.timeouts == 2
+        assert not stats.last_timed_out
+
+    def test_errors_counted(self, pool, node_state):
+        result = pool.read([SensorEntry(FakeSensor("bad", fail=True), 1)])
+        assert result.readings == []
+        assert node_state.get_sensor_read_stats()["FakeSensor"].errors == 1
+
+    def test_same_class_sensors_counted_apart(self, pool, node_state):
+        good = SensorEntry(FakeSensor("a"), 1)
+        bad = SensorEntry(FakeSensor("b", fail=True), 1)
+        node_state.sensor_entries = [good, bad]
+        pool.read([good, bad])
+        stats = node_state.get_sensor_read_stats()
+        assert (stats["FakeSensor"].reads, stats["FakeSensor"].errors) == (1, 0)
+        assert (stats["FakeSensor#1"].reads, stats["FakeSensor#1"].errors) == (0, 1)
+
+    def test_labels_computed_once(self, pool, node_state, monkeypatch):
+        import node.sensor_reader as sensor_reader
+
+        calls = []
+        real = sensor_reader.entry_labels
+        monkeypatch.setattr(
+            sensor_reader, "entry_labels", lambda entries: calls.append(1) or real(entries)
+        )
+        entries = [SensorEntry(FakeSensor(str(i)), 1) for i in range(3)]
+        node_state.sensor_entries = entries
+        pool.read(entries)
+        pool.read(entries)
+        assert len(calls) == 1
+        # A sensor added later gets its own label
+        entries.append(SensorEntry(FakeSensor("d"), 1))
+        pool.read(entries[3:])
+        assert "FakeSensor#3" in node_state.get_sensor_read_stats()
+
+    def test_latency_recorded(self, pool, node_state):
+        pool.read([SensorEntry(FakeSensor("a", delay=0.05), 1)])
+        stats = node_state.get_sensor_read_stats()["FakeSensor"]
+        assert stats.reads == 1
+        assert stats.last_latency_ms >= 40
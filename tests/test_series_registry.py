@@ -0,0 +1,70 @@
+"""Tests for interned series templates and the collector's use of them."""
+
+import json
+
+from gateway.sensor_collection import SensorDataCollector
+from gateway.series_registry import SeriesRegistry
+from utils.protocol import SensorReading, make_sensor_id
+
+
+def reading(name="Temperature", units="C", value=21.5, ts=100.0):
+    return SensorReading(
+        name=name, units=units, value=value,
+        sensor_class="BME280TempPressureHumidity", timestamp=ts,
+    )
+
+
+class TestSeriesRegistry:
+    """Tests for template interning."""
+
+    def test_interned(self):
+        registry = SeriesRegistry()
+        a = registry.get("patio", "BME280TempPressureHumidity", "Temperature", "C")
+        b = registry.get("patio", "BME280TempPressureHumidity", "Temperature", "C")
+        assert a is b
+        assert a.sensor_id == make_sensor_id("patio", "BME280TempPressureHumidity", "Temperature")
+        registry.get("patio", "BME280TempPressureHumidity", "Pressure", "hPa")
+        assert len(registry) == 2
+
+    def test_datapoint(self):
+        registry = SeriesRegistry()
+        t = registry.get("patio", "BME280TempPressureHumidity", "Temperature", "C")
+        dp = t.datapoint(21.5, 100.0)
+        assert dp == {
+            "id": "patio_bme280temppressurehumidity_temperature",
+            "name": "patio Temperature",
+            "units": "C",
+            "value": 21.5,
+            "timestamp": 100.0,
+            "category": "Remote Sensors",
+            "tags": ("patio", "bme280temppressurehumidity", "lora"),
+        }
+        assert "value" not in t.base
+        assert json.loads(json.dumps(dp))["tags"] == ["patio", "bme280temppressurehumidity", "lora"]
+
+    def test_units_change_keeps_lookups(self):
+        registry = SeriesRegistry()
+        a = registry.get("patio", "X", "Temperature", "C")
+        a.store_slot = 3
+        b = registry.get("patio", "X", "Temperature", "F")
+        assert b.sensor_id == a.sensor_id
+        assert b.base["units"] == "F"
+        assert b.store_slot == 3
+        assert registry.by_sensor_id(a.sensor_id) is b
+        assert len(registry) == 1
+
+
+class TestCollectorTemplates:
+    """Tests for add_readings() output built from templates."""
+
+    def test_local_and_remote_datapoints(self):
+        collector = SensorDataCollector("gw", dashboard_client=None)
+        collector.add_readings("patio", [reading()])
+        collector.add_readings("gw", [reading()], is_local=True)
+
+        remote = collector._post_queue.get_nowait().datapoints[0]
+        local = collector._post_queue.get_nowait().datapoints[0]
+        assert remote["category"] == "Remote Sensors"
+        assert local["category"] == "Local Sensors"
+        assert local["tags"][-1] == "local"
+        assert len(collector.series_registry) == 2
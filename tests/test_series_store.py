@@ -0,0 +1,148 @@
+"""Tests for the gateway memory-mapped series store."""
+
+import time
+
+import pytest
+
+import gateway.series_store as series_store_module
+from gateway.series_store import SeriesStore
+
+SENSOR_ID = "patio_bme280temppressurehumidity_temperature"
+
+
+@pytest.fixture
+def store(tmp_path):
+    """Create a small store backed by a temp file."""
+    s = SeriesStore(str(tmp_path / "series.bin"), capacity=8, max_series=4)
+    yield s
+    s.close()
+
+
+@pytest.fixture(params=["numpy", "python"])
+def query_mode(request, monkeypatch):
+    """Run query tests against both the numpy and pure-Python paths."""
+    if request.param == "numpy":
+        pytest.importorskip("numpy")
+    else:
+        monkeypatch.setattr(series_store_module, "np", None)
+    return request.param
+
+
+class TestAppend:
+    """Tests for appending and ring wraparound."""
+
+    def test_unknown_series_returns_none(self, store):
+        assert store.query("nope") is None
+
+    def test_append_and_query_all(self, store, query_mode):
+        for i in range(3):
+            store.append(SENSOR_ID, 100.0 + i, float(i))
+        result = store.query(SENSOR_ID)
+        assert result["t"] == [100.0, 101.0, 102.0]
+        assert result["v"] == [0.0, 1.0, 2.0]
+
+    def test_wraparound_keeps_newest(self, store, query_mode):
+        for i in range(12):
+            store.append(SENSOR_ID, float(i), float(i * 10))
+        result = store.query(SENSOR_ID)
+        assert result["t"] == [float(i) for i in range(4, 12)]
+        assert result["v"] == [float(i * 10) for i in range(4, 12)]
+
+    def test_series_are_independent(self, store):
+        store.append("a_x_y", 1.0, 1.0)
+        store.append("b_x_y", 2.0, 2.0)
+        assert store.query("a_x_y")["v"] == [1.0]
+        assert store.query("b_x_y")["v"] == [2.0]
+
+    def test_full_store_drops_new_series(self, store):
+        for i in range(4):
+            store.append(f"node{i}_x_y", 1.0, 1.0)
+        assert store.slot_for("overflow_x_y") == -1
+        store.append("overflow_x_y", 1.0, 1.0)  # Must not raise
+        assert store.query("overflow_x_y") is None
+
+    def test_list_series(self, store):
+        store.append(SENSOR_ID, 5.0, 1.0)
+        store.append(SENSOR_ID, 6.0, 2.0)
+        listing = store.list_series()
+        assert listing == [{"id": SENSOR_ID, "count": 2, "oldest": 5.0, "newest": 6.0}]
+
+
+class TestQuery:
+    """Tests for range and downsampled queries."""
+
+    def test_range_is_inclusive(self, store, query_mode):
+        for i in range(8):
+            store.append(SENSOR_ID, float(i), float(i))
+        result = store.query(SENSOR_ID, t_from=2.0, t_to=4.0)
+        assert result["t"] == [2.0, 3.0, 4.0]
+
+    def test_out_of_order_samples_are_found(self, store, query_mode):
+        for t in (1.0, 3.0, 2.0):
+            store.append(SENSOR_ID, t, t)
+        result = store.query(SENSOR_ID, t_from=2.0, t_to=2.0)
+        assert result["v"] == [2.0]
+
+    def test_downsample_buckets(self, store, query_mode):
+        for i in range(8):
+            store.append(SENSOR_ID, float(i), float(i))
+        result = store.query(SENSOR_ID, t_from=0.0, step=4.0)
+        assert result["t"] == [0.0, 4.0]
+        assert result["v"] == [1.5, 5.5]
+        assert result["min"] == [0.0, 4.0]
+        assert result["max"] == [3.0, 7.0]
+        assert result["count"] == [4, 4]
+
+    def test_downsample_empty_range(self, store, query_mode):
+        store.append(SENSOR_ID, 1.0, 1.0)
+        result = store.query(SENSOR_ID, t_from=50.0, step=10.0)
+        assert result["t"] == []
+        assert result["count"] == []
+
+    def test_invalid_step(self, store):
+        store.append(SENSOR_ID, 1.0, 1.0)
+        with pytest.raises(ValueError):
+            store.query(SENSOR_ID, step=0)
+
+
+class TestPersistence:
+    """Tests for reopening an existing store file."""
+
+    def test_reopen_keeps_history(self, tmp_path):
+        path = str(tmp_path / "series.bin")
+        s = SeriesStore(path, capacity=8, max_series=4)
+        s.append(SENSOR_ID, 10.0, 1.5)
+        s.close()
+
+        s = SeriesStore(path, capacity=8, max_series=4)
+        assert s.query(SENSOR_ID)["v"] == [1.5]
+        s.close()
+
+    def test_geometry_change_recreates(self, tmp_path):
+        path = str(tmp_path / "series.bin")
+        s = SeriesStore(path, capacity=8, max_series=4)
+        s.append(SENSOR_ID, 10.0, 1.5)
+        s.close()
+
+        s = SeriesStore(path, capacity=16, max_series=4)
+        assert s.query(SENSOR_ID) is None
+        s.close()
+
+
+class TestPerformance:
+    """Sanity check that a full day at 1 Hz queries quickly."""
+
+    def test_one_day_query(self, tmp_path):
+        pytest.importorskip("numpy")
+        s = SeriesStore(str(tmp_path / "series.bin"), capacity=86400, max_series=1)
+        slot = s.slot_for(SENSOR_ID)
+        for i in range(86400):
+            s.append_slot(slot, float(i), float(i % 100))
+
+        start = time.perf_counter()
+        result = s.query(SENSOR_ID, t_from=0.0, t_to=86400.0, step=60.0)
+        elapsed = time.perf_counter() - start
+        s.close()
+
+        assert len(result["t"]) == 1440
+        assert elapsed < 0.5
@@ -0,0 +1,93 @@
+"""Tests for the in-process 7-segment decoder."""
+
+import numpy as np
+import pytest
+
+from sensors.seven_segment import _PATTERNS, binarize, decode_digits, read_seven_segment
+
+H, W, T = 60, 32, 6  # Digit height, width, segment thickness
+SPACING = 14
+
+# Segment rectangles (rows, cols); segments don't touch, like a real display
+SEGMENT_RECTS = {
+    "a": (slice(0, T), slice(T + 1, W - T - 1)),
+    "b": (slice(T + 1, H // 2 - 4), slice(W - T, W)),
+    "c": (slice(H // 2 + 4, H - T - 1), slice(W - T, W)),
+    "d": (slice(H - T, H), slice(T + 1, W - T - 1)),
+    "e": (slice(H // 2 + 4, H - T - 1), slice(0, T)),
+    "f": (slice(T + 1, H // 2 - 4), slice(0, T)),
+    "g": (slice(H // 2 - 3, H // 2 + 3), slice(T + 1, W - T - 1)),
+}
+
+
+def render(text: str, lit=40, background=210, margin=10) -> np.ndarray:
+    """Gray image of text on a 7-segment display (dark segments on a light panel)."""
+    cells = []
+    for char in text:
+        if char == ".":
+            cell = np.zeros((H, T + 4), dtype=bool)
+            cell[H - T:, 2:T + 2] = True
+        elif char == "1":
+            cell = np.zeros((H, T + 2), dtype=bool)
+            for segment in "bc":
+                rows, _ = SEGMENT_RECTS[segment]
+                cell[rows, 2:] = True
+        else:
+            cell = np.zeros((H, W), dtype=bool)
+            for segment in _PATTERNS[char][0]:
+                cell[SEGMENT_RECTS[segment]] = True
+        cells.append(cell)
+        cells.append(np.zeros((H, SPACING), dtype=bool))
+    mask = np.hstack(cells[:-1])
+    mask = np.pad(mask, margin)
+    return np.where(mask, lit, background).astype(np.uint8)
+
+
+class TestDecode:
+    """Tests for digit segmentation and segment masks."""
+
+    @pytest.mark.parametrize("text", ["0123456789", "8", "42", "-7", "1111", "908"])
+    def test_digits(self, text):
+        assert read_seven_segment(render(text)) == text
+
+    def test_decimal_point(self):
+        assert read_seven_segment(render("12.5")) == "12.5"
+        assert read_seven_segment(render("0.75"), num_digits=3) == "0.75"
+
+    def test_light_on_dark(self):
+        assert read_seven_segment(render("365", lit=250, background=20)) == "365"
+
+    def test_alternate_forms(self):
+        # 6 without its top segment, 9 without its bottom one
+        for text, drop in (("6", "a"), ("9", "d")):
+            image = render(text)
+            rows, cols = SEGMENT_RECTS[drop]
+            image[rows.start + 10:rows.stop + 10, cols.start + 10:cols.stop + 10] = 210
+            assert read_seven_segment(image) == text
+
+    def test_num_digits_mismatch(self):
+        assert read_seven_segment(render("123"), num_digits=4) is None
+
+    def test_unknown_pattern(self):
+        lit = np.zeros((H, W), dtype=bool)
+        for segment in "af":  # Not a digit
+            lit[SEGMENT_RECTS[segment]] = True
+        lit[SEGMENT_RECTS["e"]] = True
+        lit[SEGMENT_RECTS["d"]] = True
+        assert decode_digits(np.pad(lit, 5)) is None
+
+    def test_blank(self):
+        assert read_seven_segment(np.full((40, 40), 128, dtype=np.uint8)) is None
+        assert decode_digits(np.zeros((40, 40), dtype=bool)) is None
+
+    def test_noise_specks_ignored(self):
+        image = render("47")
+        image[2, 2] = 40
+        image[-3, -3] = 40
+        assert read_seven_segment(image) == "47"
+
+    def test_binarize_takes_minority(self):
+        gray = np.full((10, 10), 200, dtype=np.uint8)
+        gray[2:4, 2:4] = 10
+        assert binarize(gray).sum() == 4
+        assert binarize(255 - gray).sum() == 4
@@ -0,0 +1,183 @@
+"""Tests for simulated sensor drivers and the simulated radio."""
+
+import random
+
+import pytest
+
+from node.sensor_reader import SensorEntry, read_entry
+from radio import SimulatedRadio
+from sensors import get_sensor_class_id, load_sensor_class
+from sensors.ads1115_sensor import ADS1115ADC
+from sensors.bme280_sensor import BME280TempPressureHumidity
+from sensors.mma8452_sensor import MMA8452Accelerometer
+from sensors.simulated import SimulatedADS1115, SimulatedBME280, SimulatedMMA8452, Waveform
+from utils.protocol import build_lora_packets, parse_sensor_frame
+
+
+def simulated(cls, **kwargs):
+    kwargs.setdefault("clock", lambda: 0.0)
+    sensor = cls(sleep=lambda s: None, **kwargs)
+    sensor.init()
+    return sensor
+
+
+class TestMirroring:
+    """Simulated drivers look like the real ones to the rest of the node."""
+
+    @pytest.mark.parametrize("sim, real", [
+        (SimulatedBME280(), BME280TempPressureHumidity()),
+        (SimulatedMMA8452(), MMA8452Accelerometer()),
+        (SimulatedMMA8452(capture_hz=400, bands_hz=[[1, 20], [20, 200]]),
+         MMA8452Accelerometer(capture_hz=400, bands_hz=[[1, 20], [20, 200]])),
+        (SimulatedBME280(report_timing=True), BME280TempPressureHumidity(report_timing=True)),
+        (SimulatedADS1115(channels=[0, 2]), ADS1115ADC(channels=[0, 2])),
+        (SimulatedADS1115(channels=[1], names=["Soil"], units=["V"]),
+         ADS1115ADC(channels=[1], names=["Soil"], units=["V"])),
+    ])
+    def test_names_units_precision_class(self, sim, real):
+        assert sim.get_names() == real.get_names()
+        assert sim.get_units() == real.get_units()
+        assert sim.get_precision() == real.get_precision()
+        assert sim.class_name == type(real).__name__
+
+    def test_registered_and_reported_as_real_class(self):
+        cls = load_sensor_class("SimulatedBME280")
+        entry = SensorEntry(sensor=simulated(cls), interval_sec=10)
+        readings = read_entry(entry, 1000.0)
+        assert entry.class_name == "BME280TempPressureHumidity"
+        packets = build_lora_packets("sim", readings)
+        frame = parse_sensor_frame(packets[0])
+        assert frame.readings[0].sensor_class == "BME280TempPressureHumidity"
+        assert get_sensor_class_id("SimulatedBME280") is None
+
+    def test_hardware_options_accepted(self):
+        SimulatedBME280(smbus=1, address=0x77, oversampling={"pressure": 4})
+
+    def test_unsupported_options_rejected(self):
+        with pytest.raises(TypeError):
+            SimulatedBME280(mystery=True)
+        with pytest.raises(ValueError):
+            SimulatedMMA8452(capture_hz=300)
+
+    def test_capture_mode_features_from_axis_waveforms(self):
+        # 40 Hz tone on X, 0.05 g amplitude: RMS 0.035 g, all in the 20-200 Hz band
+        sensor = simulated(
+            SimulatedMMA8452, capture_hz=400, window_sec=1.0, bands_hz=[[1, 20], [20, 200]],
+            readings={"Accel X": {"amplitude": 0.05, "period_sec": 1 / 40},
+                      "Accel Y": {}, "Accel Z": {"base": 1.0}},
+        )
+        features = dict(zip(sensor.get_names(), sensor.read()))
+        assert features["Vib RMS X"] == pytest.approx(0.05 / 2 ** 0.5, rel=0.02)
+        assert features["Vib RMS Z"] == pytest.approx(0.0, abs=1e-9)
+        assert features["Vib 20-200Hz"] == pytest.approx(features["Vib RMS X"], rel=0.05)
+        assert features["Vib 1-20Hz"] < 0.01
+
+    def test_ads_transforms_applied(self):
+        sensor = simulated(SimulatedADS1115, channels=[0],
+                           transforms={"0": {"raw_min": 0.0, "raw_max": 3.3}},
+                           readings={"A0": {"base": 1.65}})
+        assert sensor.transform(sensor.read()) == pytest.approx((0.5,))
+
+
+class TestWaveforms:
+    """Tests for seeded, reproducible values."""
+
+    def test_same_seed_same_values(self):
+        a = simulated(SimulatedBME280, seed=5)
+        b = simulated(SimulatedBME280, seed=5)
+        c = simulated(SimulatedBME280, seed=6)
+        seq_a = [a.read() for _ in range(20)]
+        assert seq_a == [b.read() for _ in range(20)]
+        assert seq_a != [c.read() for _ in range(20)]
+
+    def test_sine_follows_clock(self, clock):
+        sensor = simulated(SimulatedMMA8452, clock=clock, readings={
+            "Accel X": {"base": 1.0, "amplitude": 0.5, "period_sec": 4.0},
+        })
+        clock.t = 1.0
+        assert sensor.read()[0] == pytest.approx(1.5)
+        clock.t = 3.0
+        assert sensor.read()[0] == pytest.approx(0.5)
+
+    def test_steps_clamp_and_dropout(self):
+        wave = Waveform.from_config({"base": 10, "step_prob": 1.0, "step_size": 4, "max": 18})
+        rng = random.Random(0)
+        values = [wave.sample(0.0, rng) for _ in range(50)]
+        assert all(v == 18 or (v <= 18 and (v - 10) % 4 == 0) for v in values)
+        assert len(set(values)) > 3
+        dropping = Waveform.from_config({"dropout": 1.0})
+        assert dropping.sample(0.0, rng) is None
+
+    @pytest.mark.parametrize("config", [{"bogus": 1}, {"period_sec": 0}, {"dropout": 2}])
+    def test_invalid_waveform(self, config):
+        with pytest.raises(ValueError):
+            Waveform.from_config(config)
+
+    def test_unknown_reading(self):
+        with pytest.raises(ValueError):
+            SimulatedBME280(readings={"Altitude": {}})
+
+
+class TestFaults:
+    """Tests for latency and failure injection."""
+
+    def test_fail_rate_and_values_unaffected(self):
+        flaky = simulated(SimulatedBME280, seed=1, fail_rate=0.3)
+        clean = simulated(SimulatedBME280, seed=1)
+        for _ in range(100):
+            try:
+                value = flaky.read()
+            except OSError:
+                continue
+            assert value == clean.read()
+        assert 10 < flaky.failures < 60
+
+    def test_latency(self):
+        slept = []
+        sensor = SimulatedMMA8452(read_latency_sec=0.02, latency_jitter_sec=0.01,
+                                  init_latency_sec=0.5, sleep=slept.append)
+        sensor.init()
+        sensor.read()
+        assert slept[0] == 0.5 and 0.02 <= slept[1] <= 0.03
+
+    def test_init_fail(self):
+        with pytest.raises(RuntimeError):
+            SimulatedBME280(init_fail=True).init()
+
+
+class TestSimulatedRadio:
+    """Tests for the fake radio."""
+
+    def test_send_counts_and_airtime(self):
+        got = []
+        radio = SimulatedRadio(realtime=False, keep_sent=2, on_send=got.append)
+        radio.init()
+        for n in range(3):
+            assert radio.send(bytes([n]) * 10)
+        assert radio.packets_sent == 3 and radio.bytes_sent == 30
+        assert radio.airtime_sec > 0
+        assert radio.sent == [bytes([1]) * 10, bytes([2]) * 10] and len(got) == 3
+
+    def test_loss_is_seeded(self):
+        def losses(seed):
+            radio = SimulatedRadio(realtime=False, loss_rate=0.5, seed=seed)
+            radio.init()
+            for _ in range(40):
+                radio.send(b"x")
+            return radio.packets_lost
+        assert losses(3) == losses(3)
+        assert 5 < losses(3) < 35
+
+    def test_injected_packets_received(self):
+        radio = SimulatedRadio(realtime=False)
+        radio.init()
+        radio.listen()
+        assert not radio.rx_done()
+        radio.inject(b"cmd")
+        assert radio.rx_done()
+        assert radio.receive(timeout=0) == b"cmd"
+        assert radio.receive(timeout=0) is None
+
+    def test_requires_init(self):
+        with pytest.raises(RuntimeError):
+            SimulatedRadio().send(b"x")
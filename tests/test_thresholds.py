@@ -0,0 +1,72 @@
+"""Tests for the threshold hysteresis state machine."""
+
+import pytest
+
+from sensors.thresholds import (
+    AlertState,
+    ThresholdConfig,
+    crossed_limit,
+    next_state,
+)
+
+SOIL = ThresholdConfig(low=1.5, high=3.0, hysteresis=0.3)
+
+
+def run(values, config=SOIL):
+    """States after each value, starting NORMAL."""
+    state, states = AlertState.NORMAL, []
+    for value in values:
+        state = next_state(state, value, config)
+        states.append(state)
+    return states
+
+
+class TestThresholdConfig:
+    """Tests for config validation."""
+
+    def test_needs_a_limit(self):
+        with pytest.raises(ValueError):
+            ThresholdConfig()
+
+    def test_low_below_high(self):
+        with pytest.raises(ValueError):
+            ThresholdConfig(low=3.0, high=1.0)
+
+    def test_negative_hysteresis(self):
+        with pytest.raises(ValueError):
+            ThresholdConfig(low=1.0, hysteresis=-0.1)
+
+
+class TestStateMachine:
+    """Tests for state transitions."""
+
+    def test_soil_moisture_sequence(self):
+        """The worked example from the plan: one alert per crossing, one recovery."""
+        normal, low = AlertState.NORMAL, AlertState.ALERT_LOW
+        assert run((2.0, 1.5, 1.6, 1.4, 1.7, 1.8, 1.9)) == [
+            normal, low, low, low, low, normal, normal
+        ]
+
+    def test_high_and_recovery(self):
+        high, normal = AlertState.ALERT_HIGH, AlertState.NORMAL
+        assert run((3.1, 2.8, 2.7)) == [high, high, normal]
+        assert crossed_limit(normal, high, SOIL) == 3.0
+
+    def test_direct_crossover(self):
+        assert run((3.5, 1.0)) == [AlertState.ALERT_HIGH, AlertState.ALERT_LOW]
+
+
+class TestStateFunctions:
+    """Tests for the pure helpers shared with gateway rules."""
+
+    def test_next_state_holds_within_hysteresis(self):
+        config = ThresholdConfig(low=1.5, hysteresis=0.3)
+        assert next_state(AlertState.NORMAL, 1.4, config) is AlertState.ALERT_LOW
+        assert next_state(AlertState.ALERT_LOW, 1.7, config) is AlertState.ALERT_LOW
+        assert next_state(AlertState.ALERT_LOW, 1.8, config) is AlertState.NORMAL
+
+    def test_crossed_limit(self):
+        config = ThresholdConfig(low=1.5, high=3.0)
+        assert crossed_limit(AlertState.ALERT_HIGH, AlertState.NORMAL, config) == 3.0
+        assert crossed_limit(AlertState.NORMAL, AlertState.ALERT_LOW, config) == 1.5
+        assert crossed_limit(AlertState.NORMAL, AlertState.STALE, config) is None
@@ -0,0 +1,312 @@
+"""Tests for confirmed uplinks: sequenced packets, node backlog, gateway ACKs."""
+
+from unittest.mock import MagicMock
+
+import pytest
+
+from gateway.uplink_acks import MAX_SACK_RANGES, UplinkAckTracker
+from node.uplink_backlog import UplinkBacklog
+from utils.protocol import (
+    LORA_MAX_PAYLOAD,
+    SensorReading,
+    build_lora_packets,
+    build_sack_packet,
+    mark_backfill,
+    parse_lora_packet,
+    parse_sack_packet,
+    parse_sensor_frame,
+    seqs_to_ranges,
+)
+
+
+def readings(count=2, ts=1700000000.0):
+    return [
+        SensorReading(
+            name=f"Reading {i}", units="V", value=float(i),
+            sensor_class="ADS1115ADC", timestamp=ts,
+        )
+        for i in range(count)
+    ]
+
+
+@pytest.fixture
+def backlog(tmp_path, clock):
+    b = UplinkBacklog(tmp_path / "backlog.bin", slots=8, ack_timeout_sec=30,
+                      max_per_broadcast=2, clock=clock, first_seq=0)
+    yield b
+    b.close()
+
+
+def send(backlog, count=1):
+    seq = backlog.next_seq
+    packets = [build_lora_packets("patio", readings(), seq=seq + i)[0] for i in range(count)]
+    backlog.record(seq, packets)
+    return packets
+
+
+class TestSequencedPackets:
+    """Tests for the protocol fields."""
+
+    def test_unsequenced_packets_unchanged(self):
+        (packet,) = build_lora_packets("patio", readings())
+        assert b'"q"' not in packet
+        frame = parse_sensor_frame(packet)
+        assert frame.seq is None and not frame.backfill
+
+    def test_split_packets_numbered_consecutively(self):
+        packets = build_lora_packets("patio", readings(40), seq=10)
+        assert len(packets) > 1
+        assert [parse_sensor_frame(p).seq for p in packets] == list(range(10, 10 + len(packets)))
+
+    def test_mark_backfill_fits_and_verifies(self):
+        for packet in build_lora_packets("patio", readings(40), seq=0):
+            marked = mark_backfill(packet)
+            assert len(marked) <= LORA_MAX_PAYLOAD
+            frame = parse_sensor_frame(marked)
+            assert frame.backfill
+            assert parse_lora_packet(marked)[1] == parse_lora_packet(packet)[1]
+
+    def test_mark_backfill_rejects_corrupt(self):
+        (packet,) = build_lora_packets("patio", readings(), seq=0)
+        assert mark_backfill(packet.replace(b"patio", b"pati0")) is None
+
+    def test_sack_round_trip(self):
+        ranges = seqs_to_ranges([5, 1, 2, 3, 7, 2])
+        assert ranges == [[1, 3], [5, 5], [7, 7]]
+        assert parse_sack_packet(build_sack_packet("patio", ranges)) == (
+            "patio", [(1, 3), (5, 5), (7, 7)]
+        )
+
+    def test_sack_is_not_a_sensor_packet(self):
+        sack = build_sack_packet("patio", [[0, 1]])
+        assert parse_sensor_frame(sack) is None
+        (packet,) = build_lora_packets("patio", readings(), seq=0)
+        assert parse_sack_packet(packet) is None
+
+
+class TestUplinkBacklog:
+    """Tests for the node-side on-disk ring."""
+
+    def test_no_backfill_until_link_up(self, backlog, clock):
+        send(backlog, 3)
+        clock.t = 100
+        assert backlog.take_backfill() == []
+
+    def test_ack_confirms_and_backfills_rest(self, backlog, clock):
+        packets = send(backlog, 4)
+        assert backlog.ack([(0, 1)]) == 2
+        assert backlog.take_backfill() == []  # Not timed out yet
+
+        clock.t = 31
+        backfill = backlog.take_backfill()
+        assert [parse_sensor_frame(p).seq for p in backfill] == [2, 3]
+        assert all(parse_sensor_frame(p).backfill for p in backfill)
+        assert parse_lora_packet(backfill[0]) == parse_lora_packet(packets[2])
+        # Just resent: waits another ack_timeout
+        assert backlog.take_backfill() == []
+
+    def test_backfill_limited_per_broadcast(self, backlog, clock):
+        send(backlog, 5)
+        backlog.ack([(100, 100)])  # Link up, nothing confirmed
+        clock.t = 31
+        assert len(backlog.take_backfill()) == 2
+        assert backlog.pending_count == 5
+
+    def test_link_down_after_timeout(self, backlog, clock):
+        send(backlog, 1)
+        backlog.ack([(100, 100)])
+        clock.t = 400
+        assert backlog.take_backfill() == []
+
+    def test_pending_survives_restart(self, tmp_path, backlog, clock):
+        send(backlog, 3)
+        backlog.ack([(0, 0)])
+        backlog.close()
+
+        reopened = UplinkBacklog(tmp_path / "backlog.bin", slots=8, clock=clock)
+        try:
+            assert reopened.next_seq == 3
+            assert reopened.pending_count == 2
+            reopened.ack([(50, 50)])
+            # Loaded packets go out as soon as the link is up
+            seqs = [parse_sensor_frame(p).seq for p in reopened.take_backfill()]
+            assert seqs == [1, 2]
+        finally:
+            reopened.close()
+
+    def test_ring_overwrites_oldest_unconfirmed(self, backlog):
+        send(backlog, 10)
+        assert backlog.overwritten == 2
+        assert backlog.pending_count == 8
+
+    def test_torn_slot_ignored(self, tmp_path, backlog, clock):
+        send(backlog, 2)
+        backlog.close()
+        path = tmp_path / "backlog.bin"
+        data = bytearray(path.read_bytes())
+        data[16 + 12 + 5] ^= 0xFF  # Corrupt slot 0 payload
+        path.write_bytes(bytes(data))
+
+        reopened = UplinkBacklog(path, slots=8, clock=clock)
+        try:
+            assert reopened.pending_count == 1
+            assert reopened.next_seq == 2
+        finally:
+            reopened.close()
+
+    def test_layout_change_recreates(self, tmp_path, backlog):
+        send(backlog, 2)
+        backlog.close()
+        other = UplinkBacklog(tmp_path / "backlog.bin", slots=16, first_seq=500)
+        try:
+            assert other.pending_count == 0 and other.next_seq == 500
+        finally:
+            other.close()
+
+    def test_new_file_starts_at_persisted_random_seq(self, tmp_path, clock):
+        path = tmp_path / "fresh.bin"
+        first = UplinkBacklog(path, slots=8, clock=clock)
+        start = first.next_seq
+        first.close()
+        assert start < 1 << 31
+
+        reopened = UplinkBacklog(path, slots=8, clock=clock)
+        try:
+            assert reopened.next_seq == start
+        finally:
+            reopened.close()
+
+
+class TestUplinkAckTracker:
+    """Tests for gateway-side batching and dedup."""
+
+    def test_batches_after_delay(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=1.0, clock=clock)
+        for seq in (4, 5, 6, 9):
+            assert tracker.record("patio", seq)
+        assert tracker.due_acks() == []
+
+        clock.t = 1.0
+        ((node_id, packet),) = tracker.due_acks()
+        assert parse_sack_packet(packet) == ("patio", [(4, 6), (9, 9)])
+        assert tracker.due_acks() == []
+
+    def test_duplicate_reacked_but_flagged(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, clock=clock)
+        assert tracker.record("patio", 1)
+        tracker.due_acks()
+        assert not tracker.record("patio", 1, backfill=True)
+        assert tracker.duplicates == 1
+        ((_, packet),) = tracker.due_acks()
+        assert parse_sack_packet(packet)[1] == [(1, 1)]
+
+    def test_dedup_window_bounded(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, dedup_window=2, clock=clock)
+        for seq in (1, 2, 3):
+            tracker.record("patio", seq)
+        assert tracker.record("patio", 1)
+
+    def test_sequence_restart_clears_window(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, dedup_window=4, clock=clock)
+        for seq in range(100, 110):
+            tracker.record("patio", seq)
+        # Backlog recreated on the node: numbering starts over
+        assert tracker.record("patio", 0)
+        assert tracker.resets == 1
+        # Dedup works as usual from the new start
+        assert tracker.record("patio", 1)
+        assert not tracker.record("patio", 1)
+        assert tracker.duplicates == 1
+
+    def test_old_backfill_is_not_a_restart(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, dedup_window=4, clock=clock)
+        for seq in range(100, 110):
+            tracker.record("patio", seq)
+        # Backfill from before the window (long outage): delivered, window kept
+        assert tracker.record("patio", 90, backfill=True)
+        assert tracker.resets == 0
+        assert not tracker.record("patio", 109)
+        assert tracker.record("patio", 110)
+
+    def test_window_below_backlog_slots_rejected(self):
+        with pytest.raises(ValueError):
+            UplinkAckTracker.from_config({"dedup_window": 256, "max_backlog_slots": 512})
+        UplinkAckTracker.from_config({"dedup_window": 2048, "max_backlog_slots": 2048})
+
+    def test_seq_wraparound_is_not_a_restart(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, dedup_window=4, clock=clock)
+        tracker.record("patio", 0xFFFFFFFE)
+        assert tracker.record("patio", 0)
+        assert tracker.resets == 0
+        assert not tracker.record("patio", 0xFFFFFFFE)
+
+    def test_many_ranges_split(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, clock=clock)
+        for seq in range(0, 2 * (MAX_SACK_RANGES + 4), 2):
+            tracker.record("patio", seq)
+        ((_, first),) = tracker.due_acks()
+        assert len(parse_sack_packet(first)[1]) == MAX_SACK_RANGES
+        assert len(first) <= LORA_MAX_PAYLOAD
+        ((_, second),) = tracker.due_acks()
+        assert len(parse_sack_packet(second)[1]) == 4
+
+    def test_large_seqs_split_by_payload(self, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, clock=clock)
+        base = 2_000_000_000
+        for seq in range(base, base + 2 * MAX_SACK_RANGES, 2):
+            tracker.record("patio", seq)
+        sent = []
+        while packets := tracker.due_acks():
+            ((_, packet),) = packets
+            assert len(packet) <= LORA_MAX_PAYLOAD
+            sent += parse_sack_packet(packet)[1]
+        assert len(sent) == MAX_SACK_RANGES
+
+
+class TestEndToEnd:
+    """Backlog and tracker together, through a lost-ACK outage."""
+
+    def test_gapless_after_outage(self, backlog, clock):
+        tracker = UplinkAckTracker(ack_delay_sec=0.0, clock=clock)
+        delivered = {}
+
+        def gateway_receive(packet):
+            frame = parse_sensor_frame(packet)
+            if tracker.record(frame.node_id, frame.seq, frame.backfill):
+                delivered[frame.seq] = frame.backfill
+
+        # Gateway down for seqs 0-2, back for 3
+        send(backlog, 3)
+        (live,) = send(backlog, 1)
+        gateway_receive(live)
+        for _, sack in tracker.due_acks():
+            backlog.ack(parse_sack_packet(sack)[1])
+
+        for _ in range(3):
+            clock.t += 31
+            for packet in backlog.take_backfill():
+                gateway_receive(packet)
+            for _, sack in tracker.due_acks():
+                backlog.ack(parse_sack_packet(sack)[1])
+
+        assert sorted(delivered) == [0, 1, 2, 3]
+        assert delivered[0] and not delivered[3]
+        assert backlog.pending_count == 0
+
+
+class TestCollectorHistorical:
+    """Backfilled readings skip live-only processing."""
+
+    def test_historical_skips_alerts_and_last_seen(self):
+        from gateway.sensor_collection import SensorDataCollector
+
+        alerts = MagicMock()
+        collector = SensorDataCollector("gw", MagicMock(), alert_manager=alerts)
+        collector.add_readings("patio", readings(1), historical=True)
+        alerts.check.assert_not_called()
+        template = collector.series_registry.get("patio", "ADS1115ADC", "Reading 0", "V")
+        assert template.last_seen == 0.0
+
+        collector.add_readings("patio", readings(1))
+        alerts.check.assert_called_once()
+        assert template.last_seen > 0
@@ -0,0 +1,176 @@
+"""Tests for vibration feature extraction and MMA8452 capture mode."""
+
+import math
+import sys
+import types
+
+import numpy as np
+import pytest
+
+from sensors.mma8452_sensor import MMA8452Accelerometer
+from sensors.vibration import (
+    DEFAULT_BANDS_HZ,
+    BurstCapture,
+    compute_features,
+    feature_names,
+)
+
+RATE = 400.0
+BANDS = DEFAULT_BANDS_HZ
+
+
+def sine_window(freq, amplitude, n=800, axis=0, gravity=1.0):
+    t = np.arange(n) / RATE
+    samples = np.zeros((n, 3))
+    samples[:, 2] = gravity
+    samples[:, axis] += amplitude * np.sin(2 * math.pi * freq * t)
+    return samples
+
+
+class TestComputeFeatures:
+    """Tests for the numpy window reduction."""
+
+    def test_sine_rms_peak_crest(self):
+        values = dict(zip(feature_names(BANDS), compute_features(sine_window(30, 0.5), RATE, BANDS)))
+        assert values["Vib RMS X"] == pytest.approx(0.5 / math.sqrt(2), rel=1e-3)
+        # Gravity is removed with the mean
+        assert values["Vib RMS Z"] == pytest.approx(0.0, abs=1e-9)
+        assert values["Vib Peak"] == pytest.approx(0.5, rel=1e-3)
+        assert values["Vib Crest"] == pytest.approx(math.sqrt(2), rel=1e-2)
+
+    def test_band_energy_lands_in_band(self):
+        samples = sine_window(30, 0.5) + sine_window(120, 0.2, axis=1, gravity=0)
+        values = dict(zip(feature_names(BANDS), compute_features(samples, RATE, BANDS)))
+        assert values["Vib 10-50Hz"] == pytest.approx(0.5 / math.sqrt(2), rel=0.02)
+        assert values["Vib 100-200Hz"] == pytest.approx(0.2 / math.sqrt(2), rel=0.02)
+        assert values["Vib 1-10Hz"] < 0.01 and values["Vib 50-100Hz"] < 0.01
+
+    def test_impulse_has_high_crest(self):
+        samples = np.zeros((400, 3))
+        samples[200, 0] = 2.0
+        values = dict(zip(feature_names(BANDS), compute_features(samples, RATE, BANDS)))
+        assert values["Vib Crest"] > 10
+
+
+class TestBurstCapture:
+    """Tests for the capture thread with a fake sample source."""
+
+    def test_windows_from_source(self):
+        samples = iter(sine_window(30, 0.5, n=10_000))
+        toggle = [False]
+
+        def read_sample():
+            toggle[0] = not toggle[0]
+            return tuple(next(samples)) if toggle[0] else None  # Every other poll not ready
+
+        capture = BurstCapture(read_sample, 4000.0, 400, BANDS)
+        capture.start()
+        try:
+            features = capture.latest(timeout=5.0)
+        finally:
+            capture.stop()
+            capture.join(1.0)
+        assert len(features) == len(feature_names(BANDS))
+        assert capture.windows >= 1
+
+    def test_stale_window_not_served(self, clock):
+        samples = iter(sine_window(30, 0.5, n=400))
+        capture = BurstCapture(lambda: next(samples, None), 4000.0, 400, BANDS, clock=clock)
+        capture.start()
+        try:
+            assert capture.latest(timeout=5.0)
+            # Source stalled: no new window for more than two window lengths
+            clock.t = 0.25
+            with pytest.raises(TimeoutError, match="old"):
+                capture.latest(timeout=0.01)
+        finally:
+            capture.stop()
+            capture.join(1.0)
+
+    def test_unexpected_error_keeps_thread_alive(self):
+        calls = [0]
+
+        def read_sample():
+            calls[0] += 1
+            if calls[0] == 1:
+                raise ValueError("garbled sample")
+            return (0.0, 0.0, 1.0)
+
+        capture = BurstCapture(read_sample, 4000.0, 50, BANDS)
+        capture.start()
+        try:
+            capture.latest(timeout=5.0)
+            assert capture.is_alive()
+            assert capture.errors == 1
+        finally:
+            capture.stop()
+            capture.join(1.0)
+
+    def test_no_window_yet(self):
+        capture = BurstCapture(lambda: None, 400.0, 800)
+        with pytest.raises(TimeoutError):
+            capture.latest(timeout=0.01)
+
+
+class FakeBus:
+    """MMA8452 register model producing a 70 Hz sine on X."""
+
+    def __init__(self, _num):
+        self.regs = {MMA8452Accelerometer.REG_WHO_AM_I: 0x2A,
+                     MMA8452Accelerometer.REG_CTRL_REG1: 0}
+        self.n = 0
+
+    def read_byte_data(self, _addr, reg):
+        return self.regs.get(reg, 0)
+
+    def write_byte_data(self, _addr, reg, value):
+        self.regs[reg] = value
+
+    def read_i2c_block_data(self, _addr, reg, length):
+        assert (reg, length) == (MMA8452Accelerometer.REG_STATUS, 7)
+        self.n += 1
+        x = int(1024 * 0.25 * math.sin(2 * math.pi * 70 * self.n / 400)) & 0xFFF
+        z = 1024
+        return [0x08, x >> 4, (x & 0xF) << 4, 0, 0, z >> 4, (z & 0xF) << 4]
+
+    def close(self):
+        pass
+
+
+class TestMMA8452Capture:
+    """Tests for the driver's capture mode."""
+
+    def test_capture_mode(self, monkeypatch):
+        monkeypatch.setitem(sys.modules, "smbus2", types.SimpleNamespace(SMBus=FakeBus))
+        monkeypatch.setattr("sensors.mma8452_sensor.sleep", lambda s: None)
+        sensor = MMA8452Accelerometer(capture_hz=400, window_sec=0.5)
+        sensor.init()
+        try:
+            # DR bits set for 400 Hz, device active
+            assert sensor._bus.raw.regs[sensor.REG_CTRL_REG1] == (1 << 3) | 0x01
+            values = dict(zip(sensor.get_names(), sensor.read()))
+        finally:
+            sensor.close()
+        assert len(sensor.get_units()) == len(values)
+        assert values["Vib RMS X"] == pytest.approx(0.25 / math.sqrt(2), rel=0.02)
+        assert values["Vib 10-50Hz"] < values["Vib 50-100Hz"]
+
+    def test_axis_calibration_applied_per_window(self, monkeypatch):
+        monkeypatch.setitem(sys.modules, "smbus2", types.SimpleNamespace(SMBus=FakeBus))
+        monkeypatch.setattr("sensors.mma8452_sensor.sleep", lambda s: None)
+        sensor = MMA8452Accelerometer(capture_hz=400, window_sec=0.5)
+        sensor.set_calibration({"Accel X": {"type": "linear", "scale": 2.0}})
+        assert sensor.calibration is None
+        sensor.init()
+        try:
+            values = dict(zip(sensor.get_names(), sensor.read()))
+        finally:
+            sensor.close()
+        assert values["Vib RMS X"] == pytest.approx(0.5 / math.sqrt(2), rel=0.02)
+
+    def test_bad_rate(self):
+        with pytest.raises(ValueError):
+            MMA8452Accelerometer(capture_hz=300)
+
+    def test_single_sample_names_unchanged(self):
+        assert MMA8452Accelerometer().get_names() == ("Accel X", "Accel Y", "Accel Z")
@@ -8,12 +8,14 @@ from .gateway_state import GatewayState, LastPacketInfo, LocalSensorReading
 from .led import RgbLed
 from .node_state import NodeState, SensorReadingInfo
 from .protocol import (
+    SensorFrame,
     SensorReading,
     add_crc,
     build_lora_packets,
     calculate_crc32,
     make_sensor_id,
     parse_lora_packet,
+    parse_sensor_frame,
     parse_sensor_id,
     verify_crc,
 )
@@ -36,7 +38,9 @@ __all__ = [
     "add_crc",
     "verify_crc",
     # LoRa messages
+    "SensorFrame",
     "SensorReading",
     "build_lora_packets",
     "parse_lora_packet",
+    "parse_sensor_frame",
 ]
@@ -37,6 +37,7 @@ class HandlerEntry:
     scope: CommandScope
     early_ack: bool
     ack_jitter: bool
+    inline: bool = False  # Run on the radio receive thread, not the handler pool
 
 
 class CommandRegistry:
@@ -82,6 +83,7 @@ class CommandRegistry:
         scope: CommandScope = CommandScope.ANY,
         early_ack: bool = True,
         ack_jitter: bool = False,
+        inline: bool = False,
     ) -> None:
         """
         Register a callback for a command.
@@ -95,11 +97,16 @@ class CommandRegistry:
             scope: When to invoke: BROADCAST, PRIVATE, or ANY
             early_ack: True = ACK before handler, False = ACK after handler with response
             ack_jitter: True = add random delay before sending ACK (for discovery)
+            inline: True = run on the receive thread (handler touches the radio)
         """
         if command not in self._handlers:
             self._handlers[command] = []
         entry = HandlerEntry(
-            callback=callback, scope=scope, early_ack=early_ack, ack_jitter=ack_jitter
+            callback=callback,
+            scope=scope,
+            early_ack=early_ack,
+            ack_jitter=ack_jitter,
+            inline=inline,
         )
         self._handlers[command].append(entry)
         logger.debug(
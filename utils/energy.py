@@ -0,0 +1,217 @@
+"""
+LoRa time-on-air and radio energy accounting.
+
+time_on_air() implements the Semtech SX127x airtime formula (AN1200.13)
+for explicit-header packets. EnergyMeter tracks how long the radio spends
+in each state (TX from computed airtime, RX/standby/sleep from state
+changes) and turns that into an average current and mAh per hour.
+
+Currents default to the RFM95W datasheet figures on the 3.3 V rail. The
+host board isn't metered; set host_ma to include a measured baseline.
+
+Classes:
+    EnergyModel: Per-state currents
+    EnergyReport: Time split and charge for one accounting window
+    EnergyMeter: Thread-safe radio state/airtime accumulator
+
+Functions:
+    time_on_air: LoRa packet airtime in seconds
+"""
+
+from __future__ import annotations
+
+import math
+import threading
+import time
+from dataclasses import dataclass, field
+
+# RadioHead header the adafruit_rfm9x driver prepends (dest, node, id, flags)
+RADIOHEAD_HEADER_BYTES = 4
+
+STATE_RX = "rx"
+STATE_STANDBY = "standby"
+STATE_SLEEP = "sleep"
+STATES = (STATE_RX, STATE_STANDBY, STATE_SLEEP)
+
+# RFM95W PA_BOOST supply current vs output power (dBm -> mA), datasheet table
+_TX_CURRENT_POINTS = ((7, 20.0), (13, 29.0), (17, 87.0), (20, 120.0))
+
+
+def time_on_air(
+    payload_len: int,
+    spreading_factor: int = 7,
+    bandwidth_hz: int = 125000,
+    coding_rate: int = 5,
+    preamble_len: int = 8,
+    crc: bool = True,
+    header_bytes: int = RADIOHEAD_HEADER_BYTES,
+) -> float:
+    """
+    LoRa airtime for one explicit-header packet.
+
+    Args:
+        payload_len: Application payload bytes
+        spreading_factor: SF7-SF12
+        bandwidth_hz: Signal bandwidth
+        coding_rate: Denominator of the 4/x coding rate (5-8)
+        preamble_len: Programmed preamble symbols
+        crc: Payload CRC enabled
+        header_bytes: Driver header bytes added to the payload
+
+    Returns:
+        Time on air in seconds
+    """
+    t_sym = (2 ** spreading_factor) / bandwidth_hz
+    # Low data rate optimization is mandated above 16 ms symbols
+    de = 1 if t_sym > 0.016 else 0
+    length = payload_len + header_bytes
+    numerator = 8 * length - 4 * spreading_factor + 28 + (16 if crc else 0)
+    n_payload = 8 + max(
+        math.ceil(numerator / (4 * (spreading_factor - 2 * de))) * coding_rate, 0
+    )
+    return (preamble_len + 4.25) * t_sym + n_payload * t_sym
+
+
+def tx_current_ma(tx_power_dbm: float) -> float:
+    """TX supply current for an output power (linear between datasheet points)."""
+    points = _TX_CURRENT_POINTS
+    if tx_power_dbm <= points[0][0]:
+        return points[0][1]
+    for (p0, i0), (p1, i1) in zip(points, points[1:]):
+        if tx_power_dbm <= p1:
+            return i0 + (i1 - i0) * (tx_power_dbm - p0) / (p1 - p0)
+    return points[-1][1]
+
+
+@dataclass
+class EnergyModel:
+    """Supply current per radio state (mA)."""
+
+    rx_ma: float = 11.5
+    standby_ma: float = 1.6
+    sleep_ma: float = 0.0002
+    host_ma: float = 0.0  # Board baseline, if measured
+
+    @classmethod
+    def from_config(cls, config: dict | None) -> EnergyModel:
+        config = config or {}
+        return cls(
+            rx_ma=config.get("rx_ma", 11.5),
+            standby_ma=config.get("standby_ma", 1.6),
+            sleep_ma=config.get("sleep_ma", 0.0002),
+            host_ma=config.get("host_ma", 0.0),
+        )
+
+    def state_ma(self, state: str) -> float:
+        if state == STATE_RX:
+            return self.rx_ma
+        if state == STATE_STANDBY:
+            return self.standby_ma
+        return self.sleep_ma
+
+
+@dataclass
+class EnergyReport:
+    """Radio time split and charge over one window."""
+
+    elapsed_sec: float
+    tx_sec: float
+    state_sec: dict[str, float] = field(default_factory=dict)
+    mah: float = 0.0
+
+    @property
+    def mah_per_hour(self) -> float:
+        return self.mah * 3600.0 / self.elapsed_sec if self.elapsed_sec > 0 else 0.0
+
+    def duty(self, state: str) -> float:
+        """Fraction of the window spent in a state ("tx" or a radio state)."""
+        if self.elapsed_sec <= 0:
+            return 0.0
+        seconds = self.tx_sec if state == "tx" else self.state_sec.get(state, 0.0)
+        return seconds / self.elapsed_sec
+
+
+class EnergyMeter:
+    """
+    Accumulates radio state time and TX airtime.
+
+    Callers report state changes (set_state) and transmissions (add_tx);
+    TX airtime is taken out of whatever state the radio was in around it.
+    take_window() returns the report since the previous call.
+    """
+
+    def __init__(
+        self,
+        model: EnergyModel | None = None,
+        initial_state: str = STATE_STANDBY,
+        clock=time.monotonic,
+    ):
+        self._model = model or EnergyModel()
+        self._clock = clock
+        self._lock = threading.Lock()
+        self._state = initial_state
+        self._since = clock()
+        self._window_start = self._since
+        self._state_sec = dict.fromkeys(STATES, 0.0)
+        self._tx_sec = 0.0
+        self._tx_mas = 0.0  # TX charge in mA·s (current depends on power)
+
+    @property
+    def state(self) -> str:
+        return self._state
+
+    def set_state(self, state: str) -> None:
+        """Record that the radio entered a state (no-op if unchanged)."""
+        with self._lock:
+            if state == self._state:
+                return
+            self._close_segment()
+            self._state = state
+
+    def add_tx(
+        self,
+        payload_len: int,
+        spreading_factor: int = 7,
+        bandwidth_hz: int = 125000,
+        tx_power_dbm: float = 23,
+    ) -> float:
+        """Account one transmitted packet. Returns its airtime in seconds."""
+        airtime = time_on_air(payload_len, spreading_factor, bandwidth_hz)
+        with self._lock:
+            self._tx_sec += airtime
+            self._tx_mas += airtime * tx_current_ma(tx_power_dbm)
+        return airtime
+
+    def take_window(self) -> EnergyReport:
+        """Report since the last call and start a new window."""
+        with self._lock:
+            self._close_segment()
+            now = self._clock()
+            elapsed = now - self._window_start
+            state_sec = dict(self._state_sec)
+            # TX time was spent inside some state segment; don't count it twice
+            busy = sum(state_sec.values())
+            if busy > 0:
+                scale = max(0.0, busy - self._tx_sec) / busy
+                state_sec = {k: v * scale for k, v in state_sec.items()}
+            mas = self._tx_mas + sum(
+                sec * self._model.state_ma(state) for state, sec in state_sec.items()
+            )
+            mas += elapsed * self._model.host_ma
+            report = EnergyReport(
+                elapsed_sec=elapsed,
+                tx_sec=self._tx_sec,
+                state_sec=state_sec,
+                mah=mas / 3600.0,
+            )
+            self._window_start = now
+            self._state_sec = dict.fromkeys(STATES, 0.0)
+            self._tx_sec = 0.0
+            self._tx_mas = 0.0
+            return report
+
+    def _close_segment(self) -> None:
+        # Caller holds self._lock
+        now = self._clock()
+        self._state_sec[self._state] = self._state_sec.get(self._state, 0.0) + now - self._since
+        self._since = now
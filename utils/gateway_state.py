@@ -38,6 +38,14 @@ class LocalSensorReading:
     units: str = ""
 
 
+@dataclass
+class NodeBootInfo:
+    """A node's latest boot-to-first-packet breakdown."""
+
+    timestamp: float = 0.0
+    timings: dict[str, float] = field(default_factory=dict)  # "Radio Init" -> seconds
+
+
 @dataclass
 class GatewayState:
     """
@@ -60,6 +68,7 @@ class GatewayState:
     config_path: str = ""
     radio_state: RadioState | None = None  # Shared RadioState class
     command_queue: Any = None  # CommandQueue (avoid circular import)
+    node_boots: dict[str, NodeBootInfo] = field(default_factory=dict)
 
     _lock: threading.Lock = field(default_factory=threading.Lock)
 
@@ -108,6 +117,21 @@ class GatewayState:
                 sensor_units=self.last_packet.sensor_units,
             )
 
+    def update_node_boot(self, node_id: str, timings: dict[str, float]) -> None:
+        """Record a node's boot timing report (thread-safe)."""
+        with self._lock:
+            self.node_boots[node_id] = NodeBootInfo(
+                timestamp=time.time(), timings=dict(timings)
+            )
+
+    def get_node_boots(self) -> dict[str, NodeBootInfo]:
+        """Get a copy of the latest boot report per node (thread-safe)."""
+        with self._lock:
+            return {
+                node_id: NodeBootInfo(timestamp=info.timestamp, timings=dict(info.timings))
+                for node_id, info in self.node_boots.items()
+            }
+
     def update_local_sensors(self, readings: list[tuple[str, float, str]]) -> None:
         """
         Update local sensor readings (thread-safe).
@@ -0,0 +1,338 @@
+"""
+Shared I2C bus manager.
+
+Every driver on a node used to open its own bus handle (SMBus for the
+BME280 and MMA8452, busio.I2C for the ADS1115, luma's own SMBus for the
+SSD1306), so a display refresh could interleave with a sensor's
+read-modify-write from another thread. get_bus() instead hands out one
+SharedI2CBus per physical bus number:
+
+    bus = get_bus(1)
+    with bus.transaction():
+        ctrl = bus.read_byte_data(0x1D, 0x2A)
+        bus.write_byte_data(0x1D, 0x2A, ctrl | 0x01)
+    bus.close()  # Drops this reference; the last one closes the handle
+
+Each call takes the bus lock; transaction() holds it across several calls
+(the lock is reentrant for the holding thread). The lock is a FIFO ticket
+lock, so a 400 Hz capture thread polling in a tight loop can't starve a
+60-second sensor read or the display.
+
+Per device (address) the bus records transactions and time spent on the
+wire; per bus it records errors and lock waits (stats()).
+
+BusioAdapter exposes a SharedI2CBus through the busio.I2C interface used
+by Adafruit's CircuitPython drivers (ADS1115).
+
+Classes:
+    FairLock: Reentrant FIFO (ticket) lock
+    DeviceStats: Counters for one address
+    BusStats: Snapshot of one bus's counters
+    SharedI2CBus: Locked, metered wrapper around one smbus2.SMBus
+    BusioAdapter: busio.I2C-compatible view of a SharedI2CBus
+
+Functions:
+    get_bus: Shared bus for a bus number (reference counted)
+    bus_stats: Stats of every open bus
+"""
+
+from __future__ import annotations
+
+import logging
+import threading
+import time
+from contextlib import contextmanager
+from dataclasses import dataclass, field
+
+logger = logging.getLogger(__name__)
+
+
+class FairLock:
+    """
+    Reentrant lock granted in arrival order.
+
+    threading.Lock makes no ordering promise; a thread that releases and
+    immediately re-acquires usually wins. Here each acquire takes a ticket
+    and waits for its turn.
+    """
+
+    def __init__(self):
+        self._cond = threading.Condition(threading.Lock())
+        self._next_ticket = 0
+        self._serving = 0
+        self._owner: int | None = None
+        self._depth = 0
+
+    def acquire(self) -> None:
+        me = threading.get_ident()
+        with self._cond:
+            if self._owner == me:
+                self._depth += 1
+                return
+            ticket = self._next_ticket
+            self._next_ticket += 1
+            while self._serving != ticket:
+                self._cond.wait()
+            self._owner = me
+            self._depth = 1
+
+    def release(self) -> None:
+        with self._cond:
+            if self._owner != threading.get_ident():
+                raise RuntimeError("FairLock released by a thread that doesn't hold it")
+            self._depth -= 1
+            if self._depth == 0:
+                self._owner = None
+                self._serving += 1
+                self._cond.notify_all()
+
+    def held(self) -> bool:
+        """True if the calling thread holds the lock."""
+        return self._owner == threading.get_ident()
+
+    def __enter__(self) -> FairLock:
+        self.acquire()
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.release()
+
+
+@dataclass
+class DeviceStats:
+    """Counters for one device address."""
+
+    transactions: int = 0
+    busy_sec: float = 0.0
+    errors: int = 0
+
+
+@dataclass
+class BusStats:
+    """Snapshot of one bus's counters (stats())."""
+
+    bus: int
+    transactions: int
+    errors: int
+    last_error: str | None
+    lock_waits: int
+    lock_wait_sec: float
+    lock_wait_max_sec: float
+    devices: dict[int, DeviceStats] = field(default_factory=dict)
+
+
+class SharedI2CBus:
+    """
+    One smbus2.SMBus shared by every driver on a bus number.
+
+    Offers the smbus2 methods the drivers and luma use; the underlying
+    handle is `raw`. Obtain instances with get_bus(), not directly.
+    """
+
+    def __init__(self, bus_num: int, clock=time.monotonic):
+        from smbus2 import SMBus
+
+        self.bus_num = bus_num
+        self.raw = SMBus(bus_num)
+        self._clock = clock
+        self._lock = FairLock()
+        self._stats_lock = threading.Lock()
+        self._devices: dict[int, DeviceStats] = {}
+        self._errors = 0
+        self._last_error: str | None = None
+        self._lock_waits = 0
+        self._lock_wait_sec = 0.0
+        self._lock_wait_max = 0.0
+        self._refs = 0
+
+    # ─── Locking ────────────────────────────────────────────────────────────
+
+    def acquire(self) -> None:
+        """Take the bus lock (FIFO order); waits are metered when not nested."""
+        if self._lock.held():
+            self._lock.acquire()
+            return
+        t0 = self._clock()
+        self._lock.acquire()
+        wait = self._clock() - t0
+        with self._stats_lock:
+            self._lock_waits += 1
+            self._lock_wait_sec += wait
+            self._lock_wait_max = max(self._lock_wait_max, wait)
+
+    def release(self) -> None:
+        self._lock.release()
+
+    @contextmanager
+    def transaction(self):
+        """Hold the bus across several calls (read-modify-write, config bursts)."""
+        self.acquire()
+        try:
+            yield self
+        finally:
+            self.release()
+
+    def _call(self, address: int, method: str, *args):
+        """Run one raw call under the lock, timing it against the device."""
+        self.acquire()
+        try:
+            t0 = self._clock()
+            try:
+                return getattr(self.raw, method)(*args)
+            except OSError as e:
+                with self._stats_lock:
+                    self._errors += 1
+                    self._last_error = f"0x{address:02X} {method}: {e}"
+                    self._device(address).errors += 1
+                raise
+            finally:
+                elapsed = self._clock() - t0
+                with self._stats_lock:
+                    device = self._device(address)
+                    device.transactions += 1
+                    device.busy_sec += elapsed
+        finally:
+            self.release()
+
+    def _device(self, address: int) -> DeviceStats:
+        device = self._devices.get(address)
+        if device is None:
+            device = self._devices[address] = DeviceStats()
+        return device
+
+    # ─── smbus2 interface ───────────────────────────────────────────────────
+
+    def read_byte_data(self, address: int, register: int) -> int:
+        return self._call(address, "read_byte_data", address, register)
+
+    def write_byte_data(self, address: int, register: int, value: int) -> None:
+        self._call(address, "write_byte_data", address, register, value)
+
+    def read_i2c_block_data(self, address: int, register: int, length: int) -> list[int]:
+        return self._call(address, "read_i2c_block_data", address, register, length)
+
+    def write_i2c_block_data(self, address: int, register: int, data) -> None:
+        self._call(address, "write_i2c_block_data", address, register, data)
+
+    def write_registers(self, address: int, values: list[tuple[int, int]]) -> None:
+        """Write (register, value) pairs in order without another device in between."""
+        with self.transaction():
+            for register, value in values:
+                self.write_byte_data(address, register, value)
+
+    def i2c_rdwr(self, *messages) -> None:
+        """Combined transfer (smbus2 i2c_msg); timed against the first message's address."""
+        address = messages[0].addr if messages else 0
+        self._call(address, "i2c_rdwr", *messages)
+
+    # ─── Stats / lifetime ───────────────────────────────────────────────────
+
+    def stats(self) -> BusStats:
+        with self._stats_lock:
+            return BusStats(
+                bus=self.bus_num,
+                transactions=sum(d.transactions for d in self._devices.values()),
+                errors=self._errors,
+                last_error=self._last_error,
+                lock_waits=self._lock_waits,
+                lock_wait_sec=self._lock_wait_sec,
+                lock_wait_max_sec=self._lock_wait_max,
+                devices={
+                    addr: DeviceStats(d.transactions, d.busy_sec, d.errors)
+                    for addr, d in self._devices.items()
+                },
+            )
+
+    def close(self) -> None:
+        """Drop one reference; the last close() closes the handle."""
+        with _registry_lock:
+            self._refs -= 1
+            if self._refs > 0:
+                return
+            if _buses.get(self.bus_num) is self:
+                del _buses[self.bus_num]
+        self.raw.close()
+        logger.debug(f"I2C bus {self.bus_num} closed")
+
+
+# ─── Registry ───────────────────────────────────────────────────────────────
+
+_registry_lock = threading.Lock()
+_buses: dict[int, SharedI2CBus] = {}
+
+
+def get_bus(bus_num: int = 1) -> SharedI2CBus:
+    """
+    Shared bus for a bus number, opened on first use.
+
+    Each call adds a reference; release it with the bus's close().
+    """
+    with _registry_lock:
+        bus = _buses.get(bus_num)
+        if bus is None:
+            bus = _buses[bus_num] = SharedI2CBus(bus_num)
+            logger.debug(f"I2C bus {bus_num} opened")
+        bus._refs += 1
+        return bus
+
+
+def bus_stats() -> list[BusStats]:
+    """Stats of every open bus."""
+    with _registry_lock:
+        buses = list(_buses.values())
+    return [bus.stats() for bus in buses]
+
+
+class BusioAdapter:
+    """
+    busio.I2C interface over a SharedI2CBus.
+
+    Adafruit's I2CDevice spins on try_lock() and holds the lock for each
+    register access; here try_lock() waits its turn on the fair lock and
+    always succeeds, so those accesses queue with everyone else's.
+    """
+
+    def __init__(self, bus: SharedI2CBus):
+        self._bus = bus
+
+    def try_lock(self) -> bool:
+        self._bus.acquire()
+        return True
+
+    def unlock(self) -> None:
+        self._bus.release()
+
+    def writeto(self, address: int, buffer, *, start: int = 0, end: int | None = None) -> None:
+        from smbus2 import i2c_msg
+
+        self._bus.i2c_rdwr(i2c_msg.write(address, bytes(buffer[start:end])))
+
+    def readfrom_into(self, address: int, buffer, *, start: int = 0, end: int | None = None) -> None:
+        from smbus2 import i2c_msg
+
+        end = len(buffer) if end is None else end
+        msg = i2c_msg.read(address, end - start)
+        self._bus.i2c_rdwr(msg)
+        buffer[start:end] = bytes(msg)
+
+    def writeto_then_readfrom(
+        self,
+        address: int,
+        buffer_out,
+        buffer_in,
+        *,
+        out_start: int = 0,
+        out_end: int | None = None,
+        in_start: int = 0,
+        in_end: int | None = None,
+    ) -> None:
+        from smbus2 import i2c_msg
+
+        in_end = len(buffer_in) if in_end is None else in_end
+        write = i2c_msg.write(address, bytes(buffer_out[out_start:out_end]))
+        read = i2c_msg.read(address, in_end - in_start)
+        self._bus.i2c_rdwr(write, read)  # Repeated start between the two
+        buffer_in[in_start:in_end] = bytes(read)
+
+    def deinit(self) -> None:
+        self._bus.close()
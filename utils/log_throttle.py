@@ -0,0 +1,34 @@
+"""
+Throttled logging for errors that can repeat many times a second.
+
+Background samplers and capture threads retry forever on a failing device.
+They keep their own error counts (exposed as stats) and log through
+log_throttled(), which lets the first occurrence and then every LOG_EVERY-th
+through, so a dead sensor doesn't flood the journal.
+
+Functions:
+    log_throttled: Log the first and every Nth occurrence of an error
+"""
+
+from __future__ import annotations
+
+import logging
+
+LOG_EVERY = 100
+
+
+def log_throttled(
+    log: logging.Logger, level: int, count: int, message: str, every: int = LOG_EVERY
+) -> None:
+    """
+    Log message if count is the first or an every-th occurrence.
+
+    Args:
+        log: Logger to write to
+        level: Logging level (logging.WARNING, ...)
+        count: Occurrences so far, including this one
+        message: Message to log
+        every: Log one in this many occurrences after the first
+    """
+    if every <= 1 or count % every == 1:
+        log.log(level, message)
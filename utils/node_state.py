@@ -9,12 +9,15 @@ from __future__ import annotations
 
 import threading
 import time
-from dataclasses import dataclass, field
+from dataclasses import dataclass, field, replace
 from typing import TYPE_CHECKING
 
 from utils.radio_state import RadioState
 
 if TYPE_CHECKING:
+    from node.log_transfer import LogSender
+    from node.sample_log import SampleLog
+    from node.sensor_reader import SensorEntry
     from radio import RFM9xRadio
     from utils.led import RgbLed
 
@@ -29,6 +32,23 @@ class SensorReadingInfo:
     sensor_class: str = ""
 
 
+@dataclass
+class SensorReadStats:
+    """Per-sensor read latency and failure counters."""
+
+    reads: int = 0
+    timeouts: int = 0  # Missed deadline, or skipped while a hung read was running
+    errors: int = 0
+    last_latency_ms: float = 0.0
+    avg_latency_ms: float = 0.0  # Exponential moving average
+    max_latency_ms: float = 0.0
+    last_timed_out: bool = False
+
+
+# Smoothing factor for SensorReadStats.avg_latency_ms
+READ_LATENCY_EMA_ALPHA = 0.2
+
+
 @dataclass
 class NodeState:
     """
@@ -43,7 +63,8 @@ class NodeState:
         config_path: Path to config file for persistence
 
     Optional fields (have defaults):
-        start_time, broadcast_count, sensor_readings, ocr_result, ocr_in_progress
+        start_time, broadcast_count, sensor_readings, sensor_read_stats,
+        ocr_result, ocr_in_progress, sample_log, log_sender, sensor_entries
 
     Backwards-compatible properties:
         radio, n2g_freq, g2n_freq delegate to radio_state
@@ -55,10 +76,14 @@ class NodeState:
     start_time: float = field(default_factory=time.time)
     broadcast_count: int = 0
     sensor_readings: list[SensorReadingInfo] = field(default_factory=list)
+    sensor_read_stats: dict[str, SensorReadStats] = field(default_factory=dict)
     ocr_result: str | None = None  # None = never run, str = result or "No result found"
     ocr_in_progress: bool = False
     led: RgbLed | None = None
     default_brightness: int = 128
+    sample_log: SampleLog | None = None  # Full-resolution log for fetchlog
+    log_sender: LogSender | None = None
+    sensor_entries: list[SensorEntry] = field(default_factory=list)  # Config order
     _lock: threading.Lock = field(default_factory=threading.Lock)
 
     # ─── Backwards-Compatible Properties ────────────────────────────────────
@@ -119,6 +144,47 @@ class NodeState:
                 for r in self.sensor_readings
             ]
 
+    def record_sensor_read(
+        self,
+        sensor: str,
+        latency_sec: float | None,
+        timed_out: bool = False,
+        error: bool = False,
+    ) -> None:
+        """
+        Record the outcome of one sensor read (thread-safe).
+
+        Args:
+            sensor: Sensor label (class name, "#<index>" on repeated classes)
+            latency_sec: Read duration, or None if it didn't complete in time
+            timed_out: Read missed its deadline (or previous read still hung)
+            error: Driver raised an exception
+        """
+        with self._lock:
+            stats = self.sensor_read_stats.get(sensor)
+            if stats is None:
+                stats = self.sensor_read_stats[sensor] = SensorReadStats()
+            stats.last_timed_out = timed_out
+            if timed_out:
+                stats.timeouts += 1
+                return
+            if error:
+                stats.errors += 1
+                return
+            ms = latency_sec * 1000
+            stats.reads += 1
+            stats.last_latency_ms = ms
+            stats.max_latency_ms = max(stats.max_latency_ms, ms)
+            if stats.reads == 1:
+                stats.avg_latency_ms = ms
+            else:
+                stats.avg_latency_ms += READ_LATENCY_EMA_ALPHA * (ms - stats.avg_latency_ms)
+
+    def get_sensor_read_stats(self) -> dict[str, SensorReadStats]:
+        """Get a copy of per-sensor read stats (thread-safe)."""
+        with self._lock:
+            return {k: replace(v) for k, v in self.sensor_read_stats.items()}
+
     def increment_broadcast_count(self) -> None:
         """Increment broadcast counter (thread-safe)."""
         with self._lock:
@@ -0,0 +1,110 @@
+"""
+Notification senders for gateway alerts.
+
+Uses only the Python standard library. Email goes through SMTP with
+STARTTLS; for Gmail, use an app password (Google Account > Security >
+2-Step Verification > App passwords) rather than the account password.
+
+Classes:
+    Notifier: Base class (send() returns success, never raises)
+    LogNotifier: Writes to the gateway log
+    EmailNotifier: SMTP/STARTTLS email
+
+Functions:
+    build_email_notifier: Build an EmailNotifier from config
+"""
+
+from __future__ import annotations
+
+import logging
+import smtplib
+from email.mime.text import MIMEText
+
+logger = logging.getLogger(__name__)
+
+
+class Notifier:
+    """Base notifier. send() must not raise; return False on failure."""
+
+    name = "notifier"
+
+    def send(self, subject: str, body: str) -> bool:
+        raise NotImplementedError
+
+
+class LogNotifier(Notifier):
+    """Writes notifications to the gateway log (always enabled)."""
+
+    name = "log"
+
+    def send(self, subject: str, body: str) -> bool:
+        logger.warning(f"ALERT: {subject}")
+        return True
+
+
+class EmailNotifier(Notifier):
+    """SMTP email notifier (STARTTLS + login)."""
+
+    name = "email"
+
+    def __init__(
+        self,
+        smtp_server: str,
+        smtp_port: int,
+        username: str,
+        app_password: str,
+        recipients: list[str],
+        timeout: float = 30.0,
+    ):
+        """
+        Args:
+            smtp_server: SMTP host (e.g. "smtp.gmail.com")
+            smtp_port: SMTP port (587 for STARTTLS)
+            username: Login and From address
+            app_password: SMTP password (Gmail app password)
+            recipients: List of To addresses
+            timeout: Socket timeout in seconds
+        """
+        self._server = smtp_server
+        self._port = smtp_port
+        self._username = username
+        self._password = app_password
+        self._recipients = list(recipients)
+        self._timeout = timeout
+
+    def send(self, subject: str, body: str) -> bool:
+        if not self._recipients:
+            return False
+
+        msg = MIMEText(body)
+        msg["Subject"] = subject
+        msg["From"] = self._username
+        msg["To"] = ", ".join(self._recipients)
+
+        try:
+            with smtplib.SMTP(self._server, self._port, timeout=self._timeout) as smtp:
+                smtp.starttls()
+                smtp.login(self._username, self._password)
+                smtp.sendmail(self._username, self._recipients, msg.as_string())
+            logger.info(f"Email sent to {len(self._recipients)} recipient(s): {subject}")
+            return True
+        except (smtplib.SMTPException, OSError) as e:
+            logger.error(f"Failed to send email '{subject}': {e}")
+            return False
+
+
+def build_email_notifier(config: dict) -> EmailNotifier | None:
+    """Build an EmailNotifier from an "email" config section, or None if disabled."""
+    if not config.get("enabled", False):
+        return None
+    try:
+        return EmailNotifier(
+            smtp_server=config.get("smtp_server", "smtp.gmail.com"),
+            smtp_port=config.get("smtp_port", 587),
+            username=config["username"],
+            app_password=config["app_password"],
+            recipients=config.get("recipients", []),
+        )
+    except KeyError as e:
+        logger.error(f"Email notifier config missing {e}, email disabled")
+        return None
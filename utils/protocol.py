@@ -7,10 +7,13 @@ shared between outdoor nodes and gateways.
 Message Types:
 - LoRa broadcast: Outdoor node → Gateway (JSON with CRC)
 - LoRa command: Gateway → Node (JSON with CRC)
+- LoRa log chunk: Node → Gateway (sample log transfer, JSON with CRC)
 """
 
+import base64
 import json
 import logging
+import struct
 import time
 import zlib
 from dataclasses import dataclass
@@ -141,6 +144,7 @@ class SensorReading:
     sensor_class: str
     timestamp: float
     precision: int = 3  # Number of decimal places for float values
+    heartbeat_sec: float | None = None  # Set for deadband series (report-by-exception)
 
     def to_dict(self) -> dict:
         return {
@@ -162,7 +166,26 @@ class SensorReading:
         )
 
 
-def build_lora_packets(node_id: str, readings: list[SensorReading]) -> list[bytes]:
+# Bytes kept free in sequenced packets so mark_backfill() can add ',"b":1'
+BACKFILL_MARK_RESERVE = 6
+
+# Boot-to-first-packet report (node.boot): NodeTelemetry readings "Boot ..."
+BOOT_SENSOR_CLASS = "NodeTelemetry"
+BOOT_READING_PREFIX = "Boot "
+
+
+@dataclass
+class SensorFrame:
+    """A parsed sensor packet with its confirmed-uplink fields."""
+    node_id: str
+    readings: list[SensorReading]
+    seq: int | None = None  # Set when the node wants a sensor ACK
+    backfill: bool = False  # Historical readings resent from the node's backlog
+
+
+def build_lora_packets(
+    node_id: str, readings: list[SensorReading], seq: int | None = None
+) -> list[bytes]:
     """
     Build compact LoRa packets from readings, splitting if needed.
 
@@ -178,11 +201,18 @@ def build_lora_packets(node_id: str, readings: list[SensorReading]) -> list[byte
         k = reading name (key)
         u = units
         v = value
+        h = heartbeat seconds (optional, deadband series only)
+        q = sequence number (optional, confirmed uplink)
+        b = 1 if backfilled from the node's backlog (optional)
         c = CRC
 
+    With seq, packets are numbered seq, seq + 1, ... (one per packet) and
+    leave room for mark_backfill().
+
     Args:
         node_id: Identifier for this node
         readings: List of sensor readings (all should share same timestamp)
+        seq: First sequence number, or None for fire-and-forget packets
 
     Returns:
         List of UTF-8 encoded JSON packets ready to transmit
@@ -195,8 +225,14 @@ def build_lora_packets(node_id: str, readings: list[SensorReading]) -> list[byte
     # Round timestamp to 3 decimal places (millisecond precision)
     timestamp = round(readings[0].timestamp, 3)
 
+    max_payload = LORA_MAX_PAYLOAD
+    if seq is not None:
+        max_payload -= BACKFILL_MARK_RESERVE
+
     def build_packet(ts: float, compact_readings: list[dict]) -> bytes:
-        message = {"n": node_id, "t": ts, "r": compact_readings}
+        message: dict[str, Any] = {"n": node_id, "t": ts, "r": compact_readings}
+        if seq is not None:
+            message["q"] = seq + len(packets)
         message["c"] = calculate_crc32(message)
         return json.dumps(message, separators=(",", ":")).encode("utf-8")
 
@@ -220,12 +256,14 @@ def build_lora_packets(node_id: str, readings: list[SensorReading]) -> list[byte
             "u": reading.units,
             "v": value,
         }
+        if reading.heartbeat_sec is not None:
+            compact["h"] = reading.heartbeat_sec
 
         # Try adding to current batch
         test_readings = current_readings + [compact]
         test_packet = build_packet(timestamp, test_readings)
 
-        if len(test_packet) <= LORA_MAX_PAYLOAD:
+        if len(test_packet) <= max_payload:
             current_readings.append(compact)
         else:
             # Current batch is full, emit it and start new batch
@@ -252,6 +290,22 @@ def parse_lora_packet(data: bytes) -> tuple[str, list[SensorReading]] | None:
     Returns:
         Tuple of (node_id, readings) if valid, None if invalid/corrupted
     """
+    frame = parse_sensor_frame(data)
+    if frame is None:
+        return None
+    return frame.node_id, frame.readings
+
+
+def parse_sensor_frame(data: bytes) -> SensorFrame | None:
+    """
+    Parse a compact LoRa sensor packet, including sequence/backfill fields.
+
+    Args:
+        data: Raw bytes received from LoRa
+
+    Returns:
+        SensorFrame if valid, None if invalid/corrupted
+    """
     from sensors import get_sensor_class_name
 
     try:
@@ -278,14 +332,40 @@ def parse_lora_packet(data: bytes) -> tuple[str, list[SensorReading]] | None:
                 value=r["v"],
                 sensor_class=sensor_class,
                 timestamp=timestamp,
+                heartbeat_sec=r.get("h"),
             ))
 
-        return node_id, readings
+        seq = message.get("q")
+        return SensorFrame(
+            node_id=node_id,
+            readings=readings,
+            seq=int(seq) if seq is not None else None,
+            backfill=bool(message.get("b")),
+        )
 
     except (KeyError, TypeError, ValueError):
         return None
 
 
+def mark_backfill(packet: bytes) -> bytes | None:
+    """
+    Re-encode a stored sensor packet with the backfill flag set.
+
+    Returns:
+        Packet bytes with "b": 1 and a fresh CRC, or None if not a valid packet
+    """
+    try:
+        message = json.loads(packet.decode("utf-8"))
+    except (json.JSONDecodeError, UnicodeDecodeError):
+        return None
+    if not isinstance(message, dict) or not verify_crc(message, crc_key="c"):
+        return None
+    del message["c"]
+    message["b"] = 1
+    message["c"] = calculate_crc32(message)
+    return json.dumps(message, separators=(",", ":")).encode("utf-8")
+
+
 # =============================================================================
 # LoRa Command Messages (Gateway → Node)
 # =============================================================================
@@ -471,3 +551,247 @@ def parse_ack_packet(data: bytes) -> AckPacket | None:
     except (KeyError, TypeError, ValueError) as e:
         cmd_logger.debug("ACK_FIELD_ERR error=%s message=%s", e, message)
         return None
+
+
+# =============================================================================
+# LoRa Sensor ACK Messages (Gateway → Node, confirmed uplink)
+# =============================================================================
+
+
+def seqs_to_ranges(seqs) -> list[list[int]]:
+    """Collapse sequence numbers into sorted inclusive [start, end] ranges."""
+    ranges: list[list[int]] = []
+    for q in sorted(set(seqs)):
+        if ranges and q == ranges[-1][1] + 1:
+            ranges[-1][1] = q
+        else:
+            ranges.append([q, q])
+    return ranges
+
+
+def build_sack_packet(node_id: str, ranges: list[list[int]]) -> bytes:
+    """
+    Build a batched sensor ACK confirming received sequence numbers.
+
+    Compact format keys:
+        t = "sack" (message type)
+        n = node_id whose packets are acknowledged
+        r = list of inclusive [start, end] sequence ranges
+        c = CRC
+
+    Args:
+        node_id: Node that sent the sensor packets
+        ranges: Acknowledged ranges (see seqs_to_ranges)
+
+    Returns:
+        UTF-8 encoded JSON packet ready to transmit
+    """
+    message: dict[str, Any] = {"t": "sack", "n": node_id, "r": ranges}
+    message["c"] = calculate_crc32(message)
+    return json.dumps(message, separators=(",", ":")).encode("utf-8")
+
+
+def parse_sack_packet(data: bytes) -> tuple[str, list[tuple[int, int]]] | None:
+    """
+    Parse and verify a batched sensor ACK.
+
+    Returns:
+        (node_id, [(start, end), ...]) if valid, None otherwise
+    """
+    try:
+        message = json.loads(data.decode("utf-8"))
+    except (json.JSONDecodeError, UnicodeDecodeError):
+        return None
+    if not isinstance(message, dict) or message.get("t") != "sack":
+        return None
+    if not verify_crc(message, crc_key="c"):
+        return None
+    try:
+        return message["n"], [(int(a), int(b)) for a, b in message["r"]]
+    except (KeyError, TypeError, ValueError):
+        return None
+
+
+# =============================================================================
+# LoRa Log Transfer (Node → Gateway, bulk sample log retrieval)
+# =============================================================================
+
+# Record in an encoded log blob: sensor class ID, reading index, ms after t0, value
+LOG_RECORD = struct.Struct("<BBIf")
+
+
+@dataclass
+class LogChunk:
+    """One chunk of a sample log transfer."""
+    node_id: str
+    transfer_id: int
+    index: int
+    total: int
+    data: bytes
+
+
+def encode_log_records(
+    names: dict[str, list[list[str]]],
+    records: list[tuple[float, int, int, float]],
+) -> bytes:
+    """
+    Encode sample log records as one compressed blob.
+
+    Layout (before zlib): a JSON header line {"v": 1, "t0": first ts,
+    "s": names} followed by packed LOG_RECORD entries.
+
+    Args:
+        names: Sensor class ID (as str) -> [[reading name, units], ...] by index
+        records: (timestamp, class ID, reading index, value), oldest first
+
+    Returns:
+        zlib-compressed blob
+    """
+    t0 = records[0][0] if records else 0.0
+    header = json.dumps({"v": 1, "t0": t0, "s": names}, separators=(",", ":"))
+    body = b"".join(
+        LOG_RECORD.pack(class_id, index, max(0, round((ts - t0) * 1000)), value)
+        for ts, class_id, index, value in records
+    )
+    return zlib.compress(header.encode("utf-8") + b"\n" + body, 9)
+
+
+def decode_log_records(blob: bytes) -> list[SensorReading]:
+    """
+    Decode a blob from encode_log_records() into readings.
+
+    Raises:
+        ValueError: If the blob is corrupt or has an unknown version
+    """
+    from sensors import get_sensor_class_name
+
+    try:
+        raw = zlib.decompress(blob)
+        head, body = raw.split(b"\n", 1)
+        header = json.loads(head.decode("utf-8"))
+    except (zlib.error, ValueError, UnicodeDecodeError) as e:
+        raise ValueError(f"corrupt log blob: {e}") from e
+    if header.get("v") != 1 or len(body) % LOG_RECORD.size:
+        raise ValueError("unsupported log blob")
+
+    t0 = header["t0"]
+    names = header["s"]
+    readings = []
+    for class_id, index, offset_ms, value in LOG_RECORD.iter_unpack(body):
+        try:
+            name, units = names[str(class_id)][index]
+        except (KeyError, IndexError):
+            name, units = f"reading_{index}", ""
+        sensor_class = get_sensor_class_name(class_id) or f"unknown_{class_id}"
+        readings.append(SensorReading(
+            name=name,
+            units=units,
+            value=value,
+            sensor_class=sensor_class,
+            timestamp=t0 + offset_ms / 1000.0,
+        ))
+    return readings
+
+
+def _log_chunk_message(
+    node_id: str, transfer_id: int, index: int, total: int, data: str
+) -> dict[str, Any]:
+    message: dict[str, Any] = {
+        "t": "log", "n": node_id, "x": transfer_id, "i": index, "m": total, "d": data,
+    }
+    message["c"] = calculate_crc32(message)
+    return message
+
+
+def log_chunk_size(node_id: str) -> int:
+    """Largest chunk (raw bytes) whose log packet fits LORA_MAX_PAYLOAD."""
+    # Worst case framing: widest IDs, 8-char CRC
+    message = _log_chunk_message(node_id, 255, 65535, 65535, "")
+    overhead = len(json.dumps(message, separators=(",", ":")))
+    # base64 turns 3 bytes into 4 characters
+    return (LORA_MAX_PAYLOAD - overhead) // 4 * 3
+
+
+def build_log_chunk_packets(node_id: str, transfer_id: int, blob: bytes) -> list[bytes]:
+    """
+    Split a log blob into LoRa packets.
+
+    Compact format keys:
+        t = "log" (message type)
+        n = node_id
+        x = transfer ID (0-255)
+        i = chunk index
+        m = total chunks
+        d = base64 chunk data
+        c = CRC
+
+    Returns:
+        Packets in chunk order
+    """
+    size = log_chunk_size(node_id)
+    chunks = [blob[i:i + size] for i in range(0, len(blob), size)] or [b""]
+    if len(chunks) > 65535:
+        raise ValueError("log transfer too large")
+    return [
+        json.dumps(
+            _log_chunk_message(
+                node_id, transfer_id, i, len(chunks),
+                base64.b64encode(chunk).decode("ascii"),
+            ),
+            separators=(",", ":"),
+        ).encode("utf-8")
+        for i, chunk in enumerate(chunks)
+    ]
+
+
+def parse_log_chunk_packet(data: bytes) -> LogChunk | None:
+    """
+    Parse and verify a log transfer chunk.
+
+    Returns:
+        LogChunk if valid, None otherwise
+    """
+    try:
+        message = json.loads(data.decode("utf-8"))
+    except (json.JSONDecodeError, UnicodeDecodeError):
+        return None
+    if not isinstance(message, dict) or message.get("t") != "log":
+        return None
+    if not verify_crc(message, crc_key="c"):
+        return None
+    try:
+        chunk = LogChunk(
+            node_id=message["n"],
+            transfer_id=int(message["x"]),
+            index=int(message["i"]),
+            total=int(message["m"]),
+            data=base64.b64decode(message["d"], validate=True),
+        )
+    except (KeyError, TypeError, ValueError):
+        return None
+    if not 0 <= chunk.index < chunk.total:
+        return None
+    return chunk
+
+
+def format_ranges(ranges: list[list[int]]) -> str:
+    """Inclusive ranges as a command argument, e.g. "3-5,9"."""
+    return ",".join(f"{a}-{b}" if a != b else str(a) for a, b in ranges)
+
+
+def parse_ranges(text: str) -> list[tuple[int, int]]:
+    """
+    Parse a format_ranges() argument.
+
+    Raises:
+        ValueError: If malformed
+    """
+    ranges = []
+    for part in text.split(","):
+        start, _, end = part.partition("-")
+        a = int(start)
+        b = int(end) if end else a
+        if b < a:
+            raise ValueError(f"bad range {part!r}")
+        ranges.append((a, b))
+    return ranges